@@ -4,6 +4,9 @@
 #include <memory>
 #include <vector>
 #include <fstream>
+#include <chrono>
+#include <cctype>
+#include <stdexcept>
 
 void usage();
 class IrisDataset;
@@ -185,14 +188,27 @@ class IrisClassifier{
                 return out;
             }
         }
-        void train(EvoAI::DataLoader<IrisDataset>& trainingSet, EvoAI::DataLoader<IrisDataset>& testingSet, std::size_t epoch, std::size_t batchSize) noexcept{
+        void train(EvoAI::DataLoader<IrisDataset>& trainingSet, EvoAI::DataLoader<IrisDataset>& testingSet, std::size_t epoch, std::size_t batchSize,
+                   std::size_t hogwildThreads = 0) noexcept{
             if(m_normalize){
                 trainingSet.getDataset().transform(&normalizeData, m_scalers);
                 testingSet.getDataset().transform(&normalizeData, m_scalers);
             }
-            EvoAI::Optimizer optim(0.1, batchSize, EvoAI::SGD(m_nn->getParameters(), 0.0), EvoAI::Scheduler(EvoAI::MultiStepLR({175}, 0.1)));
-            EvoAI::writeMultiPlot("irisAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
-                m_nn->train(trainingSet, testingSet, optim, epoch, EvoAI::Loss::MultiClassCrossEntropy{}, testDataset));
+            auto start = std::chrono::steady_clock::now();
+            if(hogwildThreads > 0){
+                // Hogwild only does plain SGD with a constant learning rate, the threads apply their
+                // updates from the same weights so it needs a smaller one.
+                m_nn->setThreadPool(std::make_shared<EvoAI::ThreadPool>(hogwildThreads));
+                EvoAI::writeMultiPlot("irisAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
+                    m_nn->trainHogwild(trainingSet, testingSet, 0.02, epoch, EvoAI::Loss::MultiClassCrossEntropy{}, testDataset));
+            }else{
+                EvoAI::Optimizer optim(0.1, batchSize, EvoAI::SGD(m_nn->getParameters(), 0.0), EvoAI::Scheduler(EvoAI::MultiStepLR({175}, 0.1)));
+                EvoAI::writeMultiPlot("irisAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
+                    m_nn->train(trainingSet, testingSet, optim, epoch, EvoAI::Loss::MultiClassCrossEntropy{}, testDataset));
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            auto samples = epoch * trainingSet.size() * batchSize;
+            std::cout << "trained " << samples << " samples in " << elapsed.count() << "s (" << (samples / elapsed.count()) << " samples/s)" << std::endl;
         }
         void test(EvoAI::DataLoader<IrisDataset>& ids) noexcept{
             if(m_normalize){
@@ -245,6 +261,7 @@ struct Options{
     std::string modelFilename{""};
     float lossThreshold = 0.07;
     bool hyperneat = false;
+    std::size_t hogwildThreads = 0;
 };
 
 Options parseArgs(int argc, char** argv) noexcept{
@@ -267,6 +284,16 @@ Options parseArgs(int argc, char** argv) noexcept{
                     options.hyperneat = true;
                 }
             }
+        }else if(opt == "-hw" || opt == "--hogwild"){
+            options.hogwildThreads = 2;
+            // the thread count is optional, the next argument can be another option.
+            if(argv[i+1] != nullptr && std::isdigit(static_cast<unsigned char>(argv[i+1][0]))){
+                try{
+                    options.hogwildThreads = std::max<std::size_t>(1u, std::stoul(std::string(argv[i+1])));
+                }catch(const std::out_of_range&){
+                    std::cerr << "the number of threads is too large, using " << options.hogwildThreads << std::endl;
+                }
+            }
         }else if(opt == "-c" || opt == "--classify"){
             options.classify = true;
         }else if(opt == "-m" || opt == "--model"){
@@ -310,7 +337,7 @@ int main(int argc, char **argv){
         EvoAI::DataLoader<IrisDataset> trainingSet(IrisDataset(options.dataFilename, true, batchSize));
         EvoAI::DataLoader<IrisDataset> testingSet(IrisDataset(options.dataFilename, false, batchSize));
         std::cout << "training for " << epoch << " epochs " << std::endl;
-        irisClass->train(trainingSet, testingSet, epoch, batchSize);
+        irisClass->train(trainingSet, testingSet, epoch, batchSize, options.hogwildThreads);
         std::cout << "writing new model to IrisModel.json" << std::endl;
         irisClass->writeToFile("irisModel.json");
         std::cout << "writing dot file for new model to IrisModel.dot" << std::endl;
@@ -353,6 +380,7 @@ void usage(){
     std::cout << "\t\tfilename should be a json file of an IrisClassifier if empty it will create a random nn and save it as irisModel.json to train or test.\n";
     std::cout << "\t-n, --norm\t\t\t\tWill normalize features of the data\n";
     std::cout << "\t-t, --train\t\t\t\tWill train the network specified.\n";
+    std::cout << "\t-hw, --hogwild <threads>\t\tWill train with lock-free asynchronous SGD on threads.\n";
     std::cout << "\t-c, --classify\t\t\t\tWill test the network with the test data.\n";
     std::cout << "\t-e, --evolve <lossThreshold> [hn]\tWill evolve a population and select the best.\n";
     std::cout << "\t\t\t\t\t\t[hn] will use hyperneat instead of neat\n";
@@ -4,6 +4,9 @@
 #include <utility>
 #include <memory>
 #include <vector>
+#include <chrono>
+#include <cctype>
+#include <stdexcept>
 
 void usage() noexcept;
 /**
@@ -37,10 +40,12 @@ std::pair<double, double> testXORDataset(EvoAI::NeuralNetwork& nn, EvoAI::DataLo
  * @param testDataset EvoAI::DataLoader<EvoAI::Dataset>&
  * @param batchSize batch size
  * @param binaryCross to use BinaryCrossEntropy or MSE Loss
+ * @param hogwildThreads threads to train with EvoAI::NeuralNetwork::trainHogwild, 0 uses EvoAI::NeuralNetwork::train
  */
 void trainXOR(EvoAI::NeuralNetwork& nn, 
     EvoAI::DataLoader<EvoAI::Dataset>& trainDataset, 
-    EvoAI::DataLoader<EvoAI::Dataset>& testDataset, std::size_t epoch, std::size_t batchSize = 4, bool binaryCross = false);
+    EvoAI::DataLoader<EvoAI::Dataset>& testDataset, std::size_t epoch, std::size_t batchSize = 4, bool binaryCross = false,
+    std::size_t hogwildThreads = 0);
 
 int main(int argc, char* argv[]){
     EvoAI::randomGen().setSeed(42);
@@ -56,6 +61,7 @@ int main(int argc, char* argv[]){
     bool saveGen = false;
     bool saveNN = false;
     bool binaryCross = false;
+    std::size_t hogwildThreads = 0;
     std::string loadingFile = "file.json";
     std::string savingFileGenome = "genomeXOR.json";
     std::string savingFileNN = "nnXOR.json";
@@ -74,6 +80,16 @@ int main(int argc, char* argv[]){
             trainingMode = true;
         }else if(val == "-bc" || val =="--binaryCross"){
             binaryCross = true;
+        }else if(val == "-hw" || val == "--hogwild"){
+            hogwildThreads = 2;
+            // the thread count is optional, the next argument can be another option.
+            if(argv[i+1] != nullptr && std::isdigit(static_cast<unsigned char>(argv[i+1][0]))){
+                try{
+                    hogwildThreads = std::max<std::size_t>(1u, std::stoul(std::string(argv[i+1])));
+                }catch(const std::out_of_range&){
+                    std::cerr << "the number of threads is too large, using " << hogwildThreads << std::endl;
+                }
+            }
         }else if(val == "-c" || val == "--check"){
             if(std::string(argv[i+1]) == "g"){
                 checkGenome = true;
@@ -118,6 +134,9 @@ int main(int argc, char* argv[]){
     if(binaryCross){
         batchSize = 3;
         epoch = 5000;
+    }else if(hogwildThreads > 0){
+        // without momentum it needs more epochs to leave the plateau at 0.5
+        epoch = 10000;
     }
     EvoAI::DataLoader trainDataset(EvoAI::Dataset(std::move(inputs), std::move(outputs), batchSize));
     EvoAI::DataLoader testDataset(EvoAI::Dataset(std::move(tInputs), std::move(tOutputs), batchSize));
@@ -133,7 +152,7 @@ int main(int argc, char* argv[]){
         std::cout << "Pre-Training" << std::endl;
         testXOR(*nn);
         std::cout << "training..." << std::endl;
-        trainXOR(*nn, trainDataset, testDataset, epoch, batchSize, binaryCross);
+        trainXOR(*nn, trainDataset, testDataset, epoch, batchSize, binaryCross, hogwildThreads);
         std::cout << "Post-Training" << std::endl;
         testXOR(*nn);
     }else if(checkGenome){
@@ -156,8 +175,20 @@ int main(int argc, char* argv[]){
 }
 void trainXOR(EvoAI::NeuralNetwork& nn, 
     EvoAI::DataLoader<EvoAI::Dataset>& trainDataset, 
-    EvoAI::DataLoader<EvoAI::Dataset>& testDataset, std::size_t epoch, std::size_t batchSize, bool binaryCross){
-    if(binaryCross){
+    EvoAI::DataLoader<EvoAI::Dataset>& testDataset, std::size_t epoch, std::size_t batchSize, bool binaryCross,
+    std::size_t hogwildThreads){
+    auto start = std::chrono::steady_clock::now();
+    if(hogwildThreads > 0){
+        // Hogwild only does plain SGD, without momentum.
+        nn.setThreadPool(std::make_shared<EvoAI::ThreadPool>(hogwildThreads));
+        if(binaryCross){
+            EvoAI::writeMultiPlot("xorAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
+                nn.trainHogwild(trainDataset, testDataset, 0.9, epoch, EvoAI::Loss::BinaryCrossEntropy{}, &testXORDataset));
+        }else{
+            EvoAI::writeMultiPlot("xorAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
+                nn.trainHogwild(trainDataset, testDataset, 2.0, epoch, EvoAI::Loss::MeanSquaredError{}, &testXORDataset));
+        }
+    }else if(binaryCross){
         // Binary Cross Entropy
         EvoAI::Optimizer optim(0.9, batchSize, EvoAI::SGD(nn.getParameters(), 0.0), EvoAI::Scheduler(EvoAI::ConstantLR()));
         EvoAI::writeMultiPlot("xorAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
@@ -168,6 +199,9 @@ void trainXOR(EvoAI::NeuralNetwork& nn,
         EvoAI::writeMultiPlot("xorAvgLoss.txt", {"epochAvgLoss", "testAvgLoss", "accuracy"},
             nn.train(trainDataset, testDataset, optim, epoch, EvoAI::Loss::MeanSquaredError{}, &testXORDataset));
     }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    auto samples = epoch * trainDataset.size() * batchSize;
+    std::cout << "trained " << samples << " samples in " << elapsed.count() << "s (" << (samples / elapsed.count()) << " samples/s)" << std::endl;
     nn.writeDotFile("xor.dot");
 }
 std::pair<double, double> testXORDataset(EvoAI::NeuralNetwork& nn, EvoAI::DataLoader<EvoAI::Dataset>& ds) noexcept{
@@ -315,6 +349,7 @@ void usage() noexcept{
     std::cout << "\t\t-e, --evolve <hn>\t\t\tTries to solve XOR evolving a population to solve the XOR.(hn use HyperNeat instead of NEAT).\n";
     std::cout << "\t\t-t, --train\t\t\t\tTrains a neural network to solve the XOR.\n";
     std::cout << "\t\t-bc, --binaryCross\t\t\t\tUses BinaryCrossEntropy loss instead of Mean Squared Error.\n";
+    std::cout << "\t\t-hw, --hogwild <threads>\t\tTrains with lock-free asynchronous SGD on threads.\n";
     std::cout << "\t\t-c, --check <g|n> <filename> \t\tcheck a genome or a neural network.\n";
     std::cout << "\t\t-s, --save-nn <filename>\t\tSaves the neural network.\n";
     std::cout << "\t\t-sg, --save-g <filename>\t\tSaves the genome.\n";
@@ -12,6 +12,14 @@
 #include "EvoAI/Schedulers.hpp"
 #include "EvoAI/Optimizers.hpp"
 #include "EvoAI/NeuralNetwork.hpp"
+#include "EvoAI/ExecutionPlan.hpp"
+#include "EvoAI/ModelFile.hpp"
+#include "EvoAI/ThreadPool.hpp"
+#include "EvoAI/TrainingProfiler.hpp"
+#include "EvoAI/RecurrentSession.hpp"
+#include "EvoAI/QuantizedNetwork.hpp"
+#include "EvoAI/CodeGeneration.hpp"
+#include "EvoAI/StaticNetwork.hpp"
 #include "EvoAI/NodeGene.hpp"
 #include "EvoAI/ConnectionGene.hpp"
 #include "EvoAI/Genome.hpp"
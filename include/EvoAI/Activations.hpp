@@ -4,8 +4,10 @@
 #include <cmath>
 #include <numeric>
 #include <random>
+#include <vector>
 
 #include <EvoAI/Export.hpp>
+#include <EvoAI/Neuron.hpp>
 #include <EvoAI/Utils/MathUtils.hpp>
 
 namespace EvoAI{
@@ -89,6 +91,12 @@ namespace EvoAI{
          * @param outputs NeuronLayer&
          */
         EvoAI_API void softmax(NeuronLayer& outputs) noexcept;
+        /**
+         * @brief softmax activation in place over a contiguous range.
+         * @param values double* outputs to normalize
+         * @param size std::size_t number of values
+         */
+        EvoAI_API void softmax(double* values, std::size_t size) noexcept;
         /**
          * @brief gaussian activation
          * @param v double
@@ -150,6 +158,327 @@ namespace EvoAI{
          * @return double
          */
         EvoAI_API double hat(double v) noexcept;
+        /**
+         * @brief applies the activation function selected by at.
+         * @param at Neuron::ActivationType
+         * @param v double sum of the neuron
+         * @param b double bias weight of the neuron (used by swish)
+         * @return double
+         */
+        EvoAI_API double activate(Neuron::ActivationType at, double v, double b) noexcept;
+        /**
+         * @brief Activations over arrays.
+         * @details
+         *  They use SSE2 or AVX2 when the cpu supports it (see getSimdLevel), the transcendental functions
+         *  are polynomial approximations with an error of a few ulps compared to the scalar versions.
+         *  Functions without a vectorized version (tan, modulus, noisyRelu) run the scalar version.
+         */
+        namespace Array{
+            /**
+             * @brief instruction set used by the functions in Activations::Array and Derivatives::Array
+             */
+            enum class SimdLevel{
+                SCALAR,
+                SSE2,
+                AVX2
+            };
+            /**
+             * @brief best SimdLevel supported by the cpu.
+             * @return SimdLevel
+             */
+            EvoAI_API SimdLevel getSupportedSimdLevel() noexcept;
+            /**
+             * @brief SimdLevel in use, by default the best one supported.
+             * @return SimdLevel
+             */
+            EvoAI_API SimdLevel getSimdLevel() noexcept;
+            /**
+             * @brief selects the SimdLevel to use, it will be capped at getSupportedSimdLevel()
+             * @param level SimdLevel
+             */
+            EvoAI_API void setSimdLevel(SimdLevel level) noexcept;
+            /**
+             * @brief identity activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void identity(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief sigmoid activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void sigmoid(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief steepenedSigmoid activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void steepenedSigmoid(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief swish activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             * @param b double
+             */
+            EvoAI_API void swish(const double* values, double* outputs, std::size_t size, double b = 1.0) noexcept;
+            /**
+             * @brief tanh activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void tanh(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief sinusoid activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void sinusoid(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief cosine activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void cosine(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief tan activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void tan(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief relu activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void relu(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief noisyRelu activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void noisyRelu(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief leakyRelu activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void leakyRelu(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief exponential activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void exponential(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief gaussian activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void gaussian(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief modulus activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             * @param div double
+             */
+            EvoAI_API void modulus(const double* values, double* outputs, std::size_t size, double div) noexcept;
+            /**
+             * @brief square activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void square(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief cube activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void cube(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief softplus activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void softplus(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief clamp activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void clamp(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief inv activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void inv(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief log activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void log(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief abs activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void abs(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief hat activation of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void hat(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief applies the activation function selected by at to each value.
+             * @param at Neuron::ActivationType
+             * @param values const double* sums
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             * @param b double bias weight (used by swish)
+             */
+            EvoAI_API void activate(Neuron::ActivationType at, const double* values, double* outputs, std::size_t size, double b) noexcept;
+            /**
+             * @brief single precision version of activate, with SSE2 and AVX2 the values are evaluated in single precision
+             * (4 and 8 lanes) and with SimdLevel::SCALAR in double precision.
+             * @param at Neuron::ActivationType
+             * @param values const float* sums
+             * @param outputs float* can be the same as values
+             * @param size std::size_t
+             * @param b double bias weight (used by swish)
+             */
+            EvoAI_API void activate(Neuron::ActivationType at, const float* values, float* outputs, std::size_t size, double b) noexcept;
+        }
+        /**
+         * @class LookupTable
+         * @author Cristian Glez <cristian.glez.m@gmail.com>
+         * @file Activations.hpp
+         * @brief Approximates sigmoid, tanh, gaussian, sinusoid and cosine with linearly interpolated tables.
+         * @details
+         *  The step and range of each table are chosen from the maximum absolute error allowed, outside of the range
+         *  the function is replaced by its asymptote (0, 1, -1 or v) and sinusoid and cosine use the period.
+         *  The rest of the activations are not approximated and are forwarded to Activations::activate
+         *  and Activations::Array::activate.
+         *  It is used by a NeuralNetwork and its ExecutionPlan with NeuralNetwork::setActivationTable,
+         *  one table can be shared between many networks and threads.
+         * @code
+         *      auto table = std::make_shared<EvoAI::Activations::LookupTable>(1e-4);
+         *      cppn.setActivationTable(table);
+         * @endcode
+         */
+        class EvoAI_API LookupTable final{
+            public:
+                /**
+                 * @brief builds the tables.
+                 * @param maxError double maximum absolute error, clamped to [1e-9, 0.1]
+                 */
+                explicit LookupTable(double maxError = 1e-4);
+                /**
+                 * @brief checks if the activation is approximated.
+                 * @param at Neuron::ActivationType
+                 * @return bool
+                 */
+                static bool isApproximated(Neuron::ActivationType at) noexcept;
+                /**
+                 * @brief same as Activations::activate with the approximated activations.
+                 * @param at Neuron::ActivationType
+                 * @param v double
+                 * @param b double
+                 * @return double
+                 */
+                double activate(Neuron::ActivationType at, double v, double b) const noexcept;
+                /**
+                 * @brief same as Activations::Array::activate with the approximated activations.
+                 * @param at Neuron::ActivationType
+                 * @param values const double*
+                 * @param outputs double* can be the same as values
+                 * @param size std::size_t
+                 * @param b double
+                 */
+                void activate(Neuron::ActivationType at, const double* values, double* outputs, std::size_t size, double b) const noexcept;
+                /**
+                 * @brief single precision version of activate.
+                 * @param at Neuron::ActivationType
+                 * @param values const float*
+                 * @param outputs float* can be the same as values
+                 * @param size std::size_t
+                 * @param b double
+                 */
+                void activate(Neuron::ActivationType at, const float* values, float* outputs, std::size_t size, double b) const noexcept;
+                /**
+                 * @brief maximum absolute error of the approximated activations.
+                 * @return double
+                 */
+                inline double getMaxError() const noexcept{ return m_maxError; }
+                /**
+                 * @brief bytes used by the tables.
+                 * @return std::size_t
+                 */
+                std::size_t memoryUsage() const noexcept;
+            private:
+                /**
+                 * @brief table of f over [begin, end], below begin it is low and above end high + highSlope * v,
+                 * if periodic v is wrapped into [begin, end).
+                 */
+                struct Table{
+                    double begin;
+                    double end;
+                    double invStep;
+                    double low;
+                    double high;
+                    double highSlope;
+                    bool periodic;
+                    std::vector<double> values;
+                    double evaluate(double v) const noexcept;
+                };
+                /**
+                 * @brief makes a Table of f with an interpolation error below maxError.
+                 * @param f double(*)(double)
+                 * @param begin double
+                 * @param end double
+                 * @param maxSecondDerivative double maximum of |f''| used to choose the step.
+                 * @param maxError double
+                 * @return Table
+                 */
+                static Table makeTable(double(*f)(double), double begin, double end, double maxSecondDerivative, double maxError);
+                /**
+                 * @brief table for the activation or nullptr.
+                 * @param at Neuron::ActivationType
+                 * @return const Table*
+                 */
+                const Table* tableFor(Neuron::ActivationType at) const noexcept;
+            private:
+                double m_maxError;
+                Table m_sigmoid;
+                Table m_tanh;
+                Table m_gaussian;
+                Table m_sinusoid;
+                Table m_cosine;
+        };
     }
     namespace Derivatives{
         /**
@@ -291,6 +620,202 @@ namespace EvoAI{
          * @return double
          */
         EvoAI_API double hat(double v) noexcept;
+        /**
+         * @brief applies the derivative selected by at.
+         * @param at Neuron::ActivationType
+         * @param sum double sum of the neuron
+         * @param output double output of the neuron
+         * @param b double bias weight of the neuron (used by swish)
+         * @param gradient double gradient of the neuron (returned for softmax)
+         * @return double
+         */
+        EvoAI_API double derivate(Neuron::ActivationType at, double sum, double output, double b, double gradient) noexcept;
+        /**
+         * @brief Derivatives over arrays, see Activations::Array.
+         */
+        namespace Array{
+            /**
+             * @brief identity derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void identity(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief sigmoid derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void sigmoid(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief steepenedSigmoid derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void steepenedSigmoid(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief swish derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             * @param b double
+             */
+            EvoAI_API void swish(const double* values, double* outputs, std::size_t size, double b = 1.0) noexcept;
+            /**
+             * @brief tanh derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void tanh(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief sinusoid derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void sinusoid(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief cosine derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void cosine(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief tan derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void tan(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief relu derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void relu(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief noisyRelu derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void noisyRelu(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief leakyRelu derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void leakyRelu(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief exponential derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void exponential(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief gaussian derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void gaussian(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief modulus derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             * @param div double
+             */
+            EvoAI_API void modulus(const double* values, double* outputs, std::size_t size, double div) noexcept;
+            /**
+             * @brief square derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void square(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief cube derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void cube(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief softplus derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void softplus(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief clamp derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void clamp(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief inv derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void inv(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief log derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void log(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief abs derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void abs(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief hat derivative of each value.
+             * @param values const double*
+             * @param outputs double* can be the same as values
+             * @param size std::size_t
+             */
+            EvoAI_API void hat(const double* values, double* outputs, std::size_t size) noexcept;
+            /**
+             * @brief applies the derivative selected by at to each neuron.
+             * @param at Neuron::ActivationType
+             * @param sums const double*
+             * @param outputs const double*
+             * @param gradients const double* (returned for softmax)
+             * @param results double*
+             * @param size std::size_t
+             * @param b double bias weight (used by swish)
+             */
+            EvoAI_API void derivate(Neuron::ActivationType at, const double* sums, const double* outputs, const double* gradients,
+                                        double* results, std::size_t size, double b) noexcept;
+            /**
+             * @brief single precision version of derivate, with SSE2 and AVX2 the values are evaluated in single precision
+             * (4 and 8 lanes) and with SimdLevel::SCALAR in double precision.
+             * @param at Neuron::ActivationType
+             * @param sums const float*
+             * @param outputs const float*
+             * @param gradients const float* (returned for softmax)
+             * @param results float*
+             * @param size std::size_t
+             * @param b double bias weight (used by swish)
+             */
+            EvoAI_API void derivate(Neuron::ActivationType at, const float* sums, const float* outputs, const float* gradients,
+                                        float* results, std::size_t size, double b) noexcept;
+        }
     }
 }
 
@@ -0,0 +1,36 @@
+#ifndef EVOAI_CODE_GENERATION_HPP
+#define EVOAI_CODE_GENERATION_HPP
+
+#include <string>
+
+#include <EvoAI/ExecutionPlan.hpp>
+#include <EvoAI/Export.hpp>
+
+namespace EvoAI{
+    /**
+     * @brief generates a standalone C++17 header that runs the network of the ExecutionPlan.
+     * @details
+     *  The header only depends on the standard library, it has the topology unrolled with one local variable
+     *  per neuron, the weights and biases as constexpr arrays and each activation called directly.
+     *  Everything is inside namespace name:
+     *  @code
+     *      namespace name{
+     *          constexpr std::size_t numInputs;
+     *          constexpr std::size_t numOutputs;
+     *          constexpr std::size_t contextSize;
+     *          inline void forward(const double* inputs, double* outputs, double* context) noexcept;
+     *      }
+     *  @endcode
+     *  forward gives the same outputs as NeuralNetwork::forward followed by NeuralNetwork::reset,
+     *  context keeps the sums of the Neuron::Type::CONTEXT neurons and the cycles of their self connections
+     *  between calls, it has to be zeroed before the first call (like a new network) and can be nullptr when contextSize is 0.
+     *  The plan is run as ExecutionPlan::EvaluationMode::EDGE_MAJOR whatever its mode and Activations::LookupTable
+     *  is not used, the activations are always exact.
+     * @param plan const ExecutionPlan&
+     * @param name const std::string& namespace of the generated code, it must be a valid C++ identifier.
+     * @return std::string the source code, empty if name is not a valid identifier.
+     */
+    EvoAI_API std::string generateCpp(const ExecutionPlan& plan, const std::string& name);
+}
+
+#endif // EVOAI_CODE_GENERATION_HPP
@@ -0,0 +1,784 @@
+#ifndef EVOAI_EXECUTION_PLAN_HPP
+#define EVOAI_EXECUTION_PLAN_HPP
+
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include <memory>
+#include <atomic>
+
+#include <EvoAI/Neuron.hpp>
+#include <EvoAI/Export.hpp>
+
+namespace EvoAI{
+    class NeuralNetwork;
+    class ModelFile;
+    class ThreadPool;
+    class ParameterBuffer;
+    namespace Activations{
+        class LookupTable;
+    }
+    /**
+     * @brief How the neurons of an ExecutionPlan are evaluated.
+     *  - EDGE_MAJOR: same as NeuralNetwork::run, a hidden neuron adds its bias and is activated
+     *    once per outgoing connection.
+     *  - NEURON_MAJOR: each neuron adds its bias and is activated once before propagating its output
+     *    to all its connections. It gives the same outputs as EDGE_MAJOR when every hidden neuron
+     *    has one connection or its bias is 0.0.
+     */
+    enum class PlanEvaluationMode{
+        EDGE_MAJOR,
+        NEURON_MAJOR
+    };
+    /**
+     * @brief Neuron state of a BasicExecutionPlan (sums, outputs and connection cycles) kept outside of it.
+     * @details The plan only reads its weights and topology when it runs with an InferenceState,
+     *  so many threads can share one plan (or one compiled NeuralNetwork), each one with its own state.
+     *  The Neuron::Type::CONTEXT neurons keep their memory in the state between calls to forward.
+     * @code
+     *      nn.compile();
+     *      auto state = nn.makeInferenceState(); // one per thread
+     *      auto out = nn.forward({0.5, 1.0}, state);
+     *      nn.reset(state);
+     * @endcode
+     * @tparam T double or float
+     */
+    template<typename T>
+    struct BasicInferenceState final{
+        std::vector<T> sums;
+        std::vector<T> outputs;
+        std::vector<int> cycles;
+    };
+    /**
+     * @brief InferenceState for ExecutionPlan.
+     */
+    using InferenceState = BasicInferenceState<double>;
+    /**
+     * @brief InferenceState for ExecutionPlanF.
+     */
+    using InferenceStateF = BasicInferenceState<float>;
+    /**
+     * @brief Neuron state of many independent sequences run together by a BasicExecutionPlan.
+     * @details Like BasicInferenceState but with batchSize lanes, the lanes of a neuron (or connection for cycles)
+     *  are contiguous so each step updates all the sequences in the same inner loop. See RecurrentSession.
+     * @tparam T double or float
+     */
+    template<typename T>
+    struct BasicBatchState final{
+        std::vector<T> sums;
+        std::vector<T> outputs;
+        std::vector<int> cycles;
+        std::size_t batchSize = 0u;
+    };
+    /**
+     * @brief BatchState for ExecutionPlan.
+     */
+    using BatchState = BasicBatchState<double>;
+    /**
+     * @brief BatchState for ExecutionPlanF.
+     */
+    using BatchStateF = BasicBatchState<float>;
+    /**
+     * @class BasicExecutionPlan
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file ExecutionPlan.hpp
+     * @brief A flat, compiled version of a NeuralNetwork used to run it.
+     * @details
+     *  The neurons are numbered layer by layer and stored in contiguous arrays (type, activation, bias, sum, output),
+     *  the connections are stored as CSR arrays grouped by source neuron in the same order as
+     *  NeuralNetwork::getConnections, so running the plan gives the same results as NeuralNetwork::run.
+     *  The plan is a snapshot of the NeuralNetwork, it won't see later changes to its topology,
+     *  call NeuralNetwork::compile() again or ExecutionPlan::updateWeights if only the weights changed.
+     *  ExecutionPlan::EvaluationMode selects how the hidden neurons are finalized, see ExecutionPlan::EvaluationMode.
+     *  forwardBatch and backwardBatch run many samples at once, the neuron state has one lane per sample
+     *  stored next to each other ([neuron x batch]) so each weight is loaded once for the whole batch
+     *  and the activations run through Activations::Array.
+     *  Layers fully connected to another layer (createFeedForwardNN, createElmanNeuralNetwork) are run as a
+     *  matrix over the CSR rows instead of connection by connection, see getDenseBlocks, the sparse path is
+     *  still used for the rest of the neurons so NEAT phenotypes run as before.
+     *  T is the type used to store the weights and the neuron state, ExecutionPlan uses double and
+     *  ExecutionPlanF uses float, which halves the memory traffic of the plan and doubles the lanes of each SIMD register.
+     *  The weight and bias gradients are always accumulated in double, so a float plan can train the double
+     *  network it was built from: forwardBatch, backwardBatch, writeGradients, Optimizer::step and updateWeights.
+     *  A double plan can also give an optimizer its weights and gradients in place with bindParameters,
+     *  then writeGradients and updateWeights are not needed and writeWeights copies the weights back to the network.
+     *  Use compareOutputs (NNUtils.hpp) to measure how far a float plan is from the double one.
+     *  With a ThreadPool (setThreadPool) a EvaluationMode::NEURON_MAJOR plan is run level by level, the level of a neuron
+     *  is one more than the level of its deepest source, and the neurons of a level are split between the threads.
+     *  Each neuron pulls the outputs of its sources in the same order they would be pushed, so there are no atomics and the
+     *  outputs are the same as without the pool. It needs every connection to go to a later neuron that is not
+     *  Neuron::Type::CONTEXT and no connections from the outputs (Genome::makeLayeredPhenotype, createFeedForwardNN),
+     *  the other plans, the EvaluationMode::EDGE_MAJOR ones and the ones without levels that have enough connections
+     *  to split them run as before.
+     * @tparam T double or float
+     * @code
+     *      auto nn = EvoAI::createFeedForwardNN(2, 1, {5}, 1, 1.0);
+     *      nn->compile();
+     *      auto out = nn->forward({0.5, 1.0}); // runs from the plan
+     *      nn->reset();
+     * @endcode
+     */
+    template<typename T>
+    class BasicExecutionPlan final{
+        public:
+            static_assert(std::is_floating_point_v<T>, "T needs to be float or double");
+            using ValueType = T;
+            using EvaluationMode = PlanEvaluationMode;
+            using State = BasicInferenceState<T>;
+            using BatchState = BasicBatchState<T>;
+            /**
+             * @brief default minimum of connections of each task when the plan runs with a ThreadPool.
+             */
+            static constexpr std::size_t DefaultMinConnections = 4096u;
+            /**
+             * @brief every neuron in [srcBegin, srcEnd) is connected to every neuron in [destBegin, destEnd) in order,
+             * the connections of source n are [rowPtr[n] + offset, rowPtr[n] + offset + destEnd - destBegin).
+             */
+            struct DenseBlock{
+                std::uint32_t srcBegin;
+                std::uint32_t srcEnd;
+                std::uint32_t destBegin;
+                std::uint32_t destEnd;
+                std::uint32_t offset;
+                bool inputsOnly;
+            };
+            /**
+             * @brief samples [begin, begin + state.batchSize) of a batch run by one task of the ThreadPool,
+             * parameterGradients is [numConnections() weights | numNeurons() biases].
+             */
+            struct Shard{
+                BasicBatchState<T> state;
+                std::vector<T> gradients;
+                std::vector<T> derivatives;
+                std::vector<double> parameterGradients;
+                std::size_t begin;
+                std::size_t activationCount;
+            };
+        public:
+            /**
+             * @brief default constructor, empty plan.
+             */
+            BasicExecutionPlan();
+            /**
+             * @brief builds the plan from the NeuralNetwork, copies the current neuron state.
+             * @param nn NeuralNetwork&
+             * @param mode EvaluationMode
+             */
+            explicit BasicExecutionPlan(NeuralNetwork& nn, EvaluationMode mode = EvaluationMode::EDGE_MAJOR);
+            /**
+             * @brief builds the plan from the tables of a binary file without a NeuralNetwork, the neuron state starts at 0.0.
+             * @param model const ModelFile& the plan is empty if the model is not valid.
+             * @param mode EvaluationMode
+             */
+            explicit BasicExecutionPlan(const ModelFile& model, EvaluationMode mode = EvaluationMode::EDGE_MAJOR);
+            /**
+             * @brief sets the inputs returns true if succeeded, false if it failed.
+             * @param inputs const std::vector<T>&
+             * @return bool
+             */
+            bool setInputs(const std::vector<T>& inputs) noexcept;
+            /**
+             * @brief Process the plan
+             * @return std::vector<T> outputs
+             */
+            std::vector<T> run() noexcept;
+            /**
+             * @brief calls setInputs and calls run
+             * @param inputs const std::vector<T>&
+             * @return std::vector<T> outputs
+             */
+            std::vector<T> forward(const std::vector<T>& inputs) noexcept;
+            /**
+             * @brief like forward but reads the inputs from and writes the outputs to buffers of the caller,
+             * it doesn't allocate so it can be used where the heap can't be touched (except ExecutionPlanF with
+             * a Neuron::ActivationType::SOFTMAX output layer, Activations::softmax needs a copy in doubles).
+             * @param inputs const T* numInputs values
+             * @param inputSize std::size_t
+             * @param outputs T* room for numOutputs values
+             * @param outputSize std::size_t
+             * @return bool false if inputSize or outputSize are wrong, nothing is run then.
+             */
+            bool forward(const T* inputs, std::size_t inputSize, T* outputs, std::size_t outputSize) noexcept;
+            /**
+             * @brief runs the plan with an external state, the plan is not modified so it can be called
+             * from many threads at the same time as long as each one uses its own State.
+             * @param inputs const std::vector<T>&
+             * @param state State& made with makeState
+             * @return std::vector<T> outputs, empty if inputs or state have the wrong size.
+             */
+            std::vector<T> forward(const std::vector<T>& inputs, State& state) const noexcept;
+            /**
+             * @brief makes a State with a copy of the current neuron state of the plan.
+             * @return State
+             */
+            State makeState() const;
+            /**
+             * @brief resets the neurons of the state that are not Neuron::Type::CONTEXT
+             * @param state State&
+             */
+            void reset(State& state) const noexcept;
+            /**
+             * @brief resets all the neurons of the state, including Neuron::Type::CONTEXT
+             * @param state State&
+             */
+            void resetContext(State& state) const noexcept;
+            /**
+             * @brief makes a BatchState with batchSize copies of the current neuron state of the plan.
+             * @param batchSize std::size_t
+             * @return BatchState
+             */
+            BatchState makeBatchState(std::size_t batchSize) const;
+            /**
+             * @brief runs one step of each sequence of the state, the plan is not modified.
+             * @param inputs const T* row-major [batchSize x numInputs()]
+             * @param inputSize std::size_t
+             * @param outputs T* row-major [batchSize x numOutputs()]
+             * @param outputSize std::size_t
+             * @param state BatchState& made with makeBatchState
+             * @return bool false if the sizes don't match the plan or the state.
+             */
+            bool forwardBatch(const T* inputs, std::size_t inputSize, T* outputs, std::size_t outputSize, BatchState& state) const noexcept;
+            /**
+             * @brief resets the neurons of all the sequences that are not Neuron::Type::CONTEXT
+             * @param state BatchState&
+             */
+            void reset(BatchState& state) const noexcept;
+            /**
+             * @brief resets all the neurons and connection cycles of one sequence, including Neuron::Type::CONTEXT
+             * @param state BatchState&
+             * @param lane std::size_t sequence to reset
+             */
+            void resetContext(BatchState& state, std::size_t lane) const noexcept;
+            /**
+             * @brief runs batchSize samples, each one starts from the current state of the plan.
+             * @details The plan state is not modified, the batch state is kept for backwardBatch.
+             * @param inputs const std::vector<T>& row-major [batchSize x numInputs()]
+             * @param batchSize std::size_t
+             * @return std::vector<T> row-major [batchSize x numOutputs()], empty if inputs has the wrong size.
+             */
+            std::vector<T> forwardBatch(const std::vector<T>& inputs, std::size_t batchSize) noexcept;
+            /**
+             * @brief same as forwardBatch but writes into outputs, it doesn't allocate once outputs and the plan have grown to the batch.
+             * @param inputs const std::vector<T>& row-major [batchSize x numInputs()]
+             * @param batchSize std::size_t
+             * @param outputs std::vector<T>& row-major [batchSize x numOutputs()], cleared if inputs has the wrong size.
+             * @return bool false if inputs has the wrong size.
+             */
+            bool forwardBatch(const std::vector<T>& inputs, std::size_t batchSize, std::vector<T>& outputs) noexcept;
+            /**
+             * @brief calculates the gradients of the last forwardBatch like NeuralNetwork::backward would for each sample,
+             * the gradients are kept in the plan until writeGradients is called.
+             * @param gradientLoss const std::vector<T>& row-major [batchSize x numOutputs()]
+             * @param gradientOfSums bool true if gradientLoss is already the gradient of the sums of the output neurons
+             * (like Loss::MultiClassCrossEntropy::softmaxLossAndGrad gives), the derivative of their activation is skipped.
+             * @return std::vector<T> row-major [batchSize x numInputs()] gradients of the inputs,
+             * empty if gradientLoss has the wrong size.
+             */
+            std::vector<T> backwardBatch(const std::vector<T>& gradientLoss, bool gradientOfSums = false) noexcept;
+            /**
+             * @brief same as backwardBatch but writes the gradients of the inputs into inputGradients.
+             * @param gradientLoss const std::vector<T>& row-major [batchSize x numOutputs()]
+             * @param inputGradients std::vector<T>& row-major [batchSize x numInputs()], cleared if gradientLoss has the wrong size.
+             * @param gradientOfSums bool same as backwardBatch.
+             * @return bool false if gradientLoss has the wrong size.
+             */
+            bool backwardBatch(const std::vector<T>& gradientLoss, std::vector<T>& inputGradients, bool gradientOfSums = false) noexcept;
+            /**
+             * @brief adds the gradients calculated by backwardBatch to the connections of the NeuralNetwork it was built from
+             * and sets the bias gradients like calling NeuralNetwork::backward for each sample would.
+             * @warning the topology of nn must not have changed since the plan was built.
+             * @param nn NeuralNetwork&
+             */
+            void writeGradients(NeuralNetwork& nn) const noexcept;
+            /**
+             * @brief copies shared parameters into the weights and biases of the plan with relaxed loads,
+             * see NeuralNetwork::trainHogwild.
+             * @param parameters const std::atomic<T>* numConnections() weights followed by numNeurons() biases.
+             */
+            void loadParameters(const std::atomic<T>* parameters) noexcept;
+            /**
+             * @brief subtracts the gradients of the last backwardBatch times rate from shared parameters.
+             * @details Each parameter is updated by a relaxed compare and exchange loop, there are no locks or barriers
+             *  so other threads can read a mix of old and new parameters while it runs (Hogwild!).
+             * @param parameters std::atomic<T>* same layout as loadParameters.
+             * @param trainable const std::vector<std::uint32_t>& indices of the parameters that are updated.
+             * @param rate T learning rate divided by the batch size.
+             */
+            void applyGradients(std::atomic<T>* parameters, const std::vector<std::uint32_t>& trainable, T rate) const noexcept;
+            /**
+             * @brief enables truncated backpropagation through time, run and forward record each step in a ring buffer
+             * of the last window steps (sums, outputs and loss gradients in one contiguous arena).
+             * @details Only EvaluationMode::NEURON_MAJOR plans where each Neuron::Type::CONTEXT neuron is only fed
+             *  by neurons after it (like createElmanNeuralNetwork) can be run through time, a context neuron then
+             *  holds the sum of its source in the previous step. 0 disables it.
+             * @param window std::size_t number of steps the gradients go back.
+             * @return bool false if the plan can't be run through time, the window is 0 then.
+             */
+            bool setTruncationWindow(std::size_t window);
+            /**
+             * @brief getter for the truncation window, 0 if backpropagation through time is disabled.
+             * @return std::size_t
+             */
+            inline std::size_t getTruncationWindow() const noexcept{ return m_window; }
+            /**
+             * @brief number of steps in the ring buffer.
+             * @return std::size_t
+             */
+            inline std::size_t numRecordedSteps() const noexcept{ return m_timeSteps; }
+            /**
+             * @brief adds the loss gradients of the last recorded step, they are propagated by propagateThroughTime
+             * or before their step leaves the ring buffer.
+             * @param gradientLoss const std::vector<T>& numOutputs() values
+             * @return bool false if nothing was recorded or gradientLoss has the wrong size.
+             */
+            bool backwardThroughTime(const std::vector<T>& gradientLoss) noexcept;
+            /**
+             * @brief propagates the pending loss gradients back through the recorded steps,
+             * the gradients are kept in the plan until writeTimeGradients is called.
+             */
+            void propagateThroughTime() noexcept;
+            /**
+             * @brief adds the gradients of propagateThroughTime to the connections and biases of the NeuralNetwork
+             * it was built from and clears them.
+             * @warning the topology of nn must not have changed since the plan was built.
+             * @param nn NeuralNetwork&
+             */
+            void writeTimeGradients(NeuralNetwork& nn) noexcept;
+            /**
+             * @brief copies the weights and biases from the NeuralNetwork it was built from.
+             * @warning the topology of nn must not have changed since the plan was built.
+             * @param nn NeuralNetwork&
+             */
+            void updateWeights(NeuralNetwork& nn) noexcept;
+            /**
+             * @brief copies the weights and biases back to the NeuralNetwork it was built from, the reverse of updateWeights.
+             * @warning the topology of nn must not have changed since the plan was built.
+             * @param nn NeuralNetwork&
+             */
+            void writeWeights(NeuralNetwork& nn) const noexcept;
+            /**
+             * @brief binds params to the weights, biases and gradients of the plan (see ParameterBuffer::bind),
+             * so the optimizer updates the plan in place after each backwardBatch.
+             * @details The parameters of params have to be in the order of NeuralNetwork::getParameters, connections
+             *  in the order of NeuralNetwork::getConnections followed by biases in the order of NeuralNetwork::getNeurons,
+             *  any of them can be left out. Runs of consecutive parameters become one ParameterBuffer::Segment.
+             *  The views stay valid until the plan is rebuilt, call writeWeights and ParameterBuffer::unbind before.
+             * @warning the topology of nn must not have changed since the plan was built.
+             * @param nn NeuralNetwork&
+             * @param params ParameterBuffer&
+             * @return bool false if T is not double or the parameters are not in that order, params stays unbound then.
+             */
+            bool bindParameters(NeuralNetwork& nn, ParameterBuffer& params) noexcept;
+            /**
+             * @brief writes sums, outputs and connection cycles back to the NeuralNetwork it was built from.
+             * @warning the topology of nn must not have changed since the plan was built.
+             * @param nn NeuralNetwork&
+             */
+            void writeState(NeuralNetwork& nn) const noexcept;
+            /**
+             * @brief resets the neurons that are not Neuron::Type::CONTEXT
+             */
+            void reset() noexcept;
+            /**
+             * @brief resets all the neurons, including Neuron::Type::CONTEXT
+             */
+            void resetContext() noexcept;
+            /**
+             * @brief getter for the EvaluationMode
+             * @return EvaluationMode
+             */
+            inline EvaluationMode getEvaluationMode() const noexcept{ return m_mode; }
+            /**
+             * @brief number of calls to Activations::activate made by the last run or forwardBatch (one per sample).
+             * @return std::size_t
+             */
+            inline std::size_t getActivationCount() const noexcept{ return m_activationCount; }
+            /**
+             * @brief sets the Activations::LookupTable used to approximate the activations, nullptr to use the exact ones.
+             * @param table std::shared_ptr<const Activations::LookupTable>
+             */
+            inline void setActivationTable(std::shared_ptr<const Activations::LookupTable> table) noexcept{ m_activationTable = std::move(table); }
+            /**
+             * @brief getter for the Activations::LookupTable, nullptr if the activations are exact.
+             * @return const std::shared_ptr<const Activations::LookupTable>&
+             */
+            inline const std::shared_ptr<const Activations::LookupTable>& getActivationTable() const noexcept{ return m_activationTable; }
+            /**
+             * @brief runs the activations of each lane of forwardBatch with the scalar functions like run does,
+             * instead of the Activations::Array ones that can be a few ulps away from them.
+             * @details used by HyperNeat so the substrate doesn't depend on the SimdLevel of the cpu.
+             * @param exact bool
+             */
+            inline void setExactActivations(bool exact) noexcept{ m_exactActivations = exact; }
+            /**
+             * @brief checks if forwardBatch runs the scalar activations, see setExactActivations.
+             * @return bool
+             */
+            inline bool hasExactActivations() const noexcept{ return m_exactActivations; }
+            /**
+             * @brief sets the ThreadPool used to run the levels of the plan, nullptr to run it on the calling thread.
+             * @details a level is split in tasks of at least minConnections connections (times the batch size),
+             * if no level has enough connections for two tasks the plan runs like it does without a pool.
+             * forwardBatch splits the samples in shards of at least minConnections connections times samples, one per thread,
+             * and backwardBatch reduces the gradients of the shards with a tree so they only depend on the number of threads.
+             * @param pool std::shared_ptr<ThreadPool>
+             * @param minConnections std::size_t
+             */
+            void setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minConnections = DefaultMinConnections) noexcept;
+            /**
+             * @brief getter for the ThreadPool, nullptr if the plan runs on the calling thread.
+             * @return const std::shared_ptr<ThreadPool>&
+             */
+            inline const std::shared_ptr<ThreadPool>& getThreadPool() const noexcept{ return m_threadPool; }
+            /**
+             * @brief neurons ordered by level, the neurons of level l are [getLevelOffsets()[l], getLevelOffsets()[l+1]),
+             * empty if there is no ThreadPool or the plan can't run by levels.
+             * @return const std::vector<std::uint32_t>&
+             */
+            inline const std::vector<std::uint32_t>& getLevels() const noexcept{ return m_levels; }
+            /**
+             * @brief offsets of each level in getLevels.
+             * @return const std::vector<std::uint32_t>&
+             */
+            inline const std::vector<std::uint32_t>& getLevelOffsets() const noexcept{ return m_levelOffsets; }
+            /**
+             * @brief checks if the plan has Neuron::Type::CONTEXT neurons.
+             * @return bool
+             */
+            bool hasContext() const noexcept;
+            /**
+             * @brief number of samples of the last forwardBatch
+             * @return std::size_t
+             */
+            inline std::size_t getBatchSize() const noexcept{ return m_batchSize; }
+            /**
+             * @brief number of neurons
+             * @return std::size_t
+             */
+            inline std::size_t numNeurons() const noexcept{ return m_types.size(); }
+            /**
+             * @brief number of connections
+             * @return std::size_t
+             */
+            inline std::size_t numConnections() const noexcept{ return m_dest.size(); }
+            /**
+             * @brief number of inputs
+             * @return std::size_t
+             */
+            inline std::size_t numInputs() const noexcept{ return m_numInputs; }
+            /**
+             * @brief number of outputs
+             * @return std::size_t
+             */
+            inline std::size_t numOutputs() const noexcept{ return numNeurons() - m_outputBegin; }
+            /**
+             * @brief order in which the neurons are evaluated.
+             * @return const std::vector<std::uint32_t>&
+             */
+            inline const std::vector<std::uint32_t>& getOrder() const noexcept{ return m_order; }
+            /**
+             * @brief type of each neuron.
+             * @return const std::vector<Neuron::Type>&
+             */
+            inline const std::vector<Neuron::Type>& getTypes() const noexcept{ return m_types; }
+            /**
+             * @brief activation type of each neuron.
+             * @return const std::vector<Neuron::ActivationType>&
+             */
+            inline const std::vector<Neuron::ActivationType>& getActivationTypes() const noexcept{ return m_activations; }
+            /**
+             * @brief checks if the output layer uses softmax.
+             * @return bool
+             */
+            inline bool hasSoftmax() const noexcept{ return m_softmax; }
+            /**
+             * @brief CSR row offsets, connections of neuron n are [rowPtr[n], rowPtr[n+1]).
+             * @return const std::vector<std::uint32_t>&
+             */
+            inline const std::vector<std::uint32_t>& getRowPtr() const noexcept{ return m_rowPtr; }
+            /**
+             * @brief destination neuron of each connection.
+             * @return const std::vector<std::uint32_t>&
+             */
+            inline const std::vector<std::uint32_t>& getDestinations() const noexcept{ return m_dest; }
+            /**
+             * @brief layers that are fully connected to another layer, they are run as a matrix instead of
+             * connection by connection in EvaluationMode::NEURON_MAJOR, in EvaluationMode::EDGE_MAJOR only
+             * the blocks whose sources are Neuron::Type::INPUT are used as the other neurons are activated once per connection.
+             * @return const std::vector<DenseBlock>&
+             */
+            inline const std::vector<DenseBlock>& getDenseBlocks() const noexcept{ return m_denseBlocks; }
+            /**
+             * @brief weight of each connection.
+             * @return const std::vector<T>&
+             */
+            inline const std::vector<T>& getWeights() const noexcept{ return m_weights; }
+            /**
+             * @brief bias weight of each neuron.
+             * @return const std::vector<T>&
+             */
+            inline const std::vector<T>& getBiases() const noexcept{ return m_biases; }
+            /**
+             * @brief cycles limit of the layer of each neuron.
+             * @return const std::vector<int>&
+             */
+            inline const std::vector<int>& getCyclesLimits() const noexcept{ return m_cyclesLimits; }
+            /**
+             * @brief sum of each neuron.
+             * @return const std::vector<T>&
+             */
+            inline const std::vector<T>& getSums() const noexcept{ return m_sums; }
+            /**
+             * @brief output of each neuron.
+             * @return const std::vector<T>&
+             */
+            inline const std::vector<T>& getOutputs() const noexcept{ return m_outputs; }
+        private:
+            /**
+             * @brief neuron state with one lane per sample, the lanes of a neuron or connection are contiguous.
+             */
+            struct Lanes{
+                T* sums;
+                T* outputs;
+                int* cycles;
+                std::size_t size;
+                std::size_t* activationCount;
+            };
+            /**
+             * @brief runs the plan over all the lanes.
+             * @param lanes Lanes
+             */
+            void runLanes(Lanes lanes) const noexcept;
+            /**
+             * @brief runs the neurons once per outgoing connection.
+             * @param lanes Lanes
+             */
+            void runEdgeMajor(Lanes lanes) const noexcept;
+            /**
+             * @brief runs the neurons once.
+             * @param lanes Lanes
+             */
+            void runNeuronMajor(Lanes lanes) const noexcept;
+            /**
+             * @brief sets what the constructors derive from the neuron and connection arrays.
+             * @param softmax bool the output layer is Neuron::ActivationType::SOFTMAX
+             */
+            void finishBuild(bool softmax) noexcept;
+            /**
+             * @brief finds the layers that can run as a DenseBlock.
+             */
+            void findDenseBlocks() noexcept;
+            /**
+             * @brief finds the level of each neuron and the connections that go to each neuron,
+             * leaves the levels empty if the plan can't run by levels.
+             */
+            void findLevels() noexcept;
+            /**
+             * @brief runs the plan level by level with the ThreadPool.
+             * @param lanes Lanes
+             * @return bool false if it didn't run because it can't or the levels are too small to split.
+             */
+            bool runLevels(Lanes lanes) const noexcept;
+            /**
+             * @brief adds the connections that go to n from its sources and finalizes it like EvaluationMode::NEURON_MAJOR.
+             * @param n std::uint32_t
+             * @param lanes Lanes
+             */
+            void pull(std::uint32_t n, Lanes lanes) const noexcept;
+            /**
+             * @brief finalizes n like pull once its sum is complete.
+             * @param n std::uint32_t
+             * @param lanes Lanes
+             */
+            void finalizeLevel(std::uint32_t n, Lanes lanes) const noexcept;
+            /**
+             * @brief runs a DenseBlock, finalizes the sources, adds them to the dests with addDenseBlock
+             * and propagates the rest of their connections.
+             * @param block const DenseBlock&
+             * @param lanes Lanes
+             */
+            void runDenseBlock(const DenseBlock& block, Lanes lanes) const noexcept;
+            /**
+             * @brief adds the sources of a DenseBlock to its dests [destBegin, destEnd) (relative to block.destBegin),
+             * the dest neurons are split in tiles that fit in the cache and each source row is added to the tile with contiguous loads.
+             * @param block const DenseBlock&
+             * @param destBegin std::size_t
+             * @param destEnd std::size_t
+             * @param lanes Lanes
+             */
+            void addDenseBlock(const DenseBlock& block, std::size_t destBegin, std::size_t destEnd, Lanes lanes) const noexcept;
+            /**
+             * @brief adds the bias and activates neuron n once like EvaluationMode::NEURON_MAJOR.
+             * @param n std::uint32_t
+             * @param lanes Lanes
+             */
+            void finalize(std::uint32_t n, Lanes lanes) const noexcept;
+            /**
+             * @brief sends the output of neuron n through the connections [begin, end).
+             * @param n std::uint32_t
+             * @param begin std::uint32_t
+             * @param end std::uint32_t
+             * @param lanes Lanes
+             */
+            void propagate(std::uint32_t n, std::uint32_t begin, std::uint32_t end, Lanes lanes) const noexcept;
+            /**
+             * @brief activates neuron n in all the lanes and counts the calls.
+             * @param n std::uint32_t
+             * @param lanes Lanes
+             */
+            void activate(std::uint32_t n, Lanes lanes) const noexcept;
+            /**
+             * @brief saves the sum of src into the context neuron dest.
+             * @param src std::uint32_t
+             * @param dest std::uint32_t
+             * @param conn std::uint32_t
+             * @param lanes Lanes
+             */
+            void storeContext(std::uint32_t src, std::uint32_t dest, std::uint32_t conn, Lanes lanes) const noexcept;
+            /**
+             * @brief runs the plan over its own state, recording the step if the truncation window is set.
+             */
+            void runStep() noexcept;
+            /**
+             * @brief resizes the state to batchSize lanes and copies the current neuron state of the plan in each lane.
+             * @param state BatchState&
+             * @param batchSize std::size_t
+             */
+            void loadBatchState(BatchState& state, std::size_t batchSize) const;
+            /**
+             * @brief runs the lanes of the state with the inputs and copies the outputs.
+             * @param inputs const T* row-major [batchSize x numInputs()]
+             * @param outputs T* row-major [batchSize x numOutputs()]
+             * @param state BatchState&
+             * @param activationCount std::size_t&
+             */
+            void runBatch(const T* inputs, T* outputs, BatchState& state, std::size_t& activationCount) const noexcept;
+            /**
+             * @brief number of shards forwardBatch splits a batch in, 0 if it runs on the calling thread.
+             * @param batchSize std::size_t
+             * @return std::size_t
+             */
+            std::size_t numShardsFor(std::size_t batchSize) const noexcept;
+            /**
+             * @brief runs the shards of the batch on the ThreadPool.
+             * @param inputs const std::vector<T>&
+             * @param outputs std::vector<T>&
+             */
+            void forwardShards(const std::vector<T>& inputs, std::vector<T>& outputs) noexcept;
+            /**
+             * @brief calculates the gradients of each shard in its own buffer and reduces them.
+             * @param gradientLoss const std::vector<T>&
+             * @param gradientOfSums bool
+             * @param inputGradients std::vector<T>&
+             */
+            void backwardShards(const std::vector<T>& gradientLoss, bool gradientOfSums, std::vector<T>& inputGradients) noexcept;
+            /**
+             * @brief calculates the gradients of batchSize lanes like NeuralNetwork::backward, the weight gradients are added
+             * and the bias gradients are set.
+             * @param gradientLoss const T* row-major [batchSize x numOutputs()]
+             * @param gradientOfSums bool skips the derivative of the output neurons.
+             * @param batchSize std::size_t
+             * @param sums const T*
+             * @param outs const T*
+             * @param grads T* [numNeurons() x batchSize]
+             * @param derivatives T* batchSize values
+             * @param weightGradients double* numConnections() values
+             * @param biasGradients double* numNeurons() values
+             */
+            void backwardLanes(const T* gradientLoss, bool gradientOfSums, std::size_t batchSize, const T* sums, const T* outs, T* grads,
+                               T* derivatives, double* weightGradients, double* biasGradients) const noexcept;
+            /**
+             * @brief checks that each context neuron is only fed by stores from neurons after it in the same step.
+             * @return bool
+             */
+            bool canRunThroughTime() const noexcept;
+            /**
+             * @brief step recorded age steps after the oldest one in the ring buffer.
+             * @details a step has numNeurons() sums, numNeurons() outputs and numOutputs() loss gradients.
+             * @param age std::size_t
+             * @return T*
+             */
+            T* timeStep(std::size_t age) noexcept;
+            /**
+             * @brief saves the sums before the step, the context neurons run with them.
+             */
+            void beginStep() noexcept;
+            /**
+             * @brief saves the sums and outputs of the other neurons after the step.
+             */
+            void endStep() noexcept;
+            /**
+             * @brief saves the sum plus bias of the Output neuron src into the context neuron dest.
+             * @param src std::uint32_t
+             * @param dest std::uint32_t
+             * @param conn std::uint32_t
+             * @param lanes Lanes
+             */
+            void storeOutput(std::uint32_t src, std::uint32_t dest, std::uint32_t conn, Lanes lanes) const noexcept;
+        private:
+            std::vector<std::uint32_t> m_layerOffsets;
+            std::vector<std::uint32_t> m_order;
+            std::vector<Neuron::Type> m_types;
+            std::vector<Neuron::ActivationType> m_activations;
+            std::vector<T> m_biases;
+            std::vector<int> m_cyclesLimits;
+            std::vector<std::uint32_t> m_rowPtr;
+            std::vector<std::uint32_t> m_dest;
+            std::vector<T> m_weights;
+            std::vector<T> m_sums;
+            std::vector<T> m_outputs;
+            std::vector<int> m_cycles;
+            std::vector<T> m_batchSums;
+            std::vector<T> m_batchOutputs;
+            std::vector<T> m_batchGradients;
+            std::vector<int> m_batchCycles;
+            std::vector<double> m_weightGradients;
+            std::vector<double> m_biasGradients;
+            std::vector<T> m_derivatives;
+            std::vector<DenseBlock> m_denseBlocks;
+            std::vector<std::int32_t> m_denseBlockOf;
+            std::shared_ptr<const Activations::LookupTable> m_activationTable;
+            std::shared_ptr<ThreadPool> m_threadPool;
+            std::vector<std::uint32_t> m_levels;
+            std::vector<std::uint32_t> m_levelOffsets;
+            std::vector<std::uint32_t> m_levelConnections;
+            std::vector<std::int32_t> m_levelBlocks;
+            std::vector<std::uint32_t> m_inPtr;
+            std::vector<std::uint32_t> m_inConns;
+            std::vector<std::uint32_t> m_inSrcs;
+            std::vector<T> m_timeArena;
+            std::vector<std::int32_t> m_contextSources;
+            std::vector<double> m_timeDeltas;
+            std::vector<double> m_timeOutputGradients;
+            std::vector<double> m_timeWeightGradients;
+            std::vector<double> m_timeBiasGradients;
+            std::size_t m_window;
+            std::size_t m_timeHead;
+            std::size_t m_timeSteps;
+            std::size_t m_stepCount;
+            std::size_t m_firstPending;
+            std::vector<Shard> m_shards;
+            std::size_t m_minConnections;
+            std::size_t m_numShards;
+            std::size_t m_batchSize;
+            std::size_t m_numInputs;
+            std::size_t m_outputBegin;
+            std::size_t m_activationCount;
+            EvaluationMode m_mode;
+            bool m_softmax;
+            bool m_usesCycles;
+            bool m_exactActivations;
+    };
+    extern template class EvoAI_API BasicExecutionPlan<double>;
+    extern template class EvoAI_API BasicExecutionPlan<float>;
+    /**
+     * @brief double precision ExecutionPlan, gives the same results as NeuralNetwork::run.
+     */
+    using ExecutionPlan = BasicExecutionPlan<double>;
+    /**
+     * @brief single precision ExecutionPlan.
+     */
+    using ExecutionPlanF = BasicExecutionPlan<float>;
+}
+
+#endif // EVOAI_EXECUTION_PLAN_HPP
@@ -338,10 +338,31 @@ namespace EvoAI{
             static Genome reproduce(const Genome& g1, const Genome& g2) noexcept;
             /**
              * @brief Creates a NeuralNetwork from a Genome.
+             * @details every enabled gene is kept, use optimizePhenotype (NNUtils.hpp) to remove the neurons and
+             * connections that do not change the outputs before evaluating it.
+             * All the hidden nodes are in one layer, see makeLayeredPhenotype to order them by depth.
              * @param g Genome
              * @return NeuralNetwork
              */
             static NeuralNetwork makePhenotype(const Genome& g) noexcept;
+            /**
+             * @brief Creates a NeuralNetwork from a Genome with a layer for each depth of the hidden nodes.
+             * @details The depth of a hidden node is the longest path to it from the inputs, the inputs are the first layer,
+             * the hidden nodes of depth d are layer d and the outputs are the last layer. Cycles between hidden nodes are
+             * broken at the node with the lowest id, the connections that go back to a layer that is not after them
+             * are recurrent like in makePhenotype.
+             * When the hidden nodes don't form cycles every hidden neuron has all its inputs before it feeds another one,
+             * so one forward pass gives the outputs, without running the network again to let them settle.
+             * The neurons are placed by the id of their genes.
+             * @code
+             *      auto nn = EvoAI::Genome::makeLayeredPhenotype(genome);
+             *      nn.compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+             *      auto outputs = nn.forward(inputs);
+             * @endcode
+             * @param g Genome
+             * @return NeuralNetwork
+             */
+            static NeuralNetwork makeLayeredPhenotype(const Genome& g) noexcept;
             /**
              * @brief Creates a genome from a neural network, it will not be exactly the same if the network wasn't made from a genome.
              * @param nn NeuralNetwork
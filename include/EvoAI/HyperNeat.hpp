@@ -152,6 +152,17 @@ namespace EvoAI{
              * @return const Genome&
              */
             const Genome& getGenome() const noexcept;
+            /**
+             * @brief approximates the activations of the CPPN with a Activations::LookupTable
+             * while the substrate weights are made, nullptr uses the exact activations.
+             * @param table std::shared_ptr<const Activations::LookupTable>
+             */
+            void setCppnActivationTable(std::shared_ptr<const Activations::LookupTable> table) noexcept;
+            /**
+             * @brief getter for the Activations::LookupTable used by the CPPN.
+             * @return const std::shared_ptr<const Activations::LookupTable>&
+             */
+            const std::shared_ptr<const Activations::LookupTable>& getCppnActivationTable() const noexcept;
             /**
              * @brief This assumes that subst is a valid substrate for this HyperNeat.
              * @details this can be used when the substrate has been trained using backward 
@@ -197,6 +208,16 @@ namespace EvoAI{
              * @return std::vector<double>&&
              */
             std::vector<double> forward(std::vector<double>&& input) noexcept;
+            /**
+             * @brief runs the substrate with NeuralNetwork::forward on buffers of the caller, once the substrate
+             * is made and has run once it doesn't touch the heap.
+             * @param inputs const double*
+             * @param numInputs std::size_t
+             * @param outputs double*
+             * @param numOutputs std::size_t
+             * @return bool false if numInputs or numOutputs are wrong.
+             */
+            bool forward(const double* inputs, std::size_t numInputs, double* outputs, std::size_t numOutputs) noexcept;
             /**
              * @brief calculates the gradients for the network.
              * @warning It needs to be called before calling reset as the outputs and gradients would be 0.0
@@ -265,6 +286,7 @@ namespace EvoAI{
             NeuralNetwork substrate;
             SubstrateInfo substrateInfo;
             SubstrateConfiguration substrateConf;
+            std::shared_ptr<const Activations::LookupTable> cppnActivationTable;
             bool isSubstrateValid;
             bool isSubstrateReady;
     };
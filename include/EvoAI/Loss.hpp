@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include <EvoAI/Export.hpp>
 #include <EvoAI/Utils/TypeUtils.hpp>
 
@@ -19,10 +20,17 @@ namespace EvoAI{
          * @brief Algo needs to fulfill these requirements: <br />
          *      Algo has a double operator()(const std::vector<double>& expectedOutputs, const std::vector<double>& outputs) noexcept <br />
          *      Algo has a std::vector<double> backward(const std::vector<double>& expectedOutputs, const std::vector<double>& outputs) noexcept <br />
+         *  Optionally, to avoid allocating the gradients of each sample: <br />
+         *      Algo has a double lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept <br />
+         *      Algo has a double softmaxLossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept <br />
          * @tparam Algo
          */
         struct Loss{
             static_assert(meta::is_a_loss_v<Algo>, "Algo needs to be a Loss Algo, more info at Loss.hpp");
+            /**
+             * @brief Algo has a fused softmax and loss like MultiClassCrossEntropy.
+             */
+            static constexpr bool FusesSoftmax = meta::has_softmax_loss_and_grad_v<Algo>;
             /**
              * @brief constructor
              * @param algo Algo struct implementing is_a_loss_v
@@ -47,6 +55,38 @@ namespace EvoAI{
             std::vector<double> backward(const std::vector<double>& expectedOutputs, const std::vector<double>& outputs) noexcept{
                 return loss.backward(expectedOutputs, outputs);
             }
+            /**
+             * @brief loss and gradients of the outputs in one pass, algorithms without lossAndGrad use operator() and backward.
+             * @param expectedOutputs const double*
+             * @param outputs const double*
+             * @param gradients double* size values
+             * @param size std::size_t
+             * @return double
+             */
+            double lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+                if constexpr(meta::has_loss_and_grad_v<Algo>){
+                    return loss.lossAndGrad(expectedOutputs, outputs, gradients, size);
+                }else{
+                    std::vector<double> expected(expectedOutputs, expectedOutputs + size);
+                    std::vector<double> outs(outputs, outputs + size);
+                    auto grads = loss.backward(expected, outs);
+                    std::copy(std::begin(grads), std::end(grads), gradients);
+                    return loss(expected, outs);
+                }
+            }
+            /**
+             * @brief like lossAndGrad but the gradients are for the sums of a Neuron::ActivationType::SOFTMAX output layer,
+             * only when FusesSoftmax.
+             * @param expectedOutputs const double*
+             * @param outputs const double*
+             * @param gradients double* size values
+             * @param size std::size_t
+             * @return double
+             */
+            double softmaxLossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+                static_assert(FusesSoftmax, "Algo needs a softmaxLossAndGrad");
+                return loss.softmaxLossAndGrad(expectedOutputs, outputs, gradients, size);
+            }
             // algorithm
             Algo loss;
         };
@@ -25,6 +25,15 @@ namespace EvoAI{
              * @return std::vector<double> gradients for output layer
              */
             std::vector<double> backward(const std::vector<double>& expectedOutputs, const std::vector<double>& outputs) noexcept;
+            /**
+             * @brief loss and gradients in one pass, the gradients are written into a preallocated buffer.
+             * @param expectedOutputs const double*
+             * @param outputs const double*
+             * @param gradients double* size gradients for output layer, same as backward.
+             * @param size std::size_t
+             * @return double same as operator()
+             */
+            double lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept;
         };
    }
 }
@@ -25,6 +25,27 @@ namespace EvoAI{
              * @return std::vector<double> gradients for output layer
              */
             std::vector<double> backward(const std::vector<double>& expectedOutputs, const std::vector<double>& outputs) noexcept;
+            /**
+             * @brief loss and gradients in one pass, the gradients are written into a preallocated buffer.
+             * @param expectedOutputs const double*
+             * @param outputs const double*
+             * @param gradients double* size gradients for output layer, same as backward.
+             * @param size std::size_t
+             * @return double same as operator()
+             */
+            double lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept;
+            /**
+             * @brief fused softmax and cross entropy for a Neuron::ActivationType::SOFTMAX output layer.
+             * @details The gradients are for the sums of the output neurons (outputs - expectedOutputs), what backward
+             *  times the derivative of the softmax gives but without dividing by the outputs so it stays stable
+             *  when they saturate. They need to skip the derivative of the output layer, see NeuralNetwork::backward.
+             * @param expectedOutputs const double*
+             * @param outputs const double* outputs of the softmax
+             * @param gradients double* size gradients for the sums of the output layer.
+             * @param size std::size_t
+             * @return double same as operator()
+             */
+            double softmaxLossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept;
         };
    }
 }
@@ -0,0 +1,195 @@
+#ifndef EVOAI_MODEL_FILE_HPP
+#define EVOAI_MODEL_FILE_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <EvoAI/Export.hpp>
+
+namespace EvoAI{
+    class NeuralNetwork;
+    /**
+     * @class ModelFile
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file ModelFile.hpp
+     * @brief A binary NeuralNetwork file that is memory mapped and read in place.
+     * @details The file is a Header followed by tables of fixed size records, each table aligned to 8 bytes:
+     *  - LayerRecord[numLayers]
+     *  - NeuronRecord[numNeurons], the neurons numbered layer by layer.
+     *  - std::uint32_t rowPtr[numNeurons + 1], the connections of neuron n are [rowPtr[n], rowPtr[n + 1]).
+     *  - ConnectionRecord[numConnections], grouped by source neuron in the order of NeuralNetwork::getConnections.
+     *  - double weights[numConnections]
+     *  - double biases[numNeurons]
+     *
+     *  The tables have the layout of ExecutionPlan so it can be built from them without parsing,
+     *  and the network loads with NeuralNetwork(const ModelFile&).
+     *  Numbers are stored in the byte order of the machine that wrote them, a file from a machine with another
+     *  byte order is not valid. Gradients, outputs and the state of the context neurons are not stored.
+     * @code
+     *     EvoAI::ModelFile::write(*nn, "nn.evoai");
+     *     EvoAI::ModelFile model("nn.evoai");
+     *     if(model.isValid()){
+     *         EvoAI::ExecutionPlan plan(model);
+     *         auto outputs = plan.forward({0.5, 1.0});
+     *     }
+     * @endcode
+     */
+    class EvoAI_API ModelFile final{
+        public:
+            /**
+             * @brief version written by write, files with other versions are not valid.
+             */
+            static constexpr std::uint32_t Version = 1u;
+            /**
+             * @brief written in the byte order of the machine.
+             */
+            static constexpr std::uint32_t ByteOrderMark = 0x01020304u;
+            struct Header{
+                char magic[8]; ///< "EVOAINN"
+                std::uint32_t version;
+                std::uint32_t byteOrder;
+                std::uint64_t globalStep;
+                std::uint32_t numLayers;
+                std::uint32_t numNeurons;
+                std::uint32_t numConnections;
+                std::uint32_t reserved;
+                std::uint64_t layersOffset;
+                std::uint64_t neuronsOffset;
+                std::uint64_t rowPtrOffset;
+                std::uint64_t connectionsOffset;
+                std::uint64_t weightsOffset;
+                std::uint64_t biasesOffset;
+                std::uint64_t fileSize;
+            };
+            struct LayerRecord{
+                std::uint32_t firstNeuron;
+                std::uint32_t numNeurons;
+                std::uint32_t neuronType;
+                std::uint32_t activationType;
+                std::int32_t cyclesLimit;
+                std::uint32_t reserved;
+                double bias;
+            };
+            struct NeuronRecord{
+                std::uint8_t type;
+                std::uint8_t activationType;
+                std::uint8_t flags; ///< FrozenFlag if the bias is frozen.
+                std::uint8_t reserved;
+            };
+            struct ConnectionRecord{
+                std::uint32_t dest; ///< index of the destination neuron.
+                std::uint32_t flags; ///< FrozenFlag
+            };
+            static constexpr std::uint32_t FrozenFlag = 1u;
+            static_assert(sizeof(Header) == 96u && std::is_trivially_copyable_v<Header>, "ModelFile::Header needs to be 96 bytes");
+            static_assert(sizeof(LayerRecord) == 32u, "ModelFile::LayerRecord needs to be 32 bytes");
+            static_assert(sizeof(NeuronRecord) == 4u, "ModelFile::NeuronRecord needs to be 4 bytes");
+            static_assert(sizeof(ConnectionRecord) == 8u, "ModelFile::ConnectionRecord needs to be 8 bytes");
+        public:
+            /**
+             * @brief an empty file, not valid.
+             */
+            ModelFile() noexcept;
+            /**
+             * @brief maps the file and checks its header and tables, see isValid.
+             * @param filename const std::string&
+             */
+            explicit ModelFile(const std::string& filename);
+            ModelFile(const ModelFile&) = delete;
+            ModelFile& operator=(const ModelFile&) = delete;
+            ModelFile(ModelFile&& rhs) noexcept;
+            ModelFile& operator=(ModelFile&& rhs) noexcept;
+            /**
+             * @brief writes nn to filename.
+             * @param nn NeuralNetwork&
+             * @param filename const std::string&
+             * @return bool false if the file could not be written.
+             */
+            static bool write(NeuralNetwork& nn, const std::string& filename);
+            /**
+             * @brief converts a json file written by NeuralNetwork::writeToFile to a binary file.
+             * @param jsonFile const std::string&
+             * @param binaryFile const std::string&
+             * @return bool false if the binary file could not be written.
+             */
+            static bool jsonToBinary(const std::string& jsonFile, const std::string& binaryFile);
+            /**
+             * @brief converts a binary file to a json file like NeuralNetwork::writeToFile writes.
+             * @param binaryFile const std::string&
+             * @param jsonFile const std::string&
+             * @return bool false if the binary file is not valid.
+             */
+            static bool binaryToJson(const std::string& binaryFile, const std::string& jsonFile);
+            /**
+             * @brief checks if the file was mapped and its tables are consistent,
+             * the accessors below can only be used on a valid file.
+             * @return bool
+             */
+            inline bool isValid() const noexcept{ return m_valid; }
+            /**
+             * @brief size of the file in bytes.
+             * @return std::size_t
+             */
+            inline std::size_t size() const noexcept{ return m_size; }
+            /**
+             * @brief getter for the Header
+             * @return const Header&
+             */
+            inline const Header& getHeader() const noexcept{ return *reinterpret_cast<const Header*>(m_data); }
+            /**
+             * @brief getter for the layers table.
+             * @return const LayerRecord* getHeader().numLayers records.
+             */
+            inline const LayerRecord* getLayers() const noexcept{ return table<LayerRecord>(getHeader().layersOffset); }
+            /**
+             * @brief getter for the neurons table.
+             * @return const NeuronRecord* getHeader().numNeurons records.
+             */
+            inline const NeuronRecord* getNeurons() const noexcept{ return table<NeuronRecord>(getHeader().neuronsOffset); }
+            /**
+             * @brief getter for the start of the connections of each neuron.
+             * @return const std::uint32_t* getHeader().numNeurons + 1 offsets.
+             */
+            inline const std::uint32_t* getRowPtr() const noexcept{ return table<std::uint32_t>(getHeader().rowPtrOffset); }
+            /**
+             * @brief getter for the connections table.
+             * @return const ConnectionRecord* getHeader().numConnections records.
+             */
+            inline const ConnectionRecord* getConnections() const noexcept{ return table<ConnectionRecord>(getHeader().connectionsOffset); }
+            /**
+             * @brief getter for the weights of the connections.
+             * @return const double* getHeader().numConnections weights.
+             */
+            inline const double* getWeights() const noexcept{ return table<double>(getHeader().weightsOffset); }
+            /**
+             * @brief getter for the bias weights of the neurons.
+             * @return const double* getHeader().numNeurons weights.
+             */
+            inline const double* getBiases() const noexcept{ return table<double>(getHeader().biasesOffset); }
+            /**
+             * @brief unmaps the file.
+             */
+            ~ModelFile();
+        private:
+            template<typename Record>
+            inline const Record* table(std::uint64_t offset) const noexcept{ return reinterpret_cast<const Record*>(m_data + offset); }
+            /**
+             * @brief checks the header and that every table is inside the file and points inside the other tables.
+             * @return bool
+             */
+            bool validate() const noexcept;
+            /**
+             * @brief unmaps the file and leaves it empty.
+             */
+            void unmap() noexcept;
+        private:
+            const unsigned char* m_data;
+            std::size_t m_size;
+            void* m_mapping;
+            bool m_valid;
+    };
+}
+
+#endif // EVOAI_MODEL_FILE_HPP
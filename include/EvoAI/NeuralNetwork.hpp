@@ -4,6 +4,13 @@
 #include <vector>
 #include <cstdint>
 #include <algorithm>
+#include <numeric>
+#include <optional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <future>
 
 #include <EvoAI/Loss.hpp>
 #include <EvoAI/NeuronLayer.hpp>
@@ -11,6 +18,10 @@
 #include <EvoAI/Optimizers.hpp>
 #include <EvoAI/Export.hpp>
 #include <EvoAI/DataLoader.hpp>
+#include <EvoAI/ExecutionPlan.hpp>
+#include <EvoAI/ThreadPool.hpp>
+#include <EvoAI/TrainingProfiler.hpp>
+#include <EvoAI/ModelFile.hpp>
 
 #include <JsonBox.h>
 
@@ -25,6 +36,12 @@ namespace EvoAI{
     class EvoAI_API NeuralNetwork final{
         public:
             using trainingFormat = std::vector<std::vector<double>>;
+            /**
+             * @brief called by train with the results of each epoch, returns false to stop the training.
+             * @details bool epochCallback(std::size_t epoch, double avgLoss, double testAvgLoss, double accuracy);
+             *  epoch is the index of the epoch in the rows train returns.
+             */
+            using EpochCallback = std::function<bool(std::size_t, double, double, double)>;
         public:
             /**
              * @brief default constructor
@@ -51,6 +68,11 @@ namespace EvoAI{
              * @param filename
              */
             NeuralNetwork(const std::string& filename);
+            /**
+             * @brief Loads the NN from a binary file, see ModelFile.
+             * @param model const ModelFile& the network is empty if the model is not valid.
+             */
+            explicit NeuralNetwork(const ModelFile& model);
             /**
              * @brief adds a layer to the neural network
              * @param l const NeuronLayer&
@@ -69,17 +91,54 @@ namespace EvoAI{
              */
             std::vector<double> run();
             /**
-             * @brief calls setsInput and calls run
+             * @brief calls setsInput and calls run, if the network is compiled it will run from the ExecutionPlan.
              * @param input const std::vector<double>&
              * @return const std::vector<double>&
              */
             std::vector<double> forward(const std::vector<double>& input) noexcept;
             /**
-             * @brief calls setsInput and calls run
+             * @brief calls setsInput and calls run, if the network is compiled it will run from the ExecutionPlan.
              * @param input std::vector<double>&&
              * @return std::vector<double>&&
              */
             std::vector<double> forward(std::vector<double>&& input) noexcept;
+            /**
+             * @brief like forward but reads the inputs from and writes the outputs to buffers of the caller,
+             * once the connections are cached by a first run it doesn't touch the heap.
+             * @code
+             *     std::array<double, 2> in{0.5, 1.0};
+             *     std::array<double, 1> out;
+             *     nn.forward(in.data(), in.size(), out.data(), out.size());
+             *     nn.reset();
+             * @endcode
+             * @param inputs const double* numInputs values
+             * @param numInputs std::size_t
+             * @param outputs double* room for numOutputs values
+             * @param numOutputs std::size_t
+             * @return bool false if numInputs or numOutputs are wrong, nothing is run then.
+             */
+            bool forward(const double* inputs, std::size_t numInputs, double* outputs, std::size_t numOutputs) noexcept;
+            /**
+             * @brief runs the ExecutionPlan with an external InferenceState, the network is not modified
+             * so many threads can share it as long as each one has its own InferenceState.
+             * @warning the network needs to be compiled and its weights must not change while other threads use it.
+             * @code
+             *     nn.compile();
+             *     // on each thread
+             *     auto state = nn.makeInferenceState();
+             *     auto outputs = nn.forward({...}, state);
+             *     nn.reset(state);
+             * @endcode
+             * @param input const std::vector<double>&
+             * @param state InferenceState&
+             * @return std::vector<double> outputs, empty if the network is not compiled or input or state have the wrong size.
+             */
+            std::vector<double> forward(const std::vector<double>& input, InferenceState& state) const noexcept;
+            /**
+             * @brief makes an InferenceState with the current neuron state, if the network is not compiled it will be compiled.
+             * @return InferenceState
+             */
+            InferenceState makeInferenceState();
             /**
              * @brief calculates the gradients for the network.
              * @warning It needs to be called before calling reset as the outputs and gradients would be 0.0
@@ -91,13 +150,56 @@ namespace EvoAI{
              *     nn.reset() // it will reset the network
              * @endcode
              * @param gradientLoss std::vector<double>&&
+             * @param gradientOfSums bool true if gradientLoss is already the gradient of the sums of the output layer
+             * (like Loss::MultiClassCrossEntropy::softmaxLossAndGrad gives), the derivative of its activation is skipped.
              * @return std::vector<double> gradients of layer[0]
              */
-            std::vector<double> backward(std::vector<double>&& gradientLoss) noexcept;
+            std::vector<double> backward(std::vector<double>&& gradientLoss, bool gradientOfSums = false) noexcept;
+            /**
+             * @brief like backward but reads the loss gradients from a buffer of the caller and doesn't allocate,
+             * the gradients of layer[0] are left in its neurons.
+             * @param gradientLoss const double* gradients of the output layer
+             * @param size std::size_t size of gradientLoss
+             * @param gradientOfSums bool same as backward.
+             * @return bool false if size is not the size of the output layer.
+             */
+            bool backward(const double* gradientLoss, std::size_t size, bool gradientOfSums = false) noexcept;
+            /**
+             * @brief runs a batch of samples, each sample starts from the current state of the network
+             * as if forward was called after reset() for each one, if the network is not compiled it will be compiled.
+             * @details the neuron state has a lane per sample, so each weight is loaded once for the whole batch.
+             * @code
+             *     // 2 samples of 3 inputs
+             *     auto outputs = nn.forwardBatch({0.1, 0.2, 0.3,
+             *                                     0.4, 0.5, 0.6}, 2);
+             *     nn.backwardBatch(gradientsLoss); // [2 x outputs]
+             *     optim.step(epoch);
+             * @endcode
+             * @param inputs const std::vector<double>& row-major [batchSize x inputs]
+             * @param batchSize std::size_t
+             * @return std::vector<double> row-major [batchSize x outputs], empty if inputs has the wrong size.
+             */
+            std::vector<double> forwardBatch(const std::vector<double>& inputs, std::size_t batchSize) noexcept;
+            /**
+             * @brief calculates the gradients of the last forwardBatch and adds them to the parameters like
+             * calling backward for each sample would.
+             * @warning it needs forwardBatch to be called first.
+             * @param gradientLoss const std::vector<double>& row-major [batchSize x outputs]
+             * @param gradientOfSums bool same as backward.
+             * @return std::vector<double> row-major [batchSize x inputs] gradients of layer[0]
+             */
+            std::vector<double> backwardBatch(const std::vector<double>& gradientLoss, bool gradientOfSums = false) noexcept;
             /**
              * @brief method to train the neural network.
              * @details
              *  The test function should be std::pair<double aka avgTest, double aka accuracy> testFn(NeuralNetwork&, DataLoader<Dataset>) noexcept;
+             *  With setAsyncTest the testFn runs on a snapshot of the network in a background thread while the next epoch trains,
+             *  its results are collected at the end of that epoch, so the EpochCallback (see setEpochCallback) of an epoch is
+             *  called an epoch later and stopping from it still trains the epoch in flight. The test results of that epoch
+             *  are returned but the EpochCallback is not called for them.
+             *  A compiled network without context neurons trains in batches, an SGD or Adam optimizer then updates the
+             *  weights of the ExecutionPlan in place (see ExecutionPlan::bindParameters) and they are copied to the
+             *  connections at the end of each epoch, before testFn runs.
              * @tparam Optim configured Optimizer
              * @tparam LossAlgo the loss function to use
              * @tparam Dataset dataset for training and testing
@@ -108,44 +210,105 @@ namespace EvoAI{
              * @param epoch epoches to do
              * @param lossAlgo LossAlgo
              * @param testFn TestFn
-             * @return average loss of epoch, avg loss of test and accuracy
+             * @return average loss of epoch, avg loss of test and accuracy,
+             *  with a TrainingProfiler (see setProfiler) it is followed by the samples per second
+             *  and the seconds of each TrainingProfiler::Phase in order.
              */
             template<typename Optim, typename LossAlgo, class Dataset, typename TestFn>
             std::vector<std::vector<double>> train(DataLoader<Dataset>& trainingDataset, 
                                                     DataLoader<Dataset>& testDataset, 
                                                     Optim& optim, std::size_t epoch, LossAlgo&& lossAlgo,
                                                     TestFn&& testFn){
-                std::vector<std::vector<double>> data(3);
-                data[0].reserve(epoch);
-                data[1].reserve(epoch);
-                data[2].reserve(epoch);
+                std::vector<std::vector<double>> data(profiler ? 4u + TrainingProfiler::NumPhases : 3u);
+                for(auto& row:data){
+                    row.reserve(epoch);
+                }
                 Loss::Loss<LossAlgo> lossFn{std::forward<LossAlgo>(lossAlgo)};
+                std::vector<double> outputs;
+                std::vector<double> gradients;
+                BatchBuffers batchBuffers;
+                std::unique_ptr<NeuralNetwork> snapshot;
+                if(asyncTest){
+                    snapshot = makeSnapshot();
+                }
+                std::future<std::pair<double, double>> pendingTest;
+                auto keepTraining = true;
+                auto addTestResults = [&](const std::pair<double, double>& results){
+                    testDataset.shuffle();
+                    data[1].emplace_back(results.first);
+                    data[2].emplace_back(results.second);
+                    auto index = data[1].size() - 1u;
+                    // after a stop the results of the epoch in flight are only recorded.
+                    if(!keepTraining || !epochCallback){
+                        return keepTraining;
+                    }
+                    return epochCallback(index, data[0][index], results.first, results.second);
+                };
                 auto totalLoss = 0.0;
                 auto printAt = 1;
                 std::cout << "globalStep: " << globalStep << std::endl;
                 for(auto e=0u;e<epoch;++e){
+                    if(profiler){
+                        profiler->beginEpoch(globalStep);
+                    }
                     if(e%printAt==0){
                         std::cout << "[ Epoch " << (e+1) << "/" << epoch << " ]\n---------------------\n";
                     }
+                    TrainingProfiler::Stopwatch watch(profiler.get());
                     auto samples = trainingDataset.size();
                     auto totalBatchLoss= 0.0;
                     auto batchSize = trainingDataset.getBatchSize();
+                    // the samples of a batch can only run together if they don't depend on each other.
+                    auto runBatched = executionPlan && !executionPlan->hasContext();
+                    // the optimizer updates the plan in place, the weights go back to the connections at the end of the epoch.
+                    auto bound = runBatched && bindParameters(optim);
+                    auto throughTime = executionPlan && executionPlan->getTruncationWindow() > 0u;
+                    // backwardThroughTime always runs the derivative of the output layer.
+                    auto gradientOfSums = !throughTime && fusesSoftmax(lossFn);
+                    outputs.resize(layers.back().size());
+                    gradients.resize(layers.back().size());
                     for(auto i=0u;i<samples;++i){
-                        for(auto b=0u;b<batchSize;++b){
-                            auto [inputs, expectedOutputs] = trainingDataset();
-                            auto outputs = forward(inputs);
-                            auto loss = lossFn(expectedOutputs, outputs);
-                            totalLoss += loss;
-                            totalBatchLoss += loss;
-                            backward(lossFn.backward(expectedOutputs, outputs));
-                            reset();
+                        if(runBatched){
+                            totalBatchLoss = trainBatch(trainingDataset, lossFn, batchSize, bound, batchBuffers, watch);
+                            totalLoss += totalBatchLoss;
+                        }else{
+                            for(auto b=0u;b<batchSize;++b){
+                                auto [inputs, expectedOutputs] = trainingDataset();
+                                watch.lap(TrainingProfiler::Phase::DATA_LOADING);
+                                forward(inputs.data(), inputs.size(), outputs.data(), outputs.size());
+                                watch.lap(TrainingProfiler::Phase::FORWARD);
+                                auto loss = sampleLoss(expectedOutputs.data(), outputs.data(), gradients.data(), lossFn, gradientOfSums);
+                                totalLoss += loss;
+                                totalBatchLoss += loss;
+                                watch.lap(TrainingProfiler::Phase::LOSS);
+                                if(throughTime){
+                                    backwardThroughTime(gradients);
+                                }else{
+                                    backward(gradients.data(), gradients.size(), gradientOfSums);
+                                }
+                                reset();
+                                watch.lap(TrainingProfiler::Phase::BACKWARD);
+                            }
+                            if(throughTime){
+                                propagateThroughTime();
+                                watch.lap(TrainingProfiler::Phase::BACKWARD, 0u);
+                            }
                         }
                         if(e%printAt==0){
                             std::cout << "[ batch # " << ((i+1) * batchSize) << "/" << (samples * batchSize) << "] - [avgBatchLoss: " << (totalBatchLoss / batchSize) << "]\n";
                         }
                         totalBatchLoss = 0.0;
+                        watch.restart();
                         optim.step(e);
                         optim.zeroGrad();
+                        if(executionPlan && !bound){
+                            executionPlan->updateWeights(*this);
+                        }
+                        watch.lap(TrainingProfiler::Phase::OPTIMIZER);
+                    }
+                    if(bound){
+                        unbindParameters(optim);
+                        watch.lap(TrainingProfiler::Phase::OPTIMIZER, 0u);
                     }
                     trainingDataset.shuffle();
                     auto avgLoss = totalLoss / (samples * batchSize);
@@ -153,6 +316,138 @@ namespace EvoAI{
                         std::cout << "\tavgLoss: " << avgLoss << std::endl;
                     }
                     totalLoss = 0.0;
+                    data[0].emplace_back(avgLoss);
+                    watch.restart();
+                    if(snapshot){
+                        // one test in flight, the one of the previous epoch ran while this epoch trained.
+                        if(pendingTest.valid()){
+                            keepTraining = addTestResults(pendingTest.get());
+                        }
+                        copyParametersTo(*snapshot);
+                        pendingTest = std::async(std::launch::async, [&testFn, &testDataset, &snapshot](){
+                            auto [testAvgLoss, accuracy] = testFn(*snapshot, testDataset);
+                            return std::pair<double, double>(testAvgLoss, accuracy);
+                        });
+                    }else{
+                        auto [testAvgLoss, accuracy] = testFn(*this, testDataset);
+                        keepTraining = addTestResults(std::pair<double, double>(testAvgLoss, accuracy));
+                    }
+                    watch.lap(TrainingProfiler::Phase::TEST);
+                    if(profiler){
+                        auto& stats = profiler->endEpoch(samples * batchSize);
+                        data[3].emplace_back(stats.samplesPerSecond());
+                        for(auto p=0u;p<TrainingProfiler::NumPhases;++p){
+                            data[4u + p].emplace_back(stats.phaseSeconds[p]);
+                        }
+                    }
+                    lastAvgLoss = avgLoss;
+                    ++globalStep;
+                    if(!keepTraining){
+                        break;
+                    }
+                }
+                if(pendingTest.valid()){
+                    addTestResults(pendingTest.get());
+                }
+                return data;
+            }
+            /**
+             * @brief trains the neural network with lock-free asynchronous SGD (Hogwild!).
+             * @details Each thread of the ThreadPool (or only the calling thread without one) takes batches from
+             *  the trainingDataset and applies its SGD update to the shared weights right away with relaxed atomics,
+             *  without waiting for the other threads or reducing their gradients. The threads run on their own copy of
+             *  the ExecutionPlan and read the shared weights before each batch, so they can see updates of other threads
+             *  half applied. Only plain SGD is supported (no momentum), the results are not deterministic with more than one thread.
+             *  The network is compiled if it wasn't, networks with Neuron::Type::CONTEXT neurons can't be trained this way.
+             * @code
+             *     nn->setThreadPool(std::make_shared<EvoAI::ThreadPool>(4));
+             *     nn->trainHogwild(trainingDataset, testDataset, 0.1, epochs, EvoAI::Loss::MeanSquaredError{}, testFn);
+             * @endcode
+             * @tparam LossAlgo the loss function to use
+             * @tparam Dataset dataset for training and testing
+             * @tparam TestFn test function, same as train
+             * @param trainingDataset DataLoader<Dataset>&
+             * @param testDataset DataLoader<Dataset>&
+             * @param lr double learning rate
+             * @param epoch epoches to do
+             * @param lossAlgo LossAlgo
+             * @param testFn TestFn
+             * @return average loss of epoch, avg loss of test and accuracy, empty if the network has context neurons.
+             */
+            template<typename LossAlgo, class Dataset, typename TestFn>
+            std::vector<std::vector<double>> trainHogwild(DataLoader<Dataset>& trainingDataset,
+                                                           DataLoader<Dataset>& testDataset,
+                                                           double lr, std::size_t epoch, LossAlgo&& lossAlgo,
+                                                           TestFn&& testFn){
+                if(!executionPlan){
+                    compile();
+                }
+                if(executionPlan->hasContext()){
+                    return {};
+                }
+                std::vector<std::vector<double>> data(3);
+                data[0].reserve(epoch);
+                data[1].reserve(epoch);
+                data[2].reserve(epoch);
+                Loss::Loss<LossAlgo> lossFn{std::forward<LossAlgo>(lossAlgo)};
+                auto numThreads = threadPool ? threadPool->size():1u;
+                auto numParameters = executionPlan->numConnections() + executionPlan->numNeurons();
+                auto parameters = std::make_unique<std::atomic<double>[]>(numParameters);
+                loadParameters(parameters.get());
+                auto trainable = trainableParameters();
+                std::vector<ExecutionPlan> plans(numThreads, *executionPlan);
+                for(auto& plan:plans){
+                    plan.setThreadPool(nullptr);
+                }
+                std::vector<double> losses(numThreads);
+                std::mutex datasetMutex;
+                for(auto e=0u;e<epoch;++e){
+                    std::cout << "[ Epoch " << (e+1) << "/" << epoch << " ]\n---------------------\n";
+                    auto samples = trainingDataset.size();
+                    auto batchSize = trainingDataset.getBatchSize();
+                    auto rate = lr / batchSize;
+                    auto nextBatch = 0u;
+                    std::fill(std::begin(losses), std::end(losses), 0.0);
+                    auto worker = [&](std::size_t task){
+                        auto& plan = plans[task];
+                        auto threadLossFn = lossFn;
+                        auto gradientOfSums = fusesSoftmax(threadLossFn);
+                        std::vector<double> batchInputs;
+                        std::vector<double> batchExpected;
+                        std::vector<double> batchOutputs;
+                        std::vector<double> gradientsLoss;
+                        std::vector<double> inputGradients;
+                        while(true){
+                            {
+                                std::lock_guard<std::mutex> lock(datasetMutex);
+                                if(nextBatch == samples){
+                                    break;
+                                }
+                                ++nextBatch;
+                                batchInputs.clear();
+                                batchExpected.clear();
+                                for(auto b=0u;b<batchSize;++b){
+                                    auto [inputs, expectedOutputs] = trainingDataset();
+                                    batchInputs.insert(std::end(batchInputs), std::begin(inputs), std::end(inputs));
+                                    batchExpected.insert(std::end(batchExpected), std::begin(expectedOutputs), std::end(expectedOutputs));
+                                }
+                            }
+                            plan.loadParameters(parameters.get());
+                            plan.forwardBatch(batchInputs, batchSize, batchOutputs);
+                            losses[task] += batchLoss(batchOutputs, batchExpected, threadLossFn, gradientsLoss, gradientOfSums);
+                            plan.backwardBatch(gradientsLoss, inputGradients, gradientOfSums);
+                            plan.applyGradients(parameters.get(), trainable, rate);
+                        }
+                    };
+                    if(threadPool){
+                        threadPool->run(numThreads, std::cref(worker));
+                    }else{
+                        worker(0u);
+                    }
+                    storeParameters(parameters.get());
+                    trainingDataset.shuffle();
+                    auto avgLoss = std::accumulate(std::begin(losses), std::end(losses), 0.0) / (samples * batchSize);
+                    std::cout << "\tavgLoss: " << avgLoss << std::endl;
                     auto [testAvgLoss, accuracy] = testFn(*this, testDataset);
                     testDataset.shuffle();
                     data[0].emplace_back(avgLoss);
@@ -163,6 +458,143 @@ namespace EvoAI{
                 }
                 return data;
             }
+            /**
+             * @brief Compiles the neural network into an ExecutionPlan, forward will run from it
+             * until the network topology is changed through NeuralNetwork member functions.
+             * @warning The plan is a snapshot, changes made directly to the layers, neurons or connections
+             * (like nn[0][0].setBiasWeight(...)) are not seen by the plan, call compile() again after them.
+             * @param mode ExecutionPlan::EvaluationMode how the neurons are evaluated, EDGE_MAJOR gives the same results as run().
+             * @return NeuralNetwork&
+             */
+            NeuralNetwork& compile(ExecutionPlan::EvaluationMode mode = ExecutionPlan::EvaluationMode::EDGE_MAJOR);
+            /**
+             * @brief drops the ExecutionPlan, forward will run through the layers again.
+             */
+            void decompile() noexcept;
+            /**
+             * @brief enables truncated backpropagation through time, the gradients of each step go back
+             * through the context neurons up to window steps, see ExecutionPlan::setTruncationWindow.
+             * @details The network is compiled with ExecutionPlan::EvaluationMode::NEURON_MAJOR. train then uses
+             *  backwardThroughTime and propagates the gradients before each Optimizer step, the samples are
+             *  one sequence so the DataLoader should not randomize them. resetContext starts a new sequence.
+             * @code
+             *     auto nn = EvoAI::createElmanNeuralNetwork(1, 1, {8}, 1, 1.0);
+             *     nn->setTruncationWindow(16);
+             *     EvoAI::DataLoader trainingDataset(EvoAI::Dataset(std::move(inputs), std::move(outputs), batchSize), false);
+             *     nn->train(trainingDataset, testDataset, optim, epochs, EvoAI::Loss::MeanSquaredError{}, testFn);
+             * @endcode
+             * @param window std::size_t steps, 0 disables it.
+             * @return bool false if the network can't run through time (its context neurons are not like an Elman network's).
+             */
+            bool setTruncationWindow(std::size_t window);
+            /**
+             * @brief getter for the truncation window, 0 if backpropagation through time is disabled.
+             * @return std::size_t
+             */
+            inline std::size_t getTruncationWindow() const noexcept{ return truncationWindow; }
+            /**
+             * @brief adds the loss gradients of the last forward, they go back through time on propagateThroughTime.
+             * @param gradientLoss const std::vector<double>&
+             * @return bool false if backpropagation through time is disabled or gradientLoss has the wrong size.
+             */
+            bool backwardThroughTime(const std::vector<double>& gradientLoss) noexcept;
+            /**
+             * @brief propagates the loss gradients given to backwardThroughTime and adds them to the parameters.
+             */
+            void propagateThroughTime() noexcept;
+            /**
+             * @brief checks if the neural network has an ExecutionPlan.
+             * @return bool
+             */
+            inline bool isCompiled() const noexcept{ return executionPlan.has_value(); }
+            /**
+             * @brief getter for the ExecutionPlan
+             * @warning check isCompiled() before calling it.
+             * @return ExecutionPlan&
+             */
+            inline ExecutionPlan& getExecutionPlan() noexcept{ return *executionPlan; }
+            /**
+             * @brief getter for the ExecutionPlan
+             * @warning check isCompiled() before calling it.
+             * @return const ExecutionPlan&
+             */
+            inline const ExecutionPlan& getExecutionPlan() const noexcept{ return *executionPlan; }
+            /**
+             * @brief approximates sigmoid, tanh, gaussian, sinusoid and cosine with an Activations::LookupTable,
+             * it is also used by the ExecutionPlan. The table can be shared with other networks.
+             * @code
+             *     auto table = std::make_shared<EvoAI::Activations::LookupTable>(1e-4); // max error
+             *     nn.setActivationTable(table);
+             *     nn.setActivationTable(nullptr); // back to the exact activations
+             * @endcode
+             * @param table std::shared_ptr<const Activations::LookupTable> nullptr uses the exact activations.
+             * @return NeuralNetwork&
+             */
+            NeuralNetwork& setActivationTable(std::shared_ptr<const Activations::LookupTable> table) noexcept;
+            /**
+             * @brief sets the ThreadPool used by the ExecutionPlan to run the levels of the network in parallel,
+             * see ExecutionPlan::setThreadPool. The pool can be shared with other networks.
+             * @code
+             *     auto pool = std::make_shared<EvoAI::ThreadPool>(4);
+             *     nn.setThreadPool(pool);
+             *     nn.compile(EvoAI::ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+             * @endcode
+             * @param pool std::shared_ptr<ThreadPool> nullptr runs on the calling thread.
+             * @return NeuralNetwork&
+             */
+            NeuralNetwork& setThreadPool(std::shared_ptr<ThreadPool> pool) noexcept;
+            /**
+             * @brief getter for the ThreadPool, nullptr if the network runs on the calling thread.
+             * @return const std::shared_ptr<ThreadPool>&
+             */
+            inline const std::shared_ptr<ThreadPool>& getThreadPool() const noexcept{ return threadPool; }
+            /**
+             * @brief sets a TrainingProfiler that train fills with the time of each phase per epoch.
+             * @param profiler std::shared_ptr<TrainingProfiler> nullptr disables the instrumentation.
+             * @return NeuralNetwork&
+             */
+            NeuralNetwork& setProfiler(std::shared_ptr<TrainingProfiler> profiler) noexcept;
+            /**
+             * @brief getter for the TrainingProfiler, nullptr if train isn't instrumented.
+             * @return const std::shared_ptr<TrainingProfiler>&
+             */
+            inline const std::shared_ptr<TrainingProfiler>& getProfiler() const noexcept{ return profiler; }
+            /**
+             * @brief runs the testFn of train in a background thread while the next epoch trains.
+             * @details The test runs on a copy of the network with the weights of the epoch, compiled like this one
+             *  and sharing its ThreadPool. The testDataset is used by the background thread, it can't be the trainingDataset.
+             *  The TrainingProfiler::Phase::TEST time is then the time train waits for the test and copies the weights.
+             * @param async bool
+             * @return NeuralNetwork&
+             */
+            NeuralNetwork& setAsyncTest(bool async) noexcept;
+            /**
+             * @brief checks if train runs the testFn in a background thread.
+             * @return bool
+             */
+            inline bool isAsyncTest() const noexcept{ return asyncTest; }
+            /**
+             * @brief sets a callback that train calls with the results of each epoch, like for early stopping.
+             * @details once it returns false it is not called again by that train call, see train for the asynchronous test.
+             * @code
+             *     // stops after 5 epochs without improving the test loss.
+             *     nn.setEpochCallback([best = std::numeric_limits<double>::max(), patience = 5](std::size_t, double, double testAvgLoss, double) mutable{
+             *         if(testAvgLoss < best){
+             *             best = testAvgLoss;
+             *             patience = 5;
+             *         }
+             *         return --patience > 0;
+             *     });
+             * @endcode
+             * @param callback EpochCallback empty to remove it.
+             * @return NeuralNetwork&
+             */
+            NeuralNetwork& setEpochCallback(EpochCallback callback) noexcept;
+            /**
+             * @brief getter for the Activations::LookupTable, nullptr if the activations are exact.
+             * @return const std::shared_ptr<const Activations::LookupTable>&
+             */
+            inline const std::shared_ptr<const Activations::LookupTable>& getActivationTable() const noexcept{ return activationTable; }
             /**
              * @brief Sets the neural network layers.
              * @return NeuralNetwork&
@@ -205,6 +637,13 @@ namespace EvoAI{
              * @return bool
              */
             bool setInputs(const std::vector<double>& ins) noexcept;
+            /**
+             * @brief sets the inputs returns true if succeeded, false if it failed.
+             * @param ins const double*
+             * @param size std::size_t
+             * @return bool
+             */
+            bool setInputs(const double* ins, std::size_t size) noexcept;
             /**
              * @brief Adds a Connection
              * @param c const Connection&
@@ -267,6 +706,16 @@ namespace EvoAI{
              * @brief resets the neurons that are Neuron::Type::CONTEXT
              */
             void resetContext();
+            /**
+             * @brief resets the neurons of the state that are not Neuron::Type::CONTEXT
+             * @param state InferenceState&
+             */
+            void reset(InferenceState& state) const noexcept;
+            /**
+             * @brief resets all the neurons of the state, including Neuron::Type::CONTEXT
+             * @param state InferenceState&
+             */
+            void resetContext(InferenceState& state) const noexcept;
             /**
              * @brief resets the gradients of the connections
              */
@@ -287,6 +736,21 @@ namespace EvoAI{
              * @return bool
              */
             bool writeDotFile(const std::string& filename) noexcept;
+            /**
+             * @brief writes a standalone C++ header that runs this network without EvoAI, see generateCpp.
+             * @code
+             *      champion.exportCpp("champion.hpp", "champion");
+             *      // in the simulation
+             *      #include "champion.hpp"
+             *      double outputs[champion::numOutputs];
+             *      std::array<double, champion::contextSize> context{};
+             *      champion::forward(inputs, outputs, context.data());
+             * @endcode
+             * @param filename const std::string&
+             * @param name const std::string& namespace of the generated code, it must be a valid C++ identifier.
+             * @return bool false if name is not valid or the file could not be written.
+             */
+            bool exportCpp(const std::string& filename, const std::string& name = "evoai");
             /**
              * @brief clears the Neural Network.
              */
@@ -328,6 +792,20 @@ namespace EvoAI{
             bool operator==(const NeuralNetwork& rhs) const;
             ~NeuralNetwork() = default;
         private:
+            /**
+             * @brief row-major [batchSize x size] buffers of trainBatch, kept by train between batches.
+             */
+            struct BatchBuffers{
+                std::vector<double> inputs;
+                std::vector<double> expected;
+                std::vector<double> outputs;
+                std::vector<double> gradientsLoss;
+                std::vector<double> inputGradients;
+            };
+            /**
+             * @brief runs the connections and activates the output layer, the outputs are left in the neurons.
+             */
+            void process();
             /**
              * @brief Applies the neuron activation
              * @param at Neuron::ActivationType
@@ -342,12 +820,163 @@ namespace EvoAI{
              * @return double
              */
             double derivate(Neuron::ActivationType at,const Neuron& n);
+            /**
+             * @brief runs a batch of the dataset through forwardBatch and backwardBatch.
+             * @tparam LossFn Loss::Loss<LossAlgo>
+             * @tparam Dataset dataset for training
+             * @param trainingDataset DataLoader<Dataset>&
+             * @param lossFn LossFn&
+             * @param batchSize std::size_t
+             * @param bound bool true if the optimizer is bound to the ExecutionPlan, the gradients stay in the plan then.
+             * @param buffers BatchBuffers& reused between batches.
+             * @param watch TrainingProfiler::Stopwatch& measures the phases of the batch.
+             * @return double total loss of the batch
+             */
+            template<typename LossFn, class Dataset>
+            double trainBatch(DataLoader<Dataset>& trainingDataset, LossFn& lossFn, std::size_t batchSize, bool bound,
+                              BatchBuffers& buffers, TrainingProfiler::Stopwatch& watch){
+                auto gradientOfSums = fusesSoftmax(lossFn);
+                buffers.inputs.clear();
+                buffers.expected.clear();
+                for(auto b=0u;b<batchSize;++b){
+                    auto [inputs, expectedOutputs] = trainingDataset();
+                    buffers.inputs.insert(std::end(buffers.inputs), std::begin(inputs), std::end(inputs));
+                    buffers.expected.insert(std::end(buffers.expected), std::begin(expectedOutputs), std::end(expectedOutputs));
+                }
+                watch.lap(TrainingProfiler::Phase::DATA_LOADING, batchSize);
+                executionPlan->forwardBatch(buffers.inputs, batchSize, buffers.outputs);
+                watch.lap(TrainingProfiler::Phase::FORWARD);
+                auto totalBatchLoss = batchLoss(buffers.outputs, buffers.expected, lossFn, buffers.gradientsLoss, gradientOfSums);
+                watch.lap(TrainingProfiler::Phase::LOSS, batchSize);
+                executionPlan->backwardBatch(buffers.gradientsLoss, buffers.inputGradients, gradientOfSums);
+                if(!bound){
+                    executionPlan->writeGradients(*this);
+                }
+                watch.lap(TrainingProfiler::Phase::BACKWARD);
+                return totalBatchLoss;
+            }
+            /**
+             * @brief binds the ParameterBuffer of the algorithm of optim to the ExecutionPlan, see ExecutionPlan::bindParameters.
+             * @tparam Optim configured Optimizer
+             * @param optim Optim&
+             * @return bool false if the algorithm has no ParameterBuffer or its parameters can't be bound,
+             * it updates the connections then.
+             */
+            template<typename Optim>
+            bool bindParameters(Optim& optim) noexcept{
+                if constexpr(meta::has_parameter_buffer_v<Optim>){
+                    return executionPlan && executionPlan->bindParameters(*this, optim.getAlgo().getParameterBuffer());
+                }else{
+                    return false;
+                }
+            }
+            /**
+             * @brief unbinds the ParameterBuffer of the algorithm of optim and copies the weights of the ExecutionPlan to the connections.
+             * @tparam Optim configured Optimizer
+             * @param optim Optim&
+             */
+            template<typename Optim>
+            void unbindParameters(Optim& optim) noexcept{
+                if constexpr(meta::has_parameter_buffer_v<Optim>){
+                    auto& params = optim.getAlgo().getParameterBuffer();
+                    if(params.isBound()){
+                        params.unbind();
+                        executionPlan->writeWeights(*this);
+                    }
+                }
+            }
+            /**
+             * @brief checks if the loss is fused with the softmax of the output layer, see Loss::MultiClassCrossEntropy::softmaxLossAndGrad.
+             * @tparam LossFn Loss::Loss<LossAlgo>
+             * @return bool
+             */
+            template<typename LossFn>
+            bool fusesSoftmax([[maybe_unused]] const LossFn& lossFn) const noexcept{
+                if constexpr(LossFn::FusesSoftmax){
+                    return layers.back().getActivationType() == Neuron::ActivationType::SOFTMAX;
+                }
+                return false;
+            }
+            /**
+             * @brief calculates the loss of a sample and its gradients in one pass.
+             * @tparam LossFn Loss::Loss<LossAlgo>
+             * @param expectedOutputs const double*
+             * @param outputs const double*
+             * @param gradients double* outputs values
+             * @param lossFn LossFn&
+             * @param gradientOfSums bool uses the fused softmax, see fusesSoftmax.
+             * @return double loss of the sample
+             */
+            template<typename LossFn>
+            double sampleLoss(const double* expectedOutputs, const double* outputs, double* gradients, LossFn& lossFn,
+                              [[maybe_unused]] bool gradientOfSums) noexcept{
+                auto numOutputs = layers.back().size();
+                if constexpr(LossFn::FusesSoftmax){
+                    if(gradientOfSums){
+                        return lossFn.softmaxLossAndGrad(expectedOutputs, outputs, gradients, numOutputs);
+                    }
+                }
+                return lossFn.lossAndGrad(expectedOutputs, outputs, gradients, numOutputs);
+            }
+            /**
+             * @brief calculates the loss of each sample of a batch and its gradients.
+             * @tparam LossFn Loss::Loss<LossAlgo>
+             * @param batchOutputs const std::vector<double>& row-major [batchSize x outputs]
+             * @param batchExpected const std::vector<double>& row-major [batchSize x outputs] expected outputs
+             * @param lossFn LossFn&
+             * @param gradientsLoss std::vector<double>& row-major [batchSize x outputs] gradients of the loss
+             * @param gradientOfSums bool uses the fused softmax, see fusesSoftmax.
+             * @return double total loss of the batch
+             */
+            template<typename LossFn>
+            double batchLoss(const std::vector<double>& batchOutputs, const std::vector<double>& batchExpected,
+                             LossFn& lossFn, std::vector<double>& gradientsLoss, bool gradientOfSums){
+                auto numOutputs = layers.back().size();
+                gradientsLoss.resize(batchExpected.size());
+                auto totalBatchLoss = 0.0;
+                for(auto i=0u;i<batchExpected.size();i+=numOutputs){
+                    totalBatchLoss += sampleLoss(&batchExpected[i], &batchOutputs[i], &gradientsLoss[i], lossFn, gradientOfSums);
+                }
+                return totalBatchLoss;
+            }
+            /**
+             * @brief copies the weights and biases of the ExecutionPlan into parameters like ExecutionPlan::loadParameters reads them.
+             * @param parameters std::atomic<double>*
+             */
+            void loadParameters(std::atomic<double>* parameters) noexcept;
+            /**
+             * @brief sets the weights and biases of the connections and neurons from parameters and updates the ExecutionPlan.
+             * @param parameters const std::atomic<double>*
+             */
+            void storeParameters(const std::atomic<double>* parameters) noexcept;
+            /**
+             * @brief makes a copy of the network to run tests on, compiled like this one.
+             * @return std::unique_ptr<NeuralNetwork>
+             */
+            std::unique_ptr<NeuralNetwork> makeSnapshot() const;
+            /**
+             * @brief copies the weights and biases to a network made by makeSnapshot.
+             * @param snapshot NeuralNetwork&
+             */
+            void copyParametersTo(NeuralNetwork& snapshot) noexcept;
+            /**
+             * @brief indices of the parameters of the ExecutionPlan that SGD would update (not frozen nor recurrent).
+             * @return std::vector<std::uint32_t>
+             */
+            std::vector<std::uint32_t> trainableParameters() noexcept;
         private:
             std::vector<NeuronLayer> layers;
             mutable std::vector<Connection*> connections;
             mutable std::vector<Neuron*> neurons;
             mutable bool connectionsCached;
             mutable bool neuronsCached;
+            std::optional<ExecutionPlan> executionPlan;
+            std::shared_ptr<const Activations::LookupTable> activationTable;
+            std::shared_ptr<ThreadPool> threadPool;
+            std::shared_ptr<TrainingProfiler> profiler;
+            EpochCallback epochCallback;
+            bool asyncTest;
+            std::size_t truncationWindow;
             std::uint64_t globalStep;
             double lastAvgLoss;
     };
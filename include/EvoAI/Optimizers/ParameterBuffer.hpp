@@ -0,0 +1,144 @@
+#ifndef EVOAI_OPTIMIZERS_PARAMETER_BUFFER_HPP
+#define EVOAI_OPTIMIZERS_PARAMETER_BUFFER_HPP
+
+#include <EvoAI/Export.hpp>
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace EvoAI{
+    class Connection;
+    class ThreadPool;
+    /**
+     * @brief weights and gradients of the parameters of an optimizer in contiguous arrays (structure of arrays).
+     * @details The optimizer updates them in plain loops that the compiler can vectorize and a ThreadPool can split.
+     *  Bound to the arrays of an ExecutionPlan (see ExecutionPlan::bindParameters) the loops run over the plan
+     *  in place and the connections are not touched, otherwise update copies the weight and gradient of each
+     *  Connection into its own arrays and writes them back.
+     * @code
+     *      ParameterBuffer params(nn.getParameters());
+     *      params.update([&](std::size_t begin, std::size_t end, double* weights, double* gradients){
+     *          for(auto i=0u;i<end - begin;++i){
+     *              weights[i] -= lr * gradients[i];
+     *          }
+     *      });
+     * @endcode
+     */
+    class EvoAI_API ParameterBuffer final{
+        public:
+            /**
+             * @brief kernel(begin, end, weights, gradients) updates the parameters [begin, end),
+             * weights[0] and gradients[0] are the ones of the parameter begin.
+             */
+            using Chunk = std::function<void(std::size_t, std::size_t, double*, double*)>;
+            /**
+             * @brief parameters [begin, begin + size) stored contiguously in weights and gradients.
+             */
+            struct Segment{
+                std::size_t begin;
+                std::size_t size;
+                double* weights;
+                double* gradients;
+            };
+            /**
+             * @brief default minimum of parameters of each task when it runs with a ThreadPool.
+             */
+            static constexpr std::size_t DefaultMinParameters = 16384u;
+            /**
+             * @brief parameters copied, updated and written back at once.
+             */
+            static constexpr std::size_t BlockSize = 256u;
+        public:
+            /**
+             * @brief constructor, recurrent connections are masked so the optimizers keep the context neurons with weight 1.0.
+             * @param parameters std::vector<Connection*>
+             */
+            explicit ParameterBuffer(std::vector<Connection*>&& parameters);
+            /**
+             * @brief updates the parameters, bound it calls kernel over each Segment, otherwise it copies the weights
+             * and gradients of a block from the connections, calls kernel and writes them back,
+             * so the block is still in cache when it's written.
+             * @details With a ThreadPool the parameters are split in ranges of at least minParameters, one per thread.
+             * @param kernel const Chunk&
+             */
+            void update(const Chunk& kernel) noexcept;
+            /**
+             * @brief resets the gradients to 0.0, the ones of the Segments if it's bound.
+             */
+            void zeroGrad() noexcept;
+            /**
+             * @brief updates the parameters in place in segments until unbind is called, the connections are not read or written.
+             * @warning the arrays of the segments must outlive the binding.
+             * @param segments std::vector<Segment>&& in order, covering [0, size()).
+             * @return bool false if the segments don't cover the parameters, it stays unbound then.
+             */
+            bool bind(std::vector<Segment>&& segments) noexcept;
+            /**
+             * @brief goes back to read and write the connections.
+             */
+            void unbind() noexcept;
+            /**
+             * @brief checks if it updates the segments given to bind.
+             * @return bool
+             */
+            inline bool isBound() const noexcept{ return !m_segments.empty(); }
+            /**
+             * @brief sets a ThreadPool to split the updates.
+             * @param pool std::shared_ptr<ThreadPool> nullptr runs on the calling thread.
+             * @param minParameters std::size_t
+             */
+            void setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minParameters = DefaultMinParameters) noexcept;
+            /**
+             * @brief getter for the ThreadPool, nullptr if it runs on the calling thread.
+             * @return const std::shared_ptr<ThreadPool>&
+             */
+            inline const std::shared_ptr<ThreadPool>& getThreadPool() const noexcept{ return m_threadPool; }
+            /**
+             * @brief 1 for the parameters the optimizers update, 0 for recurrent connections.
+             * @return const std::uint8_t*
+             */
+            inline const std::uint8_t* trainable() const noexcept{ return m_trainable.data(); }
+            /**
+             * @brief number of parameters.
+             * @return std::size_t
+             */
+            inline std::size_t size() const noexcept{ return m_params.size(); }
+            /**
+             * @brief getter for the connections.
+             * @return const std::vector<Connection*>&
+             */
+            inline const std::vector<Connection*>& getParameters() const noexcept{ return m_params; }
+        private:
+            /**
+             * @brief calls kernel over the parameters [begin, end).
+             * @param kernel const Chunk&
+             * @param begin std::size_t
+             * @param end std::size_t
+             */
+            void updateRange(const Chunk& kernel, std::size_t begin, std::size_t end) noexcept;
+            /**
+             * @brief copies the weights and gradients of the connections [begin, end) into the arrays.
+             * @param begin std::size_t
+             * @param end std::size_t
+             */
+            void gather(std::size_t begin, std::size_t end) noexcept;
+            /**
+             * @brief writes the weights and gradients [begin, end) of the arrays back into the connections.
+             * @param begin std::size_t
+             * @param end std::size_t
+             */
+            void scatter(std::size_t begin, std::size_t end) noexcept;
+        private:
+            std::vector<Connection*> m_params;
+            std::vector<double> m_weights;
+            std::vector<double> m_gradients;
+            std::vector<std::uint8_t> m_trainable;
+            std::vector<Segment> m_segments;
+            std::shared_ptr<ThreadPool> m_threadPool;
+            std::size_t m_minParameters;
+    };
+}
+
+#endif //EVOAI_OPTIMIZERS_PARAMETER_BUFFER_HPP
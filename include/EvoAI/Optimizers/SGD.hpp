@@ -2,12 +2,14 @@
 #define EVOAI_OPTIMIZERS_SGD_HPP
 
 #include <EvoAI/Export.hpp>
+#include <EvoAI/Optimizers/ParameterBuffer.hpp>
 #include <JsonBox.h>
 
 namespace EvoAI{
     class Connection;
-    /** @todo impl parallelism for updating weights?
+    /**
      * @brief Stochastic Gradient Descend Algorithm
+     * @details The weights and gradients are updated in contiguous arrays, see ParameterBuffer.
      */
     struct EvoAI_API SGD final{
         /**
@@ -40,11 +42,22 @@ namespace EvoAI{
          * @brief resets the gradients to 0.0.
          */
         void zeroGrad() noexcept;
+        /**
+         * @brief sets a ThreadPool to split the updates of the parameters, see ParameterBuffer::setThreadPool.
+         * @param pool std::shared_ptr<ThreadPool> nullptr runs on the calling thread.
+         * @param minParameters std::size_t minimum of parameters of each task.
+         */
+        void setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minParameters = ParameterBuffer::DefaultMinParameters) noexcept;
+        /**
+         * @brief getter for the ParameterBuffer, NeuralNetwork::train binds it to its ExecutionPlan.
+         * @return ParameterBuffer&
+         */
+        inline ParameterBuffer& getParameterBuffer() noexcept{ return m_params; }
         // data
         bool m_nesterov;
         bool m_maximize;
         bool m_accumGradients;
-        std::vector<Connection*> m_params;
+        ParameterBuffer m_params;
         std::vector<double> m_momentumWeights;
         std::vector<double> m_velocityWeights;
     };
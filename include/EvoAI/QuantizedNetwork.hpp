@@ -0,0 +1,152 @@
+#ifndef EVOAI_QUANTIZED_NETWORK_HPP
+#define EVOAI_QUANTIZED_NETWORK_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include <EvoAI/ExecutionPlan.hpp>
+#include <EvoAI/Export.hpp>
+
+namespace EvoAI{
+    class NeuralNetwork;
+    /**
+     * @class QuantizedNetwork
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file QuantizedNetwork.hpp
+     * @brief An inference only version of a NeuralNetwork with int8 weights and int32 accumulators.
+     * @details
+     *  Each neuron output is quantized to int8 with its own scale, calibrated from the largest
+     *  output seen while running the calibration data. The weights are multiplied by the scale of their
+     *  source and quantized to int8 with one scale per destination neuron, so the weighted sum of a neuron
+     *  is an int32 accumulator times one scale. Biases, activations and the values stored by
+     *  Neuron::Type::CONTEXT neurons stay in floating point.
+     *
+     *  The network runs the connections in the same order as ExecutionPlan with the same PlanEvaluationMode,
+     *  so it works for any topology, including recurrent NEAT phenotypes. PlanEvaluationMode::NEURON_MAJOR
+     *  activates each neuron once and is faster, but it only gives the same outputs as NeuralNetwork::run
+     *  in the cases explained in PlanEvaluationMode.
+     * @code
+     *      auto nn = EvoAI::createFeedForwardNN(2, 1, {5}, 1, 1.0);
+     *      auto qnn = EvoAI::quantize(*nn, calibrationInputs);
+     *      auto out = qnn.forward({0.5, 1.0});
+     *      qnn.reset();
+     * @endcode
+     */
+    class EvoAI_API QuantizedNetwork final{
+        public:
+            /**
+             * @brief default constructor, empty network.
+             */
+            QuantizedNetwork();
+            /**
+             * @brief quantizes the NeuralNetwork using calibrationData to choose the scales.
+             * @param nn NeuralNetwork&
+             * @param calibrationData const std::vector<std::vector<double>>& inputs representative of the ones it will see.
+             * @param mode PlanEvaluationMode
+             */
+            QuantizedNetwork(NeuralNetwork& nn, const std::vector<std::vector<double>>& calibrationData,
+                                PlanEvaluationMode mode = PlanEvaluationMode::EDGE_MAJOR);
+            /**
+             * @brief runs the network.
+             * @param inputs const std::vector<double>&
+             * @return std::vector<double> outputs, empty if inputs has the wrong size.
+             */
+            std::vector<double> forward(const std::vector<double>& inputs) noexcept;
+            /**
+             * @brief resets the neurons that are not Neuron::Type::CONTEXT
+             */
+            void reset() noexcept;
+            /**
+             * @brief resets all the neurons, including Neuron::Type::CONTEXT
+             */
+            void resetContext() noexcept;
+            /**
+             * @brief getter for the PlanEvaluationMode
+             * @return PlanEvaluationMode
+             */
+            inline PlanEvaluationMode getEvaluationMode() const noexcept{ return m_mode; }
+            /**
+             * @brief number of inputs
+             * @return std::size_t
+             */
+            inline std::size_t numInputs() const noexcept{ return m_numInputs; }
+            /**
+             * @brief number of outputs
+             * @return std::size_t
+             */
+            inline std::size_t numOutputs() const noexcept{ return m_types.size() - m_outputBegin; }
+            /**
+             * @brief number of connections
+             * @return std::size_t
+             */
+            inline std::size_t numConnections() const noexcept{ return m_weights.size(); }
+            /**
+             * @brief int8 weights in the order of ExecutionPlan::getWeights.
+             * @return const std::vector<std::int8_t>&
+             */
+            inline const std::vector<std::int8_t>& getWeights() const noexcept{ return m_weights; }
+            /**
+             * @brief scale of the output of each neuron.
+             * @return const std::vector<float>&
+             */
+            inline const std::vector<float>& getOutputScales() const noexcept{ return m_outputScales; }
+            /**
+             * @brief bytes used by the network.
+             * @return std::size_t
+             */
+            std::size_t memoryUsage() const noexcept;
+        private:
+            /**
+             * @brief Engine that runs the network in double precision and records the largest outputs.
+             */
+            struct Calibration;
+            /**
+             * @brief Engine that runs the network with the int8 weights.
+             */
+            struct Inference;
+            /**
+             * @brief runs the connections in the order of the ExecutionPlan.
+             * @tparam Engine Engine::sum(n), Engine::setSum(n, v), Engine::addSum(n, v),
+             * Engine::value(n, output) and Engine::send(value, c), see QuantizedNetwork.cpp
+             * @param engine Engine&
+             */
+            template<typename Engine>
+            void run(Engine& engine) noexcept;
+            /**
+             * @brief real sum of neuron n.
+             * @param n std::uint32_t
+             * @return double
+             */
+            inline double sum(std::uint32_t n) const noexcept{
+                return m_sums[n] + static_cast<double>(m_accumulators[n]) * m_sumScales[n];
+            }
+        private:
+            std::vector<std::uint32_t> m_order;
+            std::vector<std::uint32_t> m_rowPtr;
+            std::vector<std::uint32_t> m_dest;
+            std::vector<Neuron::Type> m_types;
+            std::vector<Neuron::ActivationType> m_activations;
+            std::vector<float> m_biases;
+            std::vector<std::int8_t> m_weights;
+            std::vector<float> m_sumScales;
+            std::vector<float> m_outputScales;
+            std::vector<float> m_invOutputScales;
+            std::vector<std::int32_t> m_accumulators;
+            std::vector<float> m_sums;
+            std::size_t m_numInputs;
+            std::size_t m_outputBegin;
+            PlanEvaluationMode m_mode;
+            bool m_softmax;
+    };
+    /**
+     * @brief quantizes the NeuralNetwork to int8 weights for inference, see QuantizedNetwork.
+     * @param nn NeuralNetwork&
+     * @param calibrationData const std::vector<std::vector<double>>& inputs representative of the ones it will see.
+     * @param mode PlanEvaluationMode
+     * @return QuantizedNetwork
+     */
+    EvoAI_API QuantizedNetwork quantize(NeuralNetwork& nn, const std::vector<std::vector<double>>& calibrationData,
+                                            PlanEvaluationMode mode = PlanEvaluationMode::EDGE_MAJOR);
+}
+
+#endif // EVOAI_QUANTIZED_NETWORK_HPP
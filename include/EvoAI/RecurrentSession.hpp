@@ -0,0 +1,86 @@
+#ifndef EVOAI_RECURRENT_SESSION_HPP
+#define EVOAI_RECURRENT_SESSION_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include <EvoAI/Export.hpp>
+#include <EvoAI/NeuralNetwork.hpp>
+#include <EvoAI/ExecutionPlan.hpp>
+
+namespace EvoAI{
+    /**
+     * @class RecurrentSession
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file RecurrentSession.hpp
+     * @brief Runs many independent sequences through one recurrent NeuralNetwork in lockstep.
+     * @details The Neuron::Type::CONTEXT memory of each sequence is kept in the session (a BatchState lane),
+     *  the weights are read from the ExecutionPlan of the network so they are shared by all the sequences
+     *  and any change made through the plan (training, Optimizer::step) is seen by the next step.
+     *  Each step is like nn.forward(inputs) followed by nn.reset() on its own copy of the network.
+     * @code
+     *      auto nn = EvoAI::createElmanNeuralNetwork(4, 1, {16}, 2, 1.0);
+     *      EvoAI::RecurrentSession session(*nn, 256); // 256 episodes
+     *      std::vector<double> observations(256 * 4);
+     *      std::vector<double> actions(256 * 2);
+     *      while(...){
+     *          session.step(observations.data(), observations.size(), actions.data(), actions.size());
+     *          // ...
+     *          if(episodeEnded){
+     *              session.resetSequence(episode);
+     *          }
+     *      }
+     * @endcode
+     * @warning the network must outlive the session and it must not be decompiled or recompiled while
+     *  the session is used, make a new session after that.
+     */
+    class EvoAI_API RecurrentSession final{
+        public:
+            /**
+             * @brief makes a session of numSequences sequences that start from the current state of the network.
+             * @param nn NeuralNetwork& it is compiled if it isn't.
+             * @param numSequences std::size_t
+             */
+            RecurrentSession(NeuralNetwork& nn, std::size_t numSequences);
+            /**
+             * @brief runs one step of every sequence.
+             * @param inputs const std::vector<double>& row-major [numSequences x numInputs]
+             * @return std::vector<double> row-major [numSequences x numOutputs], empty if inputs has the wrong size.
+             */
+            std::vector<double> step(const std::vector<double>& inputs);
+            /**
+             * @brief runs one step of every sequence into a buffer of the caller, it doesn't allocate.
+             * @param inputs const double* row-major [numSequences x numInputs]
+             * @param inputSize std::size_t
+             * @param outputs double* row-major [numSequences x numOutputs]
+             * @param outputSize std::size_t
+             * @return bool false if the sizes are wrong or the network is not compiled.
+             */
+            bool step(const double* inputs, std::size_t inputSize, double* outputs, std::size_t outputSize) noexcept;
+            /**
+             * @brief clears the memory of one sequence so it starts again, like resetContext and resetConnections
+             * on its own copy of the network.
+             * @param sequence std::size_t
+             */
+            void resetSequence(std::size_t sequence) noexcept;
+            /**
+             * @brief clears the memory of all the sequences.
+             */
+            void resetContext() noexcept;
+            /**
+             * @brief number of sequences run by each step.
+             * @return std::size_t
+             */
+            inline std::size_t numSequences() const noexcept{ return m_state.batchSize; }
+            /**
+             * @brief state of the sequences, the lanes of a neuron are contiguous.
+             * @return const BatchState&
+             */
+            inline const BatchState& getState() const noexcept{ return m_state; }
+        private:
+            NeuralNetwork* m_nn;
+            BatchState m_state;
+    };
+}
+
+#endif // EVOAI_RECURRENT_SESSION_HPP
@@ -0,0 +1,176 @@
+#ifndef EVOAI_STATIC_NETWORK_HPP
+#define EVOAI_STATIC_NETWORK_HPP
+
+#include <array>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#include <EvoAI/Activations.hpp>
+#include <EvoAI/NeuralNetwork.hpp>
+#include <EvoAI/ExecutionPlan.hpp>
+#include <EvoAI/Export.hpp>
+#include <JsonBox.h>
+
+namespace EvoAI{
+    /**
+     * @class BasicStaticNetwork
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file StaticNetwork.hpp
+     * @brief A fully connected feedforward network with its shape fixed at compile time.
+     * @details
+     *  Layers are the sizes of the input layer, the hidden layers and the output layer, the weights and biases
+     *  are kept in std::array and forward runs on the stack, so it does not allocate. The sizes are constexpr,
+     *  letting the compiler unroll and vectorize the loops of each layer.
+     *  It can be made from a NeuralNetwork with the same shape (like the ones from createFeedForwardNN)
+     *  where every hidden and output neuron uses Activation, and it can be exported back to a NeuralNetwork or json.
+     *  Mode is evaluated like in ExecutionPlan, PlanEvaluationMode::EDGE_MAJOR gives the same outputs as
+     *  NeuralNetwork::forward and PlanEvaluationMode::NEURON_MAJOR activates each neuron once.
+     *  When Activation is Neuron::ActivationType::SOFTMAX the neurons are not activated and softmax is applied to the outputs.
+     * @code
+     *      auto nn = EvoAI::createFeedForwardNN(8, 1, {16}, 4, 1.0);
+     *      EvoAI::StaticNetwork<EvoAI::Neuron::ActivationType::SIGMOID, 8, 16, 4> brain(*nn);
+     *      auto out = brain.forward({0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8});
+     * @endcode
+     * @tparam Mode PlanEvaluationMode
+     * @tparam Activation Neuron::ActivationType of the hidden and output neurons.
+     * @tparam Layers std::size_t... at least the inputs and the outputs.
+     */
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    class BasicStaticNetwork final{
+        static_assert(sizeof...(Layers) >= 2, "a StaticNetwork needs at least an input and an output layer.");
+        public:
+            static constexpr std::array<std::size_t, sizeof...(Layers)> layerSizes{Layers...};
+            static constexpr std::size_t numLayers = sizeof...(Layers);
+            static constexpr std::size_t numInputs = layerSizes[0];
+            static constexpr std::size_t numOutputs = layerSizes[numLayers - 1];
+            /**
+             * @brief number of connections, each layer is fully connected to the next.
+             * @return std::size_t
+             */
+            static constexpr std::size_t numConnections() noexcept;
+            /**
+             * @brief number of hidden and output neurons, the input neurons do not use their bias.
+             * @return std::size_t
+             */
+            static constexpr std::size_t numBiases() noexcept;
+            using Inputs = std::array<double, numInputs>;
+            using Outputs = std::array<double, numOutputs>;
+            using Weights = std::array<double, numConnections()>;
+            using Biases = std::array<double, numBiases()>;
+        public:
+            /**
+             * @brief default constructor, all the weights and biases are 0.0
+             */
+            BasicStaticNetwork() noexcept;
+            /**
+             * @brief makes it from a NeuralNetwork with the same shape.
+             * @param nn NeuralNetwork&
+             * @throw std::invalid_argument if nn is not fully connected layer to layer with this shape and Activation.
+             */
+            explicit BasicStaticNetwork(NeuralNetwork& nn);
+            /**
+             * @brief makes it from the json of a NeuralNetwork.
+             * @param o JsonBox::Object
+             * @throw std::invalid_argument like BasicStaticNetwork(NeuralNetwork&)
+             */
+            explicit BasicStaticNetwork(JsonBox::Object o);
+            /**
+             * @brief loads it from a NeuralNetwork json file.
+             * @param filename const std::string&
+             * @throw std::invalid_argument like BasicStaticNetwork(NeuralNetwork&)
+             */
+            explicit BasicStaticNetwork(const std::string& filename);
+            /**
+             * @brief runs the network.
+             * @param inputs const Inputs&
+             * @return Outputs
+             */
+            Outputs forward(const Inputs& inputs) const noexcept;
+            /**
+             * @brief runs the network.
+             * @param inputs const double* numInputs values
+             * @param outputs double* numOutputs values
+             */
+            void forward(const double* inputs, double* outputs) const noexcept;
+            /**
+             * @brief weights, the connections of each layer are stored row by row [source x destination].
+             * @return Weights&
+             */
+            inline Weights& getWeights() noexcept{ return m_weights; }
+            /**
+             * @brief weights, the connections of each layer are stored row by row [source x destination].
+             * @return const Weights&
+             */
+            inline const Weights& getWeights() const noexcept{ return m_weights; }
+            /**
+             * @brief biases of the hidden and output neurons, layer by layer.
+             * @return Biases&
+             */
+            inline Biases& getBiases() noexcept{ return m_biases; }
+            /**
+             * @brief biases of the hidden and output neurons, layer by layer.
+             * @return const Biases&
+             */
+            inline const Biases& getBiases() const noexcept{ return m_biases; }
+            /**
+             * @brief makes a NeuralNetwork with the same shape, weights and biases.
+             * @return NeuralNetwork
+             */
+            NeuralNetwork toNeuralNetwork() const;
+            /**
+             * @brief returns the json of toNeuralNetwork.
+             * @return JsonBox::Value
+             */
+            JsonBox::Value toJson() const;
+            /**
+             * @brief writes the json of toNeuralNetwork to a file.
+             * @param filename const std::string&
+             */
+            void writeToFile(const std::string& filename) const;
+        private:
+            /**
+             * @brief first weight of the connections from layer L.
+             */
+            template<std::size_t L>
+            static constexpr std::size_t weightOffset() noexcept;
+            /**
+             * @brief first bias of layer L, L > 0.
+             */
+            template<std::size_t L>
+            static constexpr std::size_t biasOffset() noexcept;
+            /**
+             * @brief Activations::activate with Activation, it is resolved at compile time.
+             */
+            static double activate(double v, double b) noexcept;
+            /**
+             * @brief adds the outputs of layer L to the sums of layer L + 1.
+             * @param sums const double* sums of layer L, the inputs for L == 0.
+             * @param next double* sums of layer L + 1.
+             */
+            template<std::size_t L>
+            void propagate(const double* sums, double* next) const noexcept;
+            /**
+             * @brief runs layers [0, numLayers - 1) and writes the sums of the output layer.
+             */
+            template<std::size_t... L>
+            void run(const double* inputs, double* sums, std::index_sequence<L...>) const noexcept;
+        private:
+            Weights m_weights;
+            Biases m_biases;
+    };
+    /**
+     * @brief BasicStaticNetwork with the same outputs as NeuralNetwork::forward.
+     */
+    template<Neuron::ActivationType Activation, std::size_t... Layers>
+    using StaticNetwork = BasicStaticNetwork<PlanEvaluationMode::EDGE_MAJOR, Activation, Layers...>;
+    /**
+     * @brief BasicStaticNetwork that activates each neuron once, like ExecutionPlan::EvaluationMode::NEURON_MAJOR.
+     */
+    template<Neuron::ActivationType Activation, std::size_t... Layers>
+    using StaticNetworkNM = BasicStaticNetwork<PlanEvaluationMode::NEURON_MAJOR, Activation, Layers...>;
+}
+#include "StaticNetwork.inl"
+#endif // EVOAI_STATIC_NETWORK_HPP
@@ -0,0 +1,237 @@
+namespace EvoAI{
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    constexpr std::size_t BasicStaticNetwork<Mode, Activation, Layers...>::numConnections() noexcept{
+        std::size_t total = 0u;
+        for(auto i=0u;i+1<numLayers;++i){
+            total += layerSizes[i] * layerSizes[i + 1];
+        }
+        return total;
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    constexpr std::size_t BasicStaticNetwork<Mode, Activation, Layers...>::numBiases() noexcept{
+        std::size_t total = 0u;
+        for(auto i=1u;i<numLayers;++i){
+            total += layerSizes[i];
+        }
+        return total;
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    BasicStaticNetwork<Mode, Activation, Layers...>::BasicStaticNetwork() noexcept
+    : m_weights()
+    , m_biases(){
+        m_weights.fill(0.0);
+        m_biases.fill(0.0);
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    BasicStaticNetwork<Mode, Activation, Layers...>::BasicStaticNetwork(NeuralNetwork& nn)
+    : BasicStaticNetwork(){
+        if(nn.size() != numLayers){
+            throw std::invalid_argument("StaticNetwork: the NeuralNetwork has " + std::to_string(nn.size())
+                                        + " layers, expected " + std::to_string(numLayers) + ".");
+        }
+        auto weight = 0u;
+        auto bias = 0u;
+        for(auto l=0u;l<numLayers;++l){
+            auto& layer = nn[l];
+            if(layer.size() != layerSizes[l]){
+                throw std::invalid_argument("StaticNetwork: layer " + std::to_string(l) + " has " + std::to_string(layer.size())
+                                            + " neurons, expected " + std::to_string(layerSizes[l]) + ".");
+            }
+            auto type = Neuron::Type::HIDDEN;
+            if(l == 0u){
+                type = Neuron::Type::INPUT;
+            }else if(l + 1 == numLayers){
+                type = Neuron::Type::OUTPUT;
+            }
+            for(auto n=0u;n<layer.size();++n){
+                auto& neuron = layer[n];
+                if(neuron.getType() != type){
+                    throw std::invalid_argument("StaticNetwork: neuron {" + std::to_string(l) + "," + std::to_string(n)
+                                                + "} is " + Neuron::typeToString(neuron.getType()) + ", expected "
+                                                + Neuron::typeToString(type) + ".");
+                }
+                if(l > 0u){
+                    if(neuron.getActivationType() != Activation){
+                        throw std::invalid_argument("StaticNetwork: neuron {" + std::to_string(l) + "," + std::to_string(n)
+                                                    + "} has activation " + Neuron::activationTypeToString(neuron.getActivationType())
+                                                    + ", expected " + Neuron::activationTypeToString(Activation) + ".");
+                    }
+                    m_biases[bias++] = neuron.getBiasWeight();
+                }
+                auto& conns = neuron.getConnections();
+                auto numDest = (l + 1 < numLayers) ? layerSizes[l + 1]:0u;
+                if(conns.size() != numDest){
+                    throw std::invalid_argument("StaticNetwork: neuron {" + std::to_string(l) + "," + std::to_string(n)
+                                                + "} has " + std::to_string(conns.size()) + " connections, expected "
+                                                + std::to_string(numDest) + ".");
+                }
+                // the sums have to be added in the same order as NeuralNetwork::forward to give the same outputs.
+                for(auto k=0u;k<conns.size();++k){
+                    auto& c = conns[k];
+                    if(c.isRecurrent() || c.getDest().layer != l + 1 || c.getDest().neuron != k){
+                        throw std::invalid_argument("StaticNetwork: connection " + std::to_string(k) + " of neuron {"
+                                                    + std::to_string(l) + "," + std::to_string(n) + "} should go to {"
+                                                    + std::to_string(l + 1) + "," + std::to_string(k) + "}.");
+                    }
+                    m_weights[weight++] = c.getWeight();
+                }
+            }
+        }
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    BasicStaticNetwork<Mode, Activation, Layers...>::BasicStaticNetwork(JsonBox::Object o)
+    : BasicStaticNetwork(){
+        NeuralNetwork nn(o);
+        *this = BasicStaticNetwork(nn);
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    BasicStaticNetwork<Mode, Activation, Layers...>::BasicStaticNetwork(const std::string& filename)
+    : BasicStaticNetwork(){
+        NeuralNetwork nn(filename);
+        *this = BasicStaticNetwork(nn);
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    typename BasicStaticNetwork<Mode, Activation, Layers...>::Outputs BasicStaticNetwork<Mode, Activation, Layers...>::forward(const Inputs& inputs) const noexcept{
+        Outputs outputs;
+        forward(inputs.data(), outputs.data());
+        return outputs;
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    void BasicStaticNetwork<Mode, Activation, Layers...>::forward(const double* inputs, double* outputs) const noexcept{
+        run(inputs, outputs, std::make_index_sequence<numLayers - 1>{});
+        constexpr auto begin = biasOffset<numLayers - 1>();
+        for(auto k=0u;k<numOutputs;++k){
+            auto s = outputs[k] + m_biases[begin + k];
+            outputs[k] = activate(s, m_biases[begin + k]);
+        }
+        if constexpr(Activation == Neuron::ActivationType::SOFTMAX){
+            Activations::softmax(outputs, numOutputs);
+        }
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    NeuralNetwork BasicStaticNetwork<Mode, Activation, Layers...>::toNeuralNetwork() const{
+        std::vector<std::size_t> hidden(std::begin(layerSizes) + 1, std::end(layerSizes) - 1);
+        NeuralNetwork nn(numInputs, hidden.size(), hidden, numOutputs, 0.0);
+        auto weight = 0u;
+        auto bias = 0u;
+        for(auto l=0u;l<numLayers;++l){
+            auto& layer = nn[l];
+            if(l > 0u){
+                layer.setActivationType(Activation);
+            }
+            for(auto n=0u;n<layerSizes[l];++n){
+                if(l > 0u){
+                    layer[n].setBiasWeight(m_biases[bias++]);
+                }
+                if(l + 1 < numLayers){
+                    for(auto k=0u;k<layerSizes[l + 1];++k){
+                        nn.addConnection(Connection({l, n}, {l + 1, k}, m_weights[weight++]));
+                    }
+                }
+            }
+        }
+        return nn;
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    JsonBox::Value BasicStaticNetwork<Mode, Activation, Layers...>::toJson() const{
+        return toNeuralNetwork().toJson();
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    void BasicStaticNetwork<Mode, Activation, Layers...>::writeToFile(const std::string& filename) const{
+        toNeuralNetwork().writeToFile(filename);
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    template<std::size_t L>
+    constexpr std::size_t BasicStaticNetwork<Mode, Activation, Layers...>::weightOffset() noexcept{
+        std::size_t offset = 0u;
+        for(auto i=0u;i<L;++i){
+            offset += layerSizes[i] * layerSizes[i + 1];
+        }
+        return offset;
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    template<std::size_t L>
+    constexpr std::size_t BasicStaticNetwork<Mode, Activation, Layers...>::biasOffset() noexcept{
+        std::size_t offset = 0u;
+        for(auto i=1u;i<L;++i){
+            offset += layerSizes[i];
+        }
+        return offset;
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    double BasicStaticNetwork<Mode, Activation, Layers...>::activate([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+        using ActivationType = Neuron::ActivationType;
+        if constexpr(Activation == ActivationType::IDENTITY || Activation == ActivationType::SOFTMAX){
+            return v;
+        }else if constexpr(Activation == ActivationType::SIGMOID){
+            return Activations::sigmoid(v);
+        }else if constexpr(Activation == ActivationType::STEPPED_SIGMOID){
+            return Activations::steepenedSigmoid(v);
+        }else if constexpr(Activation == ActivationType::SWISH){
+            return Activations::swish(v, b);
+        }else if constexpr(Activation == ActivationType::TANH){
+            return Activations::tanh(v);
+        }else if constexpr(Activation == ActivationType::SINUSOID){
+            return Activations::sinusoid(v);
+        }else if constexpr(Activation == ActivationType::COSINE){
+            return Activations::cosine(v);
+        }else if constexpr(Activation == ActivationType::RELU){
+            return Activations::relu(v);
+        }else if constexpr(Activation == ActivationType::LEAKY_RELU){
+            return Activations::leakyRelu(v);
+        }else if constexpr(Activation == ActivationType::GAUSSIAN){
+            return Activations::gaussian(v);
+        }else{
+            return Activations::activate(Activation, v, b);
+        }
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    template<std::size_t L>
+    void BasicStaticNetwork<Mode, Activation, Layers...>::propagate(const double* sums, double* next) const noexcept{
+        constexpr auto numSrc = layerSizes[L];
+        constexpr auto numDest = layerSizes[L + 1];
+        const double* w = m_weights.data() + weightOffset<L>();
+        for(auto k=0u;k<numDest;++k){
+            next[k] = 0.0;
+        }
+        for(auto j=0u;j<numSrc;++j){
+            const double* row = w + j * numDest;
+            if constexpr(L == 0u){
+                auto o = sums[j];
+                for(auto k=0u;k<numDest;++k){
+                    next[k] += o * row[k];
+                }
+            }else if constexpr(Mode == PlanEvaluationMode::NEURON_MAJOR){
+                auto b = m_biases[biasOffset<L>() + j];
+                auto o = activate(sums[j] + b, b);
+                for(auto k=0u;k<numDest;++k){
+                    next[k] += o * row[k];
+                }
+            }else{
+                // like NeuralNetwork::forward the bias is added and the neuron activated for each connection.
+                auto b = m_biases[biasOffset<L>() + j];
+                auto s = sums[j];
+                for(auto k=0u;k<numDest;++k){
+                    s += b;
+                    next[k] += activate(s, b) * row[k];
+                }
+            }
+        }
+    }
+    template<PlanEvaluationMode Mode, Neuron::ActivationType Activation, std::size_t... Layers>
+    template<std::size_t... L>
+    void BasicStaticNetwork<Mode, Activation, Layers...>::run(const double* inputs, double* sums, std::index_sequence<L...>) const noexcept{
+        constexpr auto maxSize = std::max({Layers...});
+        std::array<double, maxSize> buffers[2];
+        const double* in = inputs;
+        auto current = 0u;
+        auto step = [&](auto layer){
+            constexpr auto l = decltype(layer)::value;
+            double* out = (l + 2 == numLayers) ? sums:buffers[current].data();
+            propagate<l>(in, out);
+            in = out;
+            current ^= 1u;
+        };
+        (step(std::integral_constant<std::size_t, L>{}), ...);
+    }
+}
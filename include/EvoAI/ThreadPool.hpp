@@ -0,0 +1,84 @@
+#ifndef EVOAI_THREAD_POOL_HPP
+#define EVOAI_THREAD_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+#include <EvoAI/Export.hpp>
+
+namespace EvoAI{
+    /**
+     * @class ThreadPool
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file ThreadPool.hpp
+     * @brief A fixed set of threads that run the same task over a range of indices.
+     * @details run blocks until all the tasks are done and the calling thread runs tasks too,
+     *  so a pool of size() threads starts size() - 1 threads.
+     *  If run is called from a task of the same pool or while another thread is using the pool,
+     *  the tasks are run on the calling thread instead of waiting.
+     * @code
+     *      auto pool = std::make_shared<EvoAI::ThreadPool>(4);
+     *      std::vector<double> values(1000);
+     *      pool->run(4, [&](std::size_t task){
+     *          for(auto i=task * 250u;i<(task + 1u) * 250u;++i){
+     *              values[i] = std::sqrt(i);
+     *          }
+     *      });
+     * @endcode
+     */
+    class EvoAI_API ThreadPool final{
+        public:
+            using Task = std::function<void(std::size_t)>;
+        public:
+            /**
+             * @brief starts the threads.
+             * @param numThreads std::size_t threads including the one that calls run, 0 uses std::thread::hardware_concurrency.
+             */
+            explicit ThreadPool(std::size_t numThreads = 0u);
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+            /**
+             * @brief calls task(i) for each i in [0, numTasks) and waits until all of them are done.
+             * @param numTasks std::size_t
+             * @param task const Task&
+             */
+            void run(std::size_t numTasks, const Task& task) noexcept;
+            /**
+             * @brief number of threads including the one that calls run.
+             * @return std::size_t
+             */
+            inline std::size_t size() const noexcept{ return m_threads.size() + 1u; }
+            /**
+             * @brief stops the threads.
+             */
+            ~ThreadPool();
+        private:
+            /**
+             * @brief runs the tasks of the current generation until there are no more left.
+             */
+            void work() noexcept;
+            /**
+             * @brief waits for a new generation of tasks.
+             */
+            void loop() noexcept;
+        private:
+            std::vector<std::thread> m_threads;
+            std::mutex m_runMutex;
+            std::mutex m_mutex;
+            std::condition_variable m_start;
+            std::condition_variable m_done;
+            const Task* m_task;
+            std::size_t m_numTasks;
+            std::atomic<std::size_t> m_next;
+            std::size_t m_working;
+            std::uint64_t m_generation;
+            bool m_stop;
+    };
+}
+
+#endif // EVOAI_THREAD_POOL_HPP
@@ -0,0 +1,191 @@
+#ifndef EVOAI_TRAINING_PROFILER_HPP
+#define EVOAI_TRAINING_PROFILER_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#include <EvoAI/Export.hpp>
+
+#include <JsonBox.h>
+
+namespace EvoAI{
+    /**
+     * @class TrainingProfiler
+     * @author Cristian Glez <cristian.glez.m@gmail.com>
+     * @file TrainingProfiler.hpp
+     * @brief Records the wall time and the calls of each phase of NeuralNetwork::train per epoch.
+     * @details Each finished epoch is kept in getEpochs and, when an output stream is given,
+     *  written to it as a line of JSON or CSV so the throughput can be compared between versions.
+     * @code
+     *     auto profiler = std::make_shared<EvoAI::TrainingProfiler>(std::cout, EvoAI::TrainingProfiler::Format::CSV);
+     *     nn->setProfiler(profiler);
+     *     nn->train(trainingDataset, testDataset, optim, epochs, EvoAI::Loss::MeanSquaredError{}, testFn);
+     *     auto samplesPerSecond = profiler->getEpochs().back().samplesPerSecond();
+     * @endcode
+     */
+    class EvoAI_API TrainingProfiler final{
+        public:
+            using Clock = std::chrono::steady_clock;
+            /**
+             * @brief phases of a training step.
+             */
+            enum class Phase : std::size_t{
+                DATA_LOADING,
+                FORWARD,
+                LOSS,
+                BACKWARD,
+                OPTIMIZER,
+                TEST
+            };
+            static constexpr std::size_t NumPhases = 6u;
+            /**
+             * @brief format of the lines written to the output stream.
+             */
+            enum class Format{
+                JSON,
+                CSV
+            };
+            /**
+             * @brief wall time and calls of an epoch.
+             */
+            struct EvoAI_API EpochStats{
+                std::uint64_t epoch = 0u; ///< NeuralNetwork::getGlobalStep when the epoch started.
+                std::size_t samples = 0u;
+                double seconds = 0.0; ///< whole epoch, printing included.
+                std::array<double, NumPhases> phaseSeconds{};
+                std::array<std::uint64_t, NumPhases> phaseCalls{};
+                /**
+                 * @brief samples trained per second of the epoch.
+                 * @return double
+                 */
+                double samplesPerSecond() const noexcept;
+                /**
+                 * @brief seconds spent in a phase.
+                 * @param phase Phase
+                 * @return double
+                 */
+                inline double getSeconds(Phase phase) const noexcept{ return phaseSeconds[static_cast<std::size_t>(phase)]; }
+                /**
+                 * @brief times a phase was recorded.
+                 * @param phase Phase
+                 * @return std::uint64_t
+                 */
+                inline std::uint64_t getCalls(Phase phase) const noexcept{ return phaseCalls[static_cast<std::size_t>(phase)]; }
+                /**
+                 * @brief writes the stats to json, the counters are written as strings.
+                 * @return JsonBox::Value
+                 */
+                JsonBox::Value toJson() const noexcept;
+                /**
+                 * @brief writes the stats as a CSV row with the columns of TrainingProfiler::csvHeader.
+                 * @return std::string
+                 */
+                std::string toCSV() const noexcept;
+            };
+            /**
+             * @brief measures consecutive phases, each lap records the time since the last one.
+             * @details Does nothing when the profiler is nullptr so training without one doesn't read the clock.
+             * @code
+             *     TrainingProfiler::Stopwatch watch(profiler);
+             *     auto [inputs, expectedOutputs] = trainingDataset();
+             *     watch.lap(TrainingProfiler::Phase::DATA_LOADING);
+             *     auto outputs = nn.forward(inputs);
+             *     watch.lap(TrainingProfiler::Phase::FORWARD);
+             * @endcode
+             */
+            class Stopwatch final{
+                public:
+                    /**
+                     * @brief starts the stopwatch.
+                     * @param profiler TrainingProfiler* can be nullptr.
+                     */
+                    explicit Stopwatch(TrainingProfiler* profiler) noexcept
+                    : m_profiler(profiler)
+                    , m_last(profiler ? Clock::now() : Clock::time_point{}){}
+                    /**
+                     * @brief records the time since the last lap or restart into phase.
+                     * @param phase Phase
+                     * @param calls std::uint64_t how many calls of the phase the lap took.
+                     */
+                    inline void lap(Phase phase, std::uint64_t calls = 1u) noexcept{
+                        if(m_profiler){
+                            auto now = Clock::now();
+                            m_profiler->record(phase, now - m_last, calls);
+                            m_last = now;
+                        }
+                    }
+                    /**
+                     * @brief the time until the next lap won't be recorded.
+                     */
+                    inline void restart() noexcept{
+                        if(m_profiler){
+                            m_last = Clock::now();
+                        }
+                    }
+                private:
+                    TrainingProfiler* m_profiler;
+                    Clock::time_point m_last;
+            };
+        public:
+            /**
+             * @brief keeps the stats without writing them.
+             */
+            TrainingProfiler() noexcept;
+            /**
+             * @brief writes a line to out for every epoch, the CSV header is written right away.
+             * @param out std::ostream& must outlive the profiler.
+             * @param format Format
+             */
+            TrainingProfiler(std::ostream& out, Format format);
+            /**
+             * @brief starts measuring an epoch.
+             * @param epoch std::uint64_t
+             */
+            void beginEpoch(std::uint64_t epoch) noexcept;
+            /**
+             * @brief adds elapsed to the phase of the current epoch.
+             * @param phase Phase
+             * @param elapsed Clock::duration
+             * @param calls std::uint64_t
+             */
+            void record(Phase phase, Clock::duration elapsed, std::uint64_t calls = 1u) noexcept;
+            /**
+             * @brief finishes the current epoch, keeps its stats and writes them.
+             * @param samples std::size_t samples trained in the epoch.
+             * @return const EpochStats&
+             */
+            const EpochStats& endEpoch(std::size_t samples) noexcept;
+            /**
+             * @brief stats of the finished epochs.
+             * @return const std::vector<EpochStats>&
+             */
+            const std::vector<EpochStats>& getEpochs() const noexcept;
+            /**
+             * @brief removes the stats of the finished epochs.
+             */
+            void clear() noexcept;
+            /**
+             * @brief name of the phase used in the JSON and CSV output.
+             * @param phase Phase
+             * @return const char*
+             */
+            static const char* phaseName(Phase phase) noexcept;
+            /**
+             * @brief CSV columns of EpochStats::toCSV
+             * @return std::string
+             */
+            static std::string csvHeader() noexcept;
+        private:
+            std::ostream* m_out;
+            Format m_format;
+            EpochStats m_current;
+            Clock::time_point m_epochStart;
+            std::vector<EpochStats> m_epochs;
+    };
+}
+
+#endif // EVOAI_TRAINING_PROFILER_HPP
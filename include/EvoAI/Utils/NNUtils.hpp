@@ -8,6 +8,8 @@
 #include <string>
 #include <algorithm>
 #include <numeric>
+#include <limits>
+#include <cmath>
 
 #include <EvoAI/NeuralNetwork.hpp>
 #include <EvoAI/Utils/RandomUtils.hpp>
@@ -140,6 +142,124 @@ namespace EvoAI{
     std::size_t Argmax(Iterator begin, Iterator end, Fn&& fn) noexcept{
         return std::distance(begin, std::max_element(begin, end, fn));
     }
+    /**
+     * @brief errors of some outputs against the reference outputs, see compareOutputs.
+     */
+    struct AccuracyReport{
+        double maxAbsError = 0.0;
+        double meanAbsError = 0.0;
+        double maxRelError = 0.0;
+        double argmaxAgreement = 1.0; ///< ratio of samples that have the same Argmax in both.
+    };
+    /**
+     * @brief compares outputs against the reference outputs, sample by sample.
+     * @details the relative error skips the reference values that are 0.0,
+     * if the sizes don't match all the errors are infinity and argmaxAgreement is 0.0.
+     * @tparam T float or double
+     * @param reference const std::vector<double>& row-major [samples x numOutputs]
+     * @param outputs const std::vector<T>& row-major [samples x numOutputs]
+     * @param numOutputs std::size_t
+     * @return AccuracyReport
+     */
+    template<typename T>
+    AccuracyReport compareOutputs(const std::vector<double>& reference, const std::vector<T>& outputs, std::size_t numOutputs) noexcept{
+        AccuracyReport report;
+        if(numOutputs == 0u || reference.size() != outputs.size() || reference.size() % numOutputs != 0u){
+            auto inf = std::numeric_limits<double>::infinity();
+            return AccuracyReport{inf, inf, inf, 0.0};
+        }
+        auto samples = reference.size() / numOutputs;
+        if(samples == 0u){
+            return report;
+        }
+        auto totalError = 0.0;
+        auto agreements = 0u;
+        for(auto s=0u;s<samples;++s){
+            auto ref = std::begin(reference) + s * numOutputs;
+            auto out = std::begin(outputs) + s * numOutputs;
+            for(auto j=0u;j<numOutputs;++j){
+                auto error = std::abs(static_cast<double>(out[j]) - ref[j]);
+                totalError += error;
+                report.maxAbsError = std::max(report.maxAbsError, error);
+                if(ref[j] != 0.0){
+                    report.maxRelError = std::max(report.maxRelError, error / std::abs(ref[j]));
+                }
+            }
+            if(Argmax(ref, ref + numOutputs) == Argmax(out, out + numOutputs)){
+                ++agreements;
+            }
+        }
+        report.meanAbsError = totalError / reference.size();
+        report.argmaxAgreement = static_cast<double>(agreements) / samples;
+        return report;
+    }
+    /**
+     * @brief runs the inputs through an ExecutionPlanF and an ExecutionPlan built from nn and compares their outputs.
+     * @param nn NeuralNetwork&
+     * @param inputs const std::vector<double>& row-major [batchSize x inputs]
+     * @param batchSize std::size_t
+     * @return AccuracyReport of the float outputs against the double outputs.
+     */
+    EvoAI_API AccuracyReport compareFloatPlan(NeuralNetwork& nn, const std::vector<double>& inputs, std::size_t batchSize) noexcept;
+    /**
+     * @brief what optimizePhenotype removed from the network.
+     */
+    struct PhenotypeReport{
+        std::size_t removedNeurons = 0u;
+        std::size_t removedConnections = 0u; ///< all of them, including the merged and folded ones.
+        std::size_t mergedConnections = 0u; ///< parallel connections added to another one.
+        std::size_t foldedConnections = 0u; ///< connections of a constant neuron added to the bias of its destination.
+    };
+    /**
+     * @brief removes the parts of a network that do not change its outputs, meant for the phenotypes of Genome::makePhenotype.
+     * @details It runs until nothing else can be removed:
+     *  - connections to neurons that cannot reach an output and connections with a weight of 0.0.
+     *  - hidden and context neurons without connections.
+     *  - if foldConstants is true, parallel connections are merged into one and the connections of hidden neurons
+     *    without inputs (fed only by their bias) are added to the bias of the output neurons or the hidden neurons
+     *    with one connection they go to, then those neurons are removed as well.
+     *  A hidden neuron adds its bias for each connection when the network runs (see PlanEvaluationMode::EDGE_MAJOR), so when
+     *  its bias is not 0.0 only its last connections can be removed. The input and output neurons are kept.
+     *  The outputs stay the same as long as the activations are finite and NeuralNetwork::reset is called after each forward,
+     *  with foldConstants the merged and folded weights are summed in another order and can differ in the last bits.
+     * @code
+     *      auto nn = EvoAI::Genome::makePhenotype(genome);
+     *      auto report = EvoAI::optimizePhenotype(nn);
+     *      nn.compile();
+     * @endcode
+     * @param nn NeuralNetwork&
+     * @param foldConstants bool
+     * @return PhenotypeReport
+     */
+    EvoAI_API PhenotypeReport optimizePhenotype(NeuralNetwork& nn, bool foldConstants = true) noexcept;
+    /**
+     * @brief what reorderForLocality changed, the spans are the mean distance between the source and the
+     * destination of the connections with the neurons numbered layer by layer like ExecutionPlan.
+     */
+    struct LocalityReport{
+        std::size_t movedNeurons = 0u;
+        double meanSpanBefore = 0.0;
+        double meanSpanAfter = 0.0;
+    };
+    /**
+     * @brief renumbers the hidden neurons and sorts the connections so the sums read and written when the network runs are closer together.
+     * @details Meant for the phenotypes of Genome::makePhenotype, where every hidden neuron is in one layer in the order the genes were added.
+     *  The neurons of each hidden layer are placed in a topological order that keeps a neuron next to the neurons it is
+     *  connected to (like Cuthill-McKee, ties broken by the old order) when it makes the connections of the layer shorter,
+     *  then the connections of each neuron are sorted by destination when it gives the same output to all of them.
+     *  The order only changes what NeuralNetwork::run does not depend on: a connected pair of neurons keeps which one runs first,
+     *  the neurons that add to the same sum keep their order and a hidden neuron with a bias keeps the order of its connections,
+     *  so the outputs are the same and the recurrent connections are still recurrent. The input and output neurons are not moved.
+     * @code
+     *      auto nn = EvoAI::Genome::makePhenotype(genome);
+     *      EvoAI::optimizePhenotype(nn);
+     *      EvoAI::reorderForLocality(nn);
+     *      nn.compile();
+     * @endcode
+     * @param nn NeuralNetwork&
+     * @return LocalityReport
+     */
+    EvoAI_API LocalityReport reorderForLocality(NeuralNetwork& nn) noexcept;
 }
 
 #endif // EVOAI_NN_UTILS_HPP
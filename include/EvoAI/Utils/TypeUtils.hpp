@@ -198,6 +198,13 @@ namespace EvoAI::meta{
     };
     template<class T>
     static constexpr bool is_a_scheduler_algorithm_v = is_a_scheduler_algorithm<T>::value;
+    /**
+     * @brief T has a member function getAlgo() and its algorithm has a member function ParameterBuffer& getParameterBuffer() noexcept;
+     */
+    template<class T>
+    using has_parameter_buffer_t = decltype(std::declval<T&>().getAlgo().getParameterBuffer());
+    template<class T>
+    static constexpr bool has_parameter_buffer_v = estd::is_detected<has_parameter_buffer_t, T>::value;
    /**
      *  @brief T has a member function double operator()(const std::vector<double>& expectedOutputs, const std::vector<double>& outputs) noexcept
      */
@@ -212,6 +219,22 @@ namespace EvoAI::meta{
     using has_backward_t = decltype(std::declval<T>().backward(std::declval<const std::vector<double>&>(), std::declval<const std::vector<double>&>()));
     template<class T>
     static constexpr bool has_backward_v = estd::is_detected<has_backward_t, T>::value;
+   /**
+     *  @brief T has a member function double lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept
+     */
+    template<class T>
+    using has_loss_and_grad_t = decltype(std::declval<T>().lossAndGrad(std::declval<const double*>(), std::declval<const double*>(),
+                                                                        std::declval<double*>(), std::declval<std::size_t>()));
+    template<class T>
+    static constexpr bool has_loss_and_grad_v = estd::is_detected<has_loss_and_grad_t, T>::value;
+   /**
+     *  @brief T has a member function double softmaxLossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept
+     */
+    template<class T>
+    using has_softmax_loss_and_grad_t = decltype(std::declval<T>().softmaxLossAndGrad(std::declval<const double*>(), std::declval<const double*>(),
+                                                                                      std::declval<double*>(), std::declval<std::size_t>()));
+    template<class T>
+    static constexpr bool has_softmax_loss_and_grad_v = estd::is_detected<has_softmax_loss_and_grad_t, T>::value;
     /**
      * @brief T is a loss algorithm.
      */
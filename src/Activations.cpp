@@ -1,6 +1,868 @@
 #include <EvoAI/Activations.hpp>
 #include <EvoAI/NeuralNetwork.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+    #define EVOAI_SIMD_X86
+#endif
+
+namespace{
+    using EvoAI::Activations::Array::SimdLevel;
+#if defined(EVOAI_SIMD_X86)
+    #define EVOAI_SIMD_INLINE inline __attribute__((always_inline))
+    typedef double v2d __attribute__((vector_size(16)));
+    typedef double v4d __attribute__((vector_size(32)));
+    typedef float v4f __attribute__((vector_size(16)));
+    typedef float v8f __attribute__((vector_size(32)));
+    typedef std::int64_t v2l __attribute__((vector_size(16)));
+    typedef std::int64_t v4l __attribute__((vector_size(32)));
+    typedef std::uint64_t v2u __attribute__((vector_size(16)));
+    typedef std::uint64_t v4u __attribute__((vector_size(32)));
+    typedef std::int32_t v4i __attribute__((vector_size(16)));
+    typedef std::int32_t v8i __attribute__((vector_size(32)));
+    typedef std::uint32_t v4ui __attribute__((vector_size(16)));
+    typedef std::uint32_t v8ui __attribute__((vector_size(32)));
+    template<typename V>
+    struct SimdTraits;
+    template<>
+    struct SimdTraits<v2d>{
+        using Scalar = double;
+        using Int = v2l;
+        using UInt = v2u;
+        static constexpr std::size_t width = 2u;
+    };
+    template<>
+    struct SimdTraits<v4d>{
+        using Scalar = double;
+        using Int = v4l;
+        using UInt = v4u;
+        static constexpr std::size_t width = 4u;
+    };
+    template<>
+    struct SimdTraits<v4f>{
+        using Scalar = float;
+        using Int = v4i;
+        using UInt = v4ui;
+        static constexpr std::size_t width = 4u;
+    };
+    template<>
+    struct SimdTraits<v8f>{
+        using Scalar = float;
+        using Int = v8i;
+        using UInt = v8ui;
+        static constexpr std::size_t width = 8u;
+    };
+    template<typename V>
+    using ScalarOf = typename SimdTraits<V>::Scalar;
+    template<typename V>
+    using IntOf = typename SimdTraits<V>::Int;
+    template<typename V>
+    using UIntOf = typename SimdTraits<V>::UInt;
+    /// the vector of each SimdLevel for double and float.
+    template<typename T>
+    struct SimdVectors;
+    template<>
+    struct SimdVectors<double>{
+        using Sse2 = v2d;
+        using Avx2 = v4d;
+    };
+    template<>
+    struct SimdVectors<float>{
+        using Sse2 = v4f;
+        using Avx2 = v8f;
+    };
+    /// bits of the mantissa and bias of the exponent of double and float.
+    template<typename T>
+    struct FloatBits;
+    template<>
+    struct FloatBits<double>{
+        static constexpr int mantissa = 52;
+        static constexpr int bias = 1023;
+        // adding and removing 1.5 * 2^52 rounds to the nearest integer and leaves it in the low bits.
+        static constexpr double shifter = 6755399441055744.0;
+    };
+    template<>
+    struct FloatBits<float>{
+        static constexpr int mantissa = 23;
+        static constexpr int bias = 127;
+        static constexpr float shifter = 12582912.0f; // 1.5 * 2^23
+    };
+    template<typename V>
+    using IfDouble = std::enable_if_t<std::is_same_v<ScalarOf<V>, double>, int>;
+    template<typename V>
+    using IfFloat = std::enable_if_t<std::is_same_v<ScalarOf<V>, float>, int>;
+    template<typename V>
+    EVOAI_SIMD_INLINE V splat(double v) noexcept{
+        return V{} + static_cast<ScalarOf<V>>(v);
+    }
+    template<typename V>
+    EVOAI_SIMD_INLINE V vabs(V x) noexcept{
+        // -V{} is -0.0, only the sign bits set.
+        return (V)((IntOf<V>)x & ~(IntOf<V>)(-V{}));
+    }
+    /// floor for |x| < 2^51 (2^22 with float)
+    template<typename V>
+    EVOAI_SIMD_INLINE V vfloor(V x) noexcept{
+        constexpr auto s = FloatBits<ScalarOf<V>>::shifter;
+        V r = (x + s) - s;
+        return r > x ? r - 1.0 : r;
+    }
+    /// integral x with |x| < 2^51 (2^22 with float) to an integer of the same width
+    template<typename V>
+    EVOAI_SIMD_INLINE IntOf<V> toInt(V x) noexcept{
+        constexpr auto s = FloatBits<ScalarOf<V>>::shifter;
+        return (IntOf<V>)(x + s) - (IntOf<V>)splat<V>(s);
+    }
+    /// integer i with |i| < 2^51 (2^22 with float) to V
+    template<typename V>
+    EVOAI_SIMD_INLINE V fromInt(IntOf<V> i) noexcept{
+        constexpr auto s = FloatBits<ScalarOf<V>>::shifter;
+        return (V)(i + (IntOf<V>)splat<V>(s)) - s;
+    }
+    /// 2^n for integral n in [-1022, 1023] ([-126, 127] with float)
+    template<typename V>
+    EVOAI_SIMD_INLINE V pow2(V n) noexcept{
+        using Bits = FloatBits<ScalarOf<V>>;
+        return (V)((toInt(n) + Bits::bias) << Bits::mantissa);
+    }
+    template<typename V, IfDouble<V> = 0>
+    EVOAI_SIMD_INLINE V vexp(V x) noexcept{
+        constexpr double maxLog = 709.782712893383996843;
+        constexpr double minLog = -745.13321910194110842;
+        V xc = x > maxLog ? splat<V>(maxLog) : x;
+        xc = xc < minLog ? splat<V>(minLog) : xc;
+        // x = n * ln2 + r, |r| <= ln2 / 2
+        constexpr auto shifter = FloatBits<double>::shifter;
+        V n = (xc * 1.4426950408889634073599 + shifter) - shifter;
+        V r = xc - n * 6.93145751953125E-1;
+        r = r - n * 1.42860682030941723212E-6;
+        // cephes exp, e^r = 1 + 2r * P(r^2) / (Q(r^2) - r * P(r^2))
+        V rr = r * r;
+        V px = r * ((1.26177193074810590878E-4 * rr + 3.02994407707441961300E-2) * rr + 9.99999999999999999910E-1);
+        V qx = ((3.00198505138664455042E-6 * rr + 2.52448340349684104192E-3) * rr + 2.27265548208155028766E-1) * rr + 2.00000000000000000009E0;
+        V e = 1.0 + 2.0 * (px / (qx - px));
+        // n can be out of the range of a normal double, so 2^n is applied in two steps.
+        V n1 = vfloor(n * 0.5);
+        V result = (e * pow2(n1)) * pow2(n - n1);
+        result = x > maxLog ? splat<V>(std::numeric_limits<double>::infinity()) : result;
+        result = x < minLog ? splat<V>(0.0) : result;
+        return x != x ? x : result;
+    }
+    template<typename V, IfDouble<V> = 0>
+    EVOAI_SIMD_INLINE V vlog(V x) noexcept{
+        using I = IntOf<V>;
+        constexpr auto inf = std::numeric_limits<double>::infinity();
+        auto subnormal = x < std::numeric_limits<double>::min();
+        V xs = subnormal ? x * 18014398509481984.0 : x; // 2^54
+        I bits = (I)xs;
+        V e = fromInt<V>((IntOf<V>)((UIntOf<V>)bits >> 52) - 1022);
+        e = subnormal ? e - 54.0 : e;
+        // x = m * 2^e, m in [0.5, 1)
+        V m = (V)((bits & std::int64_t(0x000FFFFFFFFFFFFF)) | std::int64_t(0x3FE0000000000000));
+        auto belowSqrtHalf = m < 0.70710678118654752440;
+        e = belowSqrtHalf ? e - 1.0 : e;
+        m = belowSqrtHalf ? m + m - 1.0 : m - 1.0;
+        // cephes log, log(1 + m) = m - m^2 / 2 + m^3 * P(m) / Q(m)
+        V z = m * m;
+        V p = ((((1.01875663804580931796E-4 * m + 4.97494994976747001425E-1) * m + 4.70579119878881725854E0) * m
+                + 1.44989225341610930846E1) * m + 1.79368678507819816313E1) * m + 7.70838733755885391666E0;
+        V q = ((((m + 1.12873587189167450590E1) * m + 4.52279145837532221105E1) * m + 8.29875266912776603211E1) * m
+                + 7.11544750618563894466E1) * m + 2.31251620126765340583E1;
+        V y = m * (z * p / q);
+        y = y + e * -2.121944400546905827679E-4;
+        y = y - 0.5 * z;
+        V result = (m + y) + e * 0.693359375;
+        result = x == 0.0 ? splat<V>(-inf) : result;
+        result = x < 0.0 ? splat<V>(std::numeric_limits<double>::quiet_NaN()) : result;
+        result = x == inf ? splat<V>(inf) : result;
+        return x != x ? x : result;
+    }
+    template<typename V, IfDouble<V> = 0>
+    EVOAI_SIMD_INLINE V vtanh(V x) noexcept{
+        V ax = vabs(x);
+        V large = 1.0 - 2.0 / (vexp(2.0 * ax) + 1.0);
+        large = x < 0.0 ? -large : large;
+        // cephes tanh for |x| < 0.625
+        V z = x * x;
+        V p = (-9.64399179425052238628E-1 * z - 9.92877231001918586564E1) * z - 1.61468768441708447952E3;
+        V q = ((z + 1.12811678491632931402E2) * z + 2.23548839060100448583E3) * z + 4.84406305325125486048E3;
+        V small = x + x * z * (p / q);
+        return ax < 0.625 ? small : large;
+    }
+    /// cephes sin and cos, they need |x| < 2^30
+    template<typename V, bool Cosine, IfDouble<V> = 0>
+    EVOAI_SIMD_INLINE V vsincos(V x) noexcept{
+        // the octant is kept as a double, sse2 doesn't have 64 bits integer comparisons.
+        V ax = vabs(x);
+        V y = vfloor(ax * 1.27323954473516268615); // 4 / pi
+        y = y + (y - 2.0 * vfloor(y * 0.5));
+        V j = y - 8.0 * vfloor(y * 0.125);
+        auto swap = j > 3.5;
+        j = swap ? j - 4.0 : j;
+        auto negative = Cosine ? (swap ^ (j > 1.5)) : ((x < 0.0) ^ swap);
+        V z = ((ax - y * 7.85398125648498535156E-1) - y * 3.77489470793079817668E-8) - y * 2.69515142907905952645E-15;
+        V zz = z * z;
+        V sinPoly = (((((1.58962301576546568060E-10 * zz - 2.50507477628578072866E-8) * zz + 2.75573136213857245213E-6) * zz
+                        - 1.98412698295895385996E-4) * zz + 8.33333333332211858878E-3) * zz - 1.66666666666666307295E-1);
+        V cosPoly = (((((-1.13585365213876817300E-11 * zz + 2.08757008419747316778E-9) * zz - 2.75573141792967388112E-7) * zz
+                        + 2.48015872888517045348E-5) * zz - 1.38888888888730564116E-3) * zz + 4.16666666666665929218E-2);
+        V s = z + z * zz * sinPoly;
+        V c = 1.0 - 0.5 * zz + zz * zz * cosPoly;
+        auto useCos = (j == 1.0) | (j == 2.0);
+        V result = Cosine ? (useCos ? s : c) : (useCos ? c : s);
+        result = negative ? -result : result;
+        // big or non finite values go through the scalar version.
+        auto outOfRange = !(ax < 1073741824.0);
+        auto any = false;
+        for(auto i=0u;i<SimdTraits<V>::width;++i){
+            any |= outOfRange[i] != 0;
+        }
+        if(any){
+            for(auto i=0u;i<SimdTraits<V>::width;++i){
+                if(outOfRange[i]){
+                    result[i] = Cosine ? std::cos(x[i]) : std::sin(x[i]);
+                }
+            }
+        }
+        return result;
+    }
+    template<typename V, IfFloat<V> = 0>
+    EVOAI_SIMD_INLINE V vexp(V x) noexcept{
+        constexpr float maxLog = 88.72283905206835f;
+        constexpr float minLog = -103.972077083991796f;
+        constexpr auto shifter = FloatBits<float>::shifter;
+        V xc = x > maxLog ? splat<V>(maxLog) : x;
+        xc = xc < minLog ? splat<V>(minLog) : xc;
+        // x = n * ln2 + r, |r| <= ln2 / 2
+        V n = (xc * 1.44269504088896341f + shifter) - shifter;
+        V r = xc - n * 0.693359375f;
+        r = r - n * -2.12194440e-4f;
+        // cephes expf
+        V rr = r * r;
+        V e = (((((1.9875691500E-4f * r + 1.3981999507E-3f) * r + 8.3334519073E-3f) * r + 4.1665795894E-2f) * r
+                + 1.6666665459E-1f) * r + 5.0000001201E-1f) * rr + r + 1.0f;
+        // n can be out of the range of a normal float, so 2^n is applied in two steps.
+        V n1 = vfloor(n * 0.5f);
+        V result = (e * pow2(n1)) * pow2(n - n1);
+        result = x > maxLog ? splat<V>(std::numeric_limits<float>::infinity()) : result;
+        result = x < minLog ? splat<V>(0.0) : result;
+        return x != x ? x : result;
+    }
+    template<typename V, IfFloat<V> = 0>
+    EVOAI_SIMD_INLINE V vlog(V x) noexcept{
+        using I = IntOf<V>;
+        constexpr auto inf = std::numeric_limits<float>::infinity();
+        auto subnormal = x < std::numeric_limits<float>::min();
+        V xs = subnormal ? x * 33554432.0f : x; // 2^25
+        I bits = (I)xs;
+        V e = fromInt<V>((IntOf<V>)((UIntOf<V>)bits >> 23) - 126);
+        e = subnormal ? e - 25.0f : e;
+        // x = m * 2^e, m in [0.5, 1)
+        V m = (V)((bits & std::int32_t(0x007FFFFF)) | std::int32_t(0x3F000000));
+        auto belowSqrtHalf = m < 0.707106781186547524f;
+        e = belowSqrtHalf ? e - 1.0f : e;
+        m = belowSqrtHalf ? m + m - 1.0f : m - 1.0f;
+        // cephes logf, log(1 + m) = m - m^2 / 2 + m^3 * P(m)
+        V z = m * m;
+        V y = ((((((((7.0376836292E-2f * m - 1.1514610310E-1f) * m + 1.1676998740E-1f) * m - 1.2420140846E-1f) * m
+                + 1.4249322787E-1f) * m - 1.6668057665E-1f) * m + 2.0000714765E-1f) * m - 2.4999993993E-1f) * m
+                + 3.3333331174E-1f) * m * z;
+        y = y + e * -2.12194440e-4f;
+        y = y - 0.5f * z;
+        V result = (m + y) + e * 0.693359375f;
+        result = x == 0.0f ? splat<V>(-inf) : result;
+        result = x < 0.0f ? splat<V>(std::numeric_limits<float>::quiet_NaN()) : result;
+        result = x == inf ? splat<V>(inf) : result;
+        return x != x ? x : result;
+    }
+    template<typename V, IfFloat<V> = 0>
+    EVOAI_SIMD_INLINE V vtanh(V x) noexcept{
+        V ax = vabs(x);
+        V large = 1.0f - 2.0f / (vexp(2.0f * ax) + 1.0f);
+        large = x < 0.0f ? -large : large;
+        // cephes tanhf for |x| < 0.625
+        V z = x * x;
+        V small = ((((-5.70498872745E-3f * z + 2.06390887954E-2f) * z - 5.37397155531E-2f) * z + 1.33314422036E-1f) * z
+                    - 3.33332819422E-1f) * z * x + x;
+        return ax < 0.625f ? small : large;
+    }
+    /// cephes sinf and cosf, they need |x| < 8192
+    template<typename V, bool Cosine, IfFloat<V> = 0>
+    EVOAI_SIMD_INLINE V vsincos(V x) noexcept{
+        V ax = vabs(x);
+        V y = vfloor(ax * 1.27323954473516268615f); // 4 / pi
+        y = y + (y - 2.0f * vfloor(y * 0.5f));
+        V j = y - 8.0f * vfloor(y * 0.125f);
+        auto swap = j > 3.5f;
+        j = swap ? j - 4.0f : j;
+        auto negative = Cosine ? (swap ^ (j > 1.5f)) : ((x < 0.0f) ^ swap);
+        V z = ((ax - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+        V zz = z * z;
+        V s = ((-1.9515295891E-4f * zz + 8.3321608736E-3f) * zz - 1.6666654611E-1f) * zz * z + z;
+        V c = ((2.443315711809948E-5f * zz - 1.388731625493765E-3f) * zz + 4.166664568298827E-2f) * zz * zz - 0.5f * zz + 1.0f;
+        auto useCos = (j == 1.0f) | (j == 2.0f);
+        V result = Cosine ? (useCos ? s : c) : (useCos ? c : s);
+        result = negative ? -result : result;
+        // big or non finite values go through the scalar version.
+        auto outOfRange = !(ax < 8192.0f);
+        auto any = false;
+        for(auto i=0u;i<SimdTraits<V>::width;++i){
+            any |= outOfRange[i] != 0;
+        }
+        if(any){
+            for(auto i=0u;i<SimdTraits<V>::width;++i){
+                if(outOfRange[i]){
+                    result[i] = Cosine ? std::cos(x[i]) : std::sin(x[i]);
+                }
+            }
+        }
+        return result;
+    }
+    template<typename V>
+    EVOAI_SIMD_INLINE V vsigmoid(V x) noexcept{
+        return 1.0 / (1.0 + vexp(-x));
+    }
+    template<typename V>
+    EVOAI_SIMD_INLINE V vsigmoidDerivative(V x) noexcept{
+        V s = vsigmoid(x);
+        return s * (1.0 - s);
+    }
+    template<typename V>
+    EVOAI_SIMD_INLINE V vtanhDerivative(V x) noexcept{
+        V e = vexp(vabs(x));
+        V c = 0.5 * (e + 1.0 / e);
+        return 1.0 / (c * c);
+    }
+    template<typename V>
+    EVOAI_SIMD_INLINE V vswishDerivative(V x) noexcept{
+        V s = vsigmoid(x);
+        return s + vsigmoidDerivative(s) * (1.0 - s);
+    }
+    template<typename V, typename Op>
+    EVOAI_SIMD_INLINE void transformSimd(const ScalarOf<V>* values, ScalarOf<V>* outputs, std::size_t size, double b) noexcept{
+        constexpr auto width = SimdTraits<V>::width;
+        auto bias = static_cast<ScalarOf<V>>(b);
+        std::size_t i = 0u;
+        for(;i + width <= size;i += width){
+            V x;
+            std::memcpy(&x, values + i, sizeof(V));
+            V r = Op::template apply<V>(x, bias);
+            std::memcpy(outputs + i, &r, sizeof(V));
+        }
+        if(i < size){
+            V x{};
+            auto rest = (size - i) * sizeof(ScalarOf<V>);
+            std::memcpy(&x, values + i, rest);
+            V r = Op::template apply<V>(x, bias);
+            std::memcpy(outputs + i, &r, rest);
+        }
+    }
+    template<typename Op, typename T>
+    __attribute__((target("avx2,fma"))) void transformAvx2(const T* values, T* outputs, std::size_t size, double b) noexcept{
+        transformSimd<typename SimdVectors<T>::Avx2, Op>(values, outputs, size, b);
+    }
+    template<typename Op, typename T>
+    void transformSse2(const T* values, T* outputs, std::size_t size, double b) noexcept{
+        transformSimd<typename SimdVectors<T>::Sse2, Op>(values, outputs, size, b);
+    }
+    /**
+     * @brief evaluates a LookupTable::Table like Table::evaluate does, the two neighbours of each lane are loaded one by one.
+     * The periodic values that vfloor can't wrap go through Table::evaluate.
+     */
+    template<typename V, typename Table>
+    EVOAI_SIMD_INLINE void lookupSimd(const Table& table, const double* values, double* outputs, std::size_t size) noexcept{
+        constexpr auto width = SimdTraits<V>::width;
+        constexpr double maxQuotient = 2251799813685248.0; // 2^51
+        const auto* data = table.values.data();
+        auto last = static_cast<double>(table.values.size() - 2u);
+        auto period = table.end - table.begin;
+        std::size_t i = 0u;
+        for(;i + width <= size;i += width){
+            V v;
+            std::memcpy(&v, values + i, sizeof(V));
+            V x = v;
+            auto inside = (x > table.begin) & (x < table.end);
+            if(table.periodic){
+                V q = (x - table.begin) / period;
+                inside = vabs(q) < maxQuotient;
+                x = x - period * vfloor(inside ? q : splat<V>(0.0));
+            }
+            // the lanes outside of the table read the first interval and are replaced after.
+            V t = (x - table.begin) * table.invStep;
+            t = inside ? t : splat<V>(0.0);
+            // static_cast<std::size_t> truncates, the wrapped values can be a rounding below begin.
+            V index = vfloor(t);
+            index = index < 0.0 ? splat<V>(0.0) : index;
+            index = index > last ? splat<V>(last) : index;
+            V f = t - index;
+            auto n = toInt(index);
+            V lower;
+            V upper;
+            for(auto k=0u;k<width;++k){
+                lower[k] = data[n[k]];
+                upper[k] = data[n[k] + 1];
+            }
+            V r = lower + (upper - lower) * f;
+            if(!table.periodic){
+                r = x >= table.end ? table.high + table.highSlope * x : r;
+                r = x <= table.begin ? splat<V>(table.low) : r;
+                r = x != x ? x : r;
+            }
+            std::memcpy(outputs + i, &r, sizeof(V));
+            if(table.periodic){
+                for(auto k=0u;k<width;++k){
+                    if(!inside[k]){
+                        outputs[i + k] = table.evaluate(v[k]);
+                    }
+                }
+            }
+        }
+        for(;i<size;++i){
+            outputs[i] = table.evaluate(values[i]);
+        }
+    }
+    // without fma, a contracted interpolation wouldn't round like Table::evaluate.
+    template<typename Table>
+    __attribute__((target("avx2"))) void lookupAvx2(const Table& table, const double* values, double* outputs, std::size_t size) noexcept{
+        lookupSimd<v4d>(table, values, outputs, size);
+    }
+    template<typename Table>
+    void lookupSse2(const Table& table, const double* values, double* outputs, std::size_t size) noexcept{
+        lookupSimd<v2d>(table, values, outputs, size);
+    }
+    #define EVOAI_SIMD_APPLY(expr) \
+        template<typename V> \
+        static EVOAI_SIMD_INLINE V apply([[maybe_unused]] V v, [[maybe_unused]] ScalarOf<V> b) noexcept{ return expr; }
+#else
+    #define EVOAI_SIMD_APPLY(expr)
+#endif
+    SimdLevel detectSimdLevel() noexcept{
+#if defined(EVOAI_SIMD_X86)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+    std::atomic<SimdLevel>& currentSimdLevel() noexcept{
+        static std::atomic<SimdLevel> level{detectSimdLevel()};
+        return level;
+    }
+    /**
+     * @brief applies Op to each value with the current SimdLevel, T is double or float.
+     * Op has a static double scalar(double v, double b) and a static template<typename V> V apply(V v, ScalarOf<V> b),
+     * the float vectors are evaluated in single precision and the scalar version in double.
+     */
+    template<typename Op, typename T>
+    void transform(const T* values, T* outputs, std::size_t size, double b = 0.0) noexcept{
+#if defined(EVOAI_SIMD_X86)
+        switch(currentSimdLevel().load(std::memory_order_relaxed)){
+            case SimdLevel::AVX2:
+                transformAvx2<Op>(values, outputs, size, b);
+                return;
+            case SimdLevel::SSE2:
+                transformSse2<Op>(values, outputs, size, b);
+                return;
+            case SimdLevel::SCALAR:
+                break;
+        }
+#endif
+        for(auto i=0u;i<size;++i){
+            outputs[i] = static_cast<T>(Op::scalar(values[i], b));
+        }
+    }
+    template<typename T, typename Fn>
+    void transformScalar(const T* values, T* outputs, std::size_t size, Fn&& fn) noexcept{
+        for(auto i=0u;i<size;++i){
+            outputs[i] = static_cast<T>(fn(values[i]));
+        }
+    }
+    /**
+     * @brief evaluates a LookupTable::Table with the current SimdLevel, the results are the ones of Table::evaluate.
+     */
+    template<typename Table>
+    void lookup(const Table& table, const double* values, double* outputs, std::size_t size) noexcept{
+#if defined(EVOAI_SIMD_X86)
+        switch(currentSimdLevel().load(std::memory_order_relaxed)){
+            case SimdLevel::AVX2:
+                lookupAvx2(table, values, outputs, size);
+                return;
+            case SimdLevel::SSE2:
+                lookupSse2(table, values, outputs, size);
+                return;
+            case SimdLevel::SCALAR:
+                break;
+        }
+#endif
+        for(auto i=0u;i<size;++i){
+            outputs[i] = table.evaluate(values[i]);
+        }
+    }
+    /**
+     * @brief converts the float arrays to double in chunks and calls fn(const double* const*, double*, std::size_t) on each chunk.
+     */
+    template<std::size_t N, typename Fn>
+    void throughDouble(const float* const (&values)[N], float* outputs, std::size_t size, Fn&& fn) noexcept{
+        constexpr std::size_t chunk = 256u;
+        double in[N][chunk];
+        double out[chunk];
+        const double* ins[N];
+        for(auto k=0u;k<N;++k){
+            ins[k] = in[k];
+        }
+        for(std::size_t i=0u;i<size;i+=chunk){
+            auto count = std::min(chunk, size - i);
+            for(auto k=0u;k<N;++k){
+                std::copy_n(values[k] + i, count, in[k]);
+            }
+            fn(ins, out, count);
+            std::copy_n(out, count, outputs + i);
+        }
+    }
+    namespace Act = EvoAI::Activations;
+    namespace Der = EvoAI::Derivatives;
+    namespace ActivationOps{
+        struct Identity{
+            static double scalar(double v, double) noexcept{ return Act::identity(v); }
+            EVOAI_SIMD_APPLY(v)
+        };
+        struct Sigmoid{
+            static double scalar(double v, double) noexcept{ return Act::sigmoid(v); }
+            EVOAI_SIMD_APPLY(vsigmoid(v))
+        };
+        struct SteepenedSigmoid{
+            static double scalar(double v, double) noexcept{ return Act::steepenedSigmoid(v); }
+            EVOAI_SIMD_APPLY(1.0 / (1.0 + vexp(-(splat<V>(4.9) * v))))
+        };
+        struct Swish{
+            static double scalar(double v, double b) noexcept{ return Act::swish(v, b); }
+            EVOAI_SIMD_APPLY(v / (1.0 + vexp(-(b * v))))
+        };
+        struct Tanh{
+            static double scalar(double v, double) noexcept{ return Act::tanh(v); }
+            EVOAI_SIMD_APPLY(vtanh(v))
+        };
+        struct Sinusoid{
+            static double scalar(double v, double) noexcept{ return Act::sinusoid(v); }
+            EVOAI_SIMD_APPLY((vsincos<V, false>(v)))
+        };
+        struct Cosine{
+            static double scalar(double v, double) noexcept{ return Act::cosine(v); }
+            EVOAI_SIMD_APPLY((vsincos<V, true>(v)))
+        };
+        struct Relu{
+            static double scalar(double v, double) noexcept{ return Act::relu(v); }
+            EVOAI_SIMD_APPLY(0.0 < v ? v : splat<V>(0.0))
+        };
+        struct LeakyRelu{
+            static double scalar(double v, double) noexcept{ return Act::leakyRelu(v); }
+            EVOAI_SIMD_APPLY(v > 0.0 ? v : splat<V>(0.01) * v)
+        };
+        struct Exponential{
+            static double scalar(double v, double) noexcept{ return Act::exponential(v); }
+            EVOAI_SIMD_APPLY(vexp(v))
+        };
+        struct Gaussian{
+            static double scalar(double v, double) noexcept{ return Act::gaussian(v); }
+            EVOAI_SIMD_APPLY(v * (0.5 * (1.0 + vtanh(splat<V>(std::sqrt(2.0 / EvoAI::PI)) * (v + splat<V>(0.044715) * (v * v * v))))))
+        };
+        struct Square{
+            static double scalar(double v, double) noexcept{ return Act::square(v); }
+            EVOAI_SIMD_APPLY(v * v)
+        };
+        struct Cube{
+            static double scalar(double v, double) noexcept{ return Act::cube(v); }
+            EVOAI_SIMD_APPLY(v * v * v)
+        };
+        struct Softplus{
+            static double scalar(double v, double) noexcept{ return Act::softplus(v); }
+            EVOAI_SIMD_APPLY(vlog(1.0 + vexp(-vabs(v))) + (0.0 < v ? v : splat<V>(0.0)))
+        };
+        struct Clamp{
+            static double scalar(double v, double) noexcept{ return Act::clamp(v); }
+            EVOAI_SIMD_APPLY(v < -1.0 ? splat<V>(-1.0) : (1.0 < v ? splat<V>(1.0) : v))
+        };
+        struct Inv{
+            static double scalar(double v, double) noexcept{ return Act::inv(v); }
+            EVOAI_SIMD_APPLY(-v)
+        };
+        struct Log{
+            static double scalar(double v, double) noexcept{ return Act::log(v); }
+            EVOAI_SIMD_APPLY(vlog(v))
+        };
+        struct Abs{
+            static double scalar(double v, double) noexcept{ return Act::abs(v); }
+            EVOAI_SIMD_APPLY(vabs(v))
+        };
+        struct Hat{
+            static double scalar(double v, double) noexcept{ return Act::hat(v); }
+            EVOAI_SIMD_APPLY(0.0 < 1.0 - vabs(v) ? 1.0 - vabs(v) : splat<V>(0.0))
+        };
+    }
+    namespace DerivativeOps{
+        struct Identity{
+            static double scalar(double v, double) noexcept{ return Der::identity(v); }
+            EVOAI_SIMD_APPLY(splat<V>(1.0))
+        };
+        struct Sigmoid{
+            static double scalar(double v, double) noexcept{ return Der::sigmoid(v); }
+            EVOAI_SIMD_APPLY(vsigmoidDerivative(v))
+        };
+        struct SteepenedSigmoid{
+            static double scalar(double v, double) noexcept{ return Der::steepenedSigmoid(v); }
+            EVOAI_SIMD_APPLY(vsigmoidDerivative(v))
+        };
+        struct Swish{
+            static double scalar(double v, double b) noexcept{ return Der::swish(v, b); }
+            EVOAI_SIMD_APPLY(vswishDerivative(v))
+        };
+        struct Tanh{
+            static double scalar(double v, double) noexcept{ return Der::tanh(v); }
+            EVOAI_SIMD_APPLY(vtanhDerivative(v))
+        };
+        struct Sinusoid{
+            static double scalar(double v, double) noexcept{ return Der::sinusoid(v); }
+            EVOAI_SIMD_APPLY((vsincos<V, true>(v)))
+        };
+        struct Cosine{
+            static double scalar(double v, double) noexcept{ return Der::cosine(v); }
+            EVOAI_SIMD_APPLY((-vsincos<V, false>(v)))
+        };
+        struct Relu{
+            static double scalar(double v, double) noexcept{ return Der::relu(v); }
+            EVOAI_SIMD_APPLY(v > 0.0 ? splat<V>(1.0) : splat<V>(0.0))
+        };
+        struct LeakyRelu{
+            static double scalar(double v, double) noexcept{ return Der::leakyRelu(v); }
+            EVOAI_SIMD_APPLY(v > 0.0 ? splat<V>(1.0) : splat<V>(0.0))
+        };
+        struct Exponential{
+            static double scalar(double v, double) noexcept{ return Der::exponential(v); }
+            EVOAI_SIMD_APPLY(vexp(v))
+        };
+        struct Square{
+            static double scalar(double v, double) noexcept{ return Der::square(v); }
+            EVOAI_SIMD_APPLY(2.0 * v)
+        };
+        struct Cube{
+            static double scalar(double v, double) noexcept{ return Der::cube(v); }
+            EVOAI_SIMD_APPLY(3.0 * v * v)
+        };
+        struct Softplus{
+            static double scalar(double v, double) noexcept{ return Der::softplus(v); }
+            EVOAI_SIMD_APPLY(vsigmoid(v))
+        };
+        struct Clamp{
+            static double scalar(double v, double) noexcept{ return Der::clamp(v); }
+            EVOAI_SIMD_APPLY((v < -1.0) | (v > 1.0) ? splat<V>(0.0) : splat<V>(1.0))
+        };
+        struct Inv{
+            static double scalar(double v, double) noexcept{ return Der::inv(v); }
+            EVOAI_SIMD_APPLY(splat<V>(-1.0))
+        };
+        struct Log{
+            static double scalar(double v, double) noexcept{ return Der::log(v); }
+            EVOAI_SIMD_APPLY(1.0 / v)
+        };
+        struct Abs{
+            static double scalar(double v, double) noexcept{ return Der::abs(v); }
+            EVOAI_SIMD_APPLY(vabs(v) / v)
+        };
+        struct Hat{
+            static double scalar(double v, double) noexcept{ return Der::hat(v); }
+            EVOAI_SIMD_APPLY(v > 0.0 ? 1.0 - (vabs(v) / v) : splat<V>(0.0))
+        };
+    }
+    /**
+     * @brief Activations::Array::activate for double and float arrays.
+     */
+    template<typename T>
+    void activateArray(EvoAI::Neuron::ActivationType at, const T* values, T* outputs, std::size_t size, double b) noexcept{
+        using ActivationType = EvoAI::Neuron::ActivationType;
+        switch(at){
+            case ActivationType::IDENTITY:
+                transform<ActivationOps::Identity>(values, outputs, size);
+                return;
+            case ActivationType::MODULUS:
+                transformScalar(values, outputs, size, [](double v){
+                    return Act::modulus(v, 2.0);
+                });
+                return;
+            case ActivationType::TANH:
+                transform<ActivationOps::Tanh>(values, outputs, size);
+                return;
+            case ActivationType::SINUSOID:
+                transform<ActivationOps::Sinusoid>(values, outputs, size);
+                return;
+            case ActivationType::COSINE:
+                transform<ActivationOps::Cosine>(values, outputs, size);
+                return;
+            case ActivationType::TAN:
+                transformScalar(values, outputs, size, [](double v){
+                    return Act::tan(v);
+                });
+                return;
+            case ActivationType::SIGMOID:
+                transform<ActivationOps::Sigmoid>(values, outputs, size);
+                return;
+            case ActivationType::RELU:
+                transform<ActivationOps::Relu>(values, outputs, size);
+                return;
+            case ActivationType::NOISY_RELU:
+                transformScalar(values, outputs, size, [](double v){
+                    return Act::noisyRelu(v);
+                });
+                return;
+            case ActivationType::LEAKY_RELU:
+                transform<ActivationOps::LeakyRelu>(values, outputs, size);
+                return;
+            case ActivationType::EXPONENTIAL:
+                transform<ActivationOps::Exponential>(values, outputs, size);
+                return;
+            case ActivationType::SOFTMAX:
+                transform<ActivationOps::Identity>(values, outputs, size);
+                return;
+            case ActivationType::GAUSSIAN:
+                transform<ActivationOps::Gaussian>(values, outputs, size);
+                return;
+            case ActivationType::STEPPED_SIGMOID:
+                transform<ActivationOps::SteepenedSigmoid>(values, outputs, size);
+                return;
+            case ActivationType::SWISH:
+                transform<ActivationOps::Swish>(values, outputs, size, b);
+                return;
+            case ActivationType::SQUARE:
+                transform<ActivationOps::Square>(values, outputs, size);
+                return;
+            case ActivationType::CUBE:
+                transform<ActivationOps::Cube>(values, outputs, size);
+                return;
+            case ActivationType::SOFTPLUS:
+                transform<ActivationOps::Softplus>(values, outputs, size);
+                return;
+            case ActivationType::CLAMP:
+                transform<ActivationOps::Clamp>(values, outputs, size);
+                return;
+            case ActivationType::INV:
+                transform<ActivationOps::Inv>(values, outputs, size);
+                return;
+            case ActivationType::LOG:
+                transform<ActivationOps::Log>(values, outputs, size);
+                return;
+            case ActivationType::ABS:
+                transform<ActivationOps::Abs>(values, outputs, size);
+                return;
+            case ActivationType::HAT:
+                transform<ActivationOps::Hat>(values, outputs, size);
+                return;
+            case ActivationType::LAST_CPPN_ACTIVATION_TYPE:
+                break;
+        }
+        transform<ActivationOps::Sigmoid>(values, outputs, size);
+    }
+    /**
+     * @brief Derivatives::Array::derivate for double and float arrays.
+     */
+    template<typename T>
+    void derivateArray(EvoAI::Neuron::ActivationType at, const T* sums, const T* outputs, const T* gradients,
+                        T* results, std::size_t size, double b) noexcept{
+        using ActivationType = EvoAI::Neuron::ActivationType;
+        switch(at){
+            case ActivationType::IDENTITY:
+                transform<DerivativeOps::Identity>(outputs, results, size);
+                return;
+            case ActivationType::MODULUS:
+                transformScalar(sums, results, size, [](double v){
+                    return Der::modulus(v, 2.0);
+                });
+                return;
+            case ActivationType::SIGMOID:
+                transform<DerivativeOps::Sigmoid>(sums, results, size);
+                return;
+            case ActivationType::SINUSOID:
+                transform<DerivativeOps::Sinusoid>(sums, results, size);
+                return;
+            case ActivationType::RELU:
+                transform<DerivativeOps::Relu>(outputs, results, size);
+                return;
+            case ActivationType::NOISY_RELU:
+                transformScalar(sums, results, size, [](double v){
+                    return Der::noisyRelu(v);
+                });
+                return;
+            case ActivationType::LEAKY_RELU:
+                transform<DerivativeOps::LeakyRelu>(sums, results, size);
+                return;
+            case ActivationType::EXPONENTIAL:
+                transform<DerivativeOps::Exponential>(sums, results, size);
+                return;
+            case ActivationType::SOFTMAX:
+                if(gradients != results){
+                    std::copy_n(gradients, size, results);
+                }
+                return;
+            case ActivationType::TANH:
+                transform<DerivativeOps::Tanh>(sums, results, size);
+                return;
+            case ActivationType::COSINE:
+                transform<DerivativeOps::Cosine>(sums, results, size);
+                return;
+            case ActivationType::TAN:
+                transformScalar(sums, results, size, [](double v){
+                    return Der::tan(v);
+                });
+                return;
+            case ActivationType::GAUSSIAN:
+                transformScalar(outputs, results, size, [](double v){
+                    return Der::gaussian(v);
+                });
+                return;
+            case ActivationType::STEPPED_SIGMOID:
+                transform<DerivativeOps::SteepenedSigmoid>(outputs, results, size);
+                return;
+            case ActivationType::SWISH:
+                transform<DerivativeOps::Swish>(sums, results, size, b);
+                return;
+            case ActivationType::SQUARE:
+                transform<DerivativeOps::Square>(sums, results, size);
+                return;
+            case ActivationType::CUBE:
+                transform<DerivativeOps::Cube>(sums, results, size);
+                return;
+            case ActivationType::SOFTPLUS:
+                transform<DerivativeOps::Softplus>(sums, results, size);
+                return;
+            case ActivationType::CLAMP:
+                transform<DerivativeOps::Clamp>(sums, results, size);
+                return;
+            case ActivationType::INV:
+                transform<DerivativeOps::Inv>(sums, results, size);
+                return;
+            case ActivationType::LOG:
+                transform<DerivativeOps::Log>(sums, results, size);
+                return;
+            case ActivationType::ABS:
+                transform<DerivativeOps::Abs>(sums, results, size);
+                return;
+            case ActivationType::HAT:
+                transform<DerivativeOps::Hat>(sums, results, size);
+                return;
+            case ActivationType::LAST_CPPN_ACTIVATION_TYPE:
+                break;
+        }
+        transform<DerivativeOps::Sigmoid>(outputs, results, size);
+    }
+}
+
 namespace EvoAI{
     double Activations::identity(double v) noexcept{
         return v;
@@ -46,8 +908,9 @@ namespace EvoAI{
             [](auto& a, auto& b){
                 return a.getOutput() < b.getOutput();
         });
+        auto maxOutput = max->getOutput();
         for(auto& n:outputs.getNeurons()){
-            n.setOutput(std::exp(n.getOutput() - max->getOutput()));
+            n.setOutput(std::exp(n.getOutput() - maxOutput));
         }
         auto totalSum = std::accumulate(std::begin(outputs.getNeurons()), std::end(outputs.getNeurons()), 0.0, 
                         [](auto& a, auto& b){
@@ -57,6 +920,19 @@ namespace EvoAI{
             n.setOutput(n.getOutput() / totalSum);
         }
     }
+    void Activations::softmax(double* values, std::size_t size) noexcept{
+        if(size == 0u){
+            return;
+        }
+        auto max = *std::max_element(values, values + size);
+        for(auto i=0u;i<size;++i){
+            values[i] = std::exp(values[i] - max);
+        }
+        auto totalSum = std::accumulate(values, values + size, 0.0);
+        for(auto i=0u;i<size;++i){
+            values[i] = values[i] / totalSum;
+        }
+    }
     double Activations::gaussian(double v) noexcept{
         const double sqpi = std::sqrt(2.0 / EvoAI::PI);
         double cdf = 0.5 * (1.0 + std::tanh(sqpi * (v + 0.044715 * std::pow(v, 3))));
@@ -90,6 +966,260 @@ namespace EvoAI{
     double Activations::hat(double v) noexcept{
         return std::max(0.0, 1.0 - std::abs(v));
     }
+    double Activations::activate(Neuron::ActivationType at, double v, double b) noexcept{
+        switch(at){
+            case Neuron::ActivationType::IDENTITY:
+                return Activations::identity(v);
+            case Neuron::ActivationType::MODULUS:
+                return Activations::modulus(v, 2.0);
+            case Neuron::ActivationType::TANH:
+                return Activations::tanh(v);
+            case Neuron::ActivationType::SINUSOID:
+                return Activations::sinusoid(v);
+            case Neuron::ActivationType::COSINE:
+                return Activations::cosine(v);
+            case Neuron::ActivationType::TAN:
+                return Activations::tan(v);
+            case Neuron::ActivationType::SIGMOID:
+                return Activations::sigmoid(v);
+            case Neuron::ActivationType::RELU:
+                return Activations::relu(v);
+            case Neuron::ActivationType::NOISY_RELU:
+                return Activations::noisyRelu(v);
+            case Neuron::ActivationType::LEAKY_RELU:
+                return Activations::leakyRelu(v);
+            case Neuron::ActivationType::EXPONENTIAL:
+                return Activations::exponential(v);
+            case Neuron::ActivationType::SOFTMAX:
+                return Activations::identity(v);
+            case Neuron::ActivationType::GAUSSIAN:
+                return Activations::gaussian(v);
+            case Neuron::ActivationType::STEPPED_SIGMOID:
+                return Activations::steepenedSigmoid(v);
+            case Neuron::ActivationType::SWISH:
+                return Activations::swish(v, b);
+            case Neuron::ActivationType::SQUARE:
+                return Activations::square(v);
+            case Neuron::ActivationType::CUBE:
+                return Activations::cube(v);
+            case Neuron::ActivationType::SOFTPLUS:
+                return Activations::softplus(v);
+            case Neuron::ActivationType::CLAMP:
+                return Activations::clamp(v);
+            case Neuron::ActivationType::INV:
+                return Activations::inv(v);
+            case Neuron::ActivationType::LOG:
+                return Activations::log(v);
+            case Neuron::ActivationType::ABS:
+                return Activations::abs(v);
+            case Neuron::ActivationType::HAT:
+                return Activations::hat(v);
+            case Neuron::ActivationType::LAST_CPPN_ACTIVATION_TYPE:
+                break;
+        }
+        return Activations::sigmoid(v);
+    }
+// arrays
+    Activations::Array::SimdLevel Activations::Array::getSupportedSimdLevel() noexcept{
+        static const auto level = detectSimdLevel();
+        return level;
+    }
+    Activations::Array::SimdLevel Activations::Array::getSimdLevel() noexcept{
+        return currentSimdLevel().load();
+    }
+    void Activations::Array::setSimdLevel(SimdLevel level) noexcept{
+        currentSimdLevel().store(std::min(level, getSupportedSimdLevel()));
+    }
+    void Activations::Array::identity(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Identity>(values, outputs, size);
+    }
+    void Activations::Array::sigmoid(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Sigmoid>(values, outputs, size);
+    }
+    void Activations::Array::steepenedSigmoid(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::SteepenedSigmoid>(values, outputs, size);
+    }
+    void Activations::Array::swish(const double* values, double* outputs, std::size_t size, double b) noexcept{
+        transform<ActivationOps::Swish>(values, outputs, size, b);
+    }
+    void Activations::Array::tanh(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Tanh>(values, outputs, size);
+    }
+    void Activations::Array::sinusoid(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Sinusoid>(values, outputs, size);
+    }
+    void Activations::Array::cosine(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Cosine>(values, outputs, size);
+    }
+    void Activations::Array::tan(const double* values, double* outputs, std::size_t size) noexcept{
+        transformScalar(values, outputs, size, [](double v){
+            return Activations::tan(v);
+        });
+    }
+    void Activations::Array::relu(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Relu>(values, outputs, size);
+    }
+    void Activations::Array::noisyRelu(const double* values, double* outputs, std::size_t size) noexcept{
+        transformScalar(values, outputs, size, [](double v){
+            return Activations::noisyRelu(v);
+        });
+    }
+    void Activations::Array::leakyRelu(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::LeakyRelu>(values, outputs, size);
+    }
+    void Activations::Array::exponential(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Exponential>(values, outputs, size);
+    }
+    void Activations::Array::gaussian(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Gaussian>(values, outputs, size);
+    }
+    void Activations::Array::modulus(const double* values, double* outputs, std::size_t size, double div) noexcept{
+        transformScalar(values, outputs, size, [div](double v){
+            return Activations::modulus(v, div);
+        });
+    }
+    void Activations::Array::square(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Square>(values, outputs, size);
+    }
+    void Activations::Array::cube(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Cube>(values, outputs, size);
+    }
+    void Activations::Array::softplus(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Softplus>(values, outputs, size);
+    }
+    void Activations::Array::clamp(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Clamp>(values, outputs, size);
+    }
+    void Activations::Array::inv(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Inv>(values, outputs, size);
+    }
+    void Activations::Array::log(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Log>(values, outputs, size);
+    }
+    void Activations::Array::abs(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Abs>(values, outputs, size);
+    }
+    void Activations::Array::hat(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<ActivationOps::Hat>(values, outputs, size);
+    }
+    void Activations::Array::activate(Neuron::ActivationType at, const double* values, double* outputs, std::size_t size, double b) noexcept{
+        activateArray(at, values, outputs, size, b);
+    }
+    void Activations::Array::activate(Neuron::ActivationType at, const float* values, float* outputs, std::size_t size, double b) noexcept{
+        activateArray(at, values, outputs, size, b);
+    }
+    Activations::LookupTable::LookupTable(double maxError)
+    : m_maxError(std::clamp(maxError, 1e-9, 0.1))
+    , m_sigmoid()
+    , m_tanh()
+    , m_gaussian()
+    , m_sinusoid()
+    , m_cosine(){
+        // half of the error goes to the interpolation and half to replacing the tails by the asymptotes.
+        auto tailError = m_maxError * 0.5;
+        auto sigmoidRange = std::log(1.0 / tailError);
+        m_sigmoid = makeTable(&Activations::sigmoid, -sigmoidRange, sigmoidRange, 0.1, m_maxError);
+        m_sigmoid.low = 0.0;
+        m_sigmoid.high = 1.0;
+        auto tanhRange = 0.5 * std::log(2.0 / tailError);
+        m_tanh = makeTable(&Activations::tanh, -tanhRange, tanhRange, 0.77, m_maxError);
+        m_tanh.low = -1.0;
+        m_tanh.high = 1.0;
+        auto gaussianRange = 1.0;
+        while(std::abs(Activations::gaussian(-gaussianRange)) > tailError ||
+                std::abs(Activations::gaussian(gaussianRange) - gaussianRange) > tailError){
+            gaussianRange += 0.25;
+        }
+        m_gaussian = makeTable(&Activations::gaussian, -gaussianRange, gaussianRange, 1.0, m_maxError);
+        m_gaussian.low = 0.0;
+        m_gaussian.high = 0.0;
+        m_gaussian.highSlope = 1.0;
+        m_sinusoid = makeTable(&Activations::sinusoid, 0.0, 2.0 * EvoAI::PI, 1.0, m_maxError);
+        m_sinusoid.periodic = true;
+        m_cosine = makeTable(&Activations::cosine, 0.0, 2.0 * EvoAI::PI, 1.0, m_maxError);
+        m_cosine.periodic = true;
+    }
+    bool Activations::LookupTable::isApproximated(Neuron::ActivationType at) noexcept{
+        return at == Neuron::ActivationType::SIGMOID || at == Neuron::ActivationType::TANH ||
+                at == Neuron::ActivationType::GAUSSIAN || at == Neuron::ActivationType::SINUSOID ||
+                at == Neuron::ActivationType::COSINE;
+    }
+    double Activations::LookupTable::activate(Neuron::ActivationType at, double v, double b) const noexcept{
+        auto table = tableFor(at);
+        if(table){
+            return table->evaluate(v);
+        }
+        return Activations::activate(at, v, b);
+    }
+    void Activations::LookupTable::activate(Neuron::ActivationType at, const double* values, double* outputs, std::size_t size, double b) const noexcept{
+        auto table = tableFor(at);
+        if(!table){
+            Activations::Array::activate(at, values, outputs, size, b);
+            return;
+        }
+        lookup(*table, values, outputs, size);
+    }
+    void Activations::LookupTable::activate(Neuron::ActivationType at, const float* values, float* outputs, std::size_t size, double b) const noexcept{
+        auto table = tableFor(at);
+        if(!table){
+            Activations::Array::activate(at, values, outputs, size, b);
+            return;
+        }
+        const float* ins[] = {values};
+        throughDouble(ins, outputs, size, [&](const double* const* in, double* out, std::size_t count){
+            lookup(*table, in[0], out, count);
+        });
+    }
+    std::size_t Activations::LookupTable::memoryUsage() const noexcept{
+        return sizeof(LookupTable) + (m_sigmoid.values.capacity() + m_tanh.values.capacity() + m_gaussian.values.capacity() +
+                                        m_sinusoid.values.capacity() + m_cosine.values.capacity()) * sizeof(double);
+    }
+    double Activations::LookupTable::Table::evaluate(double v) const noexcept{
+        if(periodic){
+            if(!std::isfinite(v)){
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            auto period = end - begin;
+            v -= period * std::floor((v - begin) / period);
+        }else if(!(v > begin)){
+            return std::isnan(v) ? v : low;
+        }else if(v >= end){
+            return high + highSlope * v;
+        }
+        auto t = (v - begin) * invStep;
+        auto i = std::min(static_cast<std::size_t>(t), values.size() - 2u);
+        auto f = t - static_cast<double>(i);
+        return values[i] + (values[i + 1] - values[i]) * f;
+    }
+    Activations::LookupTable::Table Activations::LookupTable::makeTable(double(*f)(double), double begin, double end,
+                                                                        double maxSecondDerivative, double maxError){
+        // linear interpolation error is at most step^2 * max|f''| / 8, it uses half of maxError.
+        auto step = std::sqrt(4.0 * maxError / maxSecondDerivative);
+        auto size = static_cast<std::size_t>(std::ceil((end - begin) / step)) + 1u;
+        size = std::max<std::size_t>(size, 2u);
+        step = (end - begin) / static_cast<double>(size - 1u);
+        Table table{begin, end, 1.0 / step, 0.0, 0.0, 0.0, false, std::vector<double>(size)};
+        for(auto i=0u;i<size;++i){
+            table.values[i] = f(begin + static_cast<double>(i) * step);
+        }
+        return table;
+    }
+    const Activations::LookupTable::Table* Activations::LookupTable::tableFor(Neuron::ActivationType at) const noexcept{
+        switch(at){
+            case Neuron::ActivationType::SIGMOID:
+                return &m_sigmoid;
+            case Neuron::ActivationType::TANH:
+                return &m_tanh;
+            case Neuron::ActivationType::GAUSSIAN:
+                return &m_gaussian;
+            case Neuron::ActivationType::SINUSOID:
+                return &m_sinusoid;
+            case Neuron::ActivationType::COSINE:
+                return &m_cosine;
+            default:
+                return nullptr;
+        }
+    }
 // derivatives
     double Derivatives::identity([[maybe_unused]] double v) noexcept{
         return 1.0;
@@ -180,4 +1310,140 @@ namespace EvoAI{
     double Derivatives::hat(double v) noexcept{
         return (v > 0.0 ? (1.0 - (std::abs(v) / v)) : 0.0);
     }
+    double Derivatives::derivate(Neuron::ActivationType at, double sum, double output, double b, double gradient) noexcept{
+        switch(at){
+            case Neuron::ActivationType::IDENTITY:
+                return Derivatives::identity(output);
+            case Neuron::ActivationType::MODULUS:
+                return Derivatives::modulus(sum, 2.0);
+            case Neuron::ActivationType::SIGMOID:
+                return Derivatives::sigmoid(sum);
+            case Neuron::ActivationType::SINUSOID:
+                return Derivatives::sinusoid(sum);
+            case Neuron::ActivationType::RELU:
+                return Derivatives::relu(output);
+            case Neuron::ActivationType::NOISY_RELU:
+                return Derivatives::noisyRelu(sum);
+            case Neuron::ActivationType::LEAKY_RELU:
+                return Derivatives::leakyRelu(sum);
+            case Neuron::ActivationType::EXPONENTIAL:
+                return Derivatives::exponential(sum);
+            case Neuron::ActivationType::SOFTMAX:
+                return gradient;
+            case Neuron::ActivationType::TANH:
+                return Derivatives::tanh(sum);
+            case Neuron::ActivationType::COSINE:
+                return Derivatives::cosine(sum);
+            case Neuron::ActivationType::TAN:
+                return Derivatives::tan(sum);
+            case Neuron::ActivationType::GAUSSIAN:
+                return Derivatives::gaussian(output);
+            case Neuron::ActivationType::STEPPED_SIGMOID:
+                return Derivatives::steepenedSigmoid(output);
+            case Neuron::ActivationType::SWISH:
+                return Derivatives::swish(sum, b);
+            case Neuron::ActivationType::SQUARE:
+                return Derivatives::square(sum);
+            case Neuron::ActivationType::CUBE:
+                return Derivatives::cube(sum);
+            case Neuron::ActivationType::SOFTPLUS:
+                return Derivatives::softplus(sum);
+            case Neuron::ActivationType::CLAMP:
+                return Derivatives::clamp(sum);
+            case Neuron::ActivationType::INV:
+                return Derivatives::inv(sum);
+            case Neuron::ActivationType::LOG:
+                return Derivatives::log(sum);
+            case Neuron::ActivationType::ABS:
+                return Derivatives::abs(sum);
+            case Neuron::ActivationType::HAT:
+                return Derivatives::hat(sum);
+            case Neuron::ActivationType::LAST_CPPN_ACTIVATION_TYPE:
+                break;
+        }
+        return Derivatives::sigmoid(output);
+    }
+// derivatives arrays
+    void Derivatives::Array::identity(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Identity>(values, outputs, size);
+    }
+    void Derivatives::Array::sigmoid(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Sigmoid>(values, outputs, size);
+    }
+    void Derivatives::Array::steepenedSigmoid(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::SteepenedSigmoid>(values, outputs, size);
+    }
+    void Derivatives::Array::swish(const double* values, double* outputs, std::size_t size, double b) noexcept{
+        transform<DerivativeOps::Swish>(values, outputs, size, b);
+    }
+    void Derivatives::Array::tanh(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Tanh>(values, outputs, size);
+    }
+    void Derivatives::Array::sinusoid(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Sinusoid>(values, outputs, size);
+    }
+    void Derivatives::Array::cosine(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Cosine>(values, outputs, size);
+    }
+    void Derivatives::Array::tan(const double* values, double* outputs, std::size_t size) noexcept{
+        transformScalar(values, outputs, size, [](double v){
+            return Derivatives::tan(v);
+        });
+    }
+    void Derivatives::Array::relu(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Relu>(values, outputs, size);
+    }
+    void Derivatives::Array::noisyRelu(const double* values, double* outputs, std::size_t size) noexcept{
+        transformScalar(values, outputs, size, [](double v){
+            return Derivatives::noisyRelu(v);
+        });
+    }
+    void Derivatives::Array::leakyRelu(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::LeakyRelu>(values, outputs, size);
+    }
+    void Derivatives::Array::exponential(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Exponential>(values, outputs, size);
+    }
+    void Derivatives::Array::gaussian(const double* values, double* outputs, std::size_t size) noexcept{
+        transformScalar(values, outputs, size, [](double v){
+            return Derivatives::gaussian(v);
+        });
+    }
+    void Derivatives::Array::modulus(const double* values, double* outputs, std::size_t size, double div) noexcept{
+        transformScalar(values, outputs, size, [div](double v){
+            return Derivatives::modulus(v, div);
+        });
+    }
+    void Derivatives::Array::square(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Square>(values, outputs, size);
+    }
+    void Derivatives::Array::cube(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Cube>(values, outputs, size);
+    }
+    void Derivatives::Array::softplus(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Softplus>(values, outputs, size);
+    }
+    void Derivatives::Array::clamp(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Clamp>(values, outputs, size);
+    }
+    void Derivatives::Array::inv(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Inv>(values, outputs, size);
+    }
+    void Derivatives::Array::log(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Log>(values, outputs, size);
+    }
+    void Derivatives::Array::abs(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Abs>(values, outputs, size);
+    }
+    void Derivatives::Array::hat(const double* values, double* outputs, std::size_t size) noexcept{
+        transform<DerivativeOps::Hat>(values, outputs, size);
+    }
+    void Derivatives::Array::derivate(Neuron::ActivationType at, const double* sums, const double* outputs, const double* gradients,
+                                        double* results, std::size_t size, double b) noexcept{
+        derivateArray(at, sums, outputs, gradients, results, size, b);
+    }
+    void Derivatives::Array::derivate(Neuron::ActivationType at, const float* sums, const float* outputs, const float* gradients,
+                                        float* results, std::size_t size, double b) noexcept{
+        derivateArray(at, sums, outputs, gradients, results, size, b);
+    }
 }
@@ -0,0 +1,269 @@
+#include <EvoAI/CodeGeneration.hpp>
+#include <EvoAI/Utils/MathUtils.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+#include <cctype>
+#include <map>
+
+namespace{
+    /**
+     * @brief name and definition of the function that computes the activation like Activations::activate.
+     */
+    struct ActivationSource{
+        const char* name;
+        const char* body;
+    };
+    ActivationSource activationSource(EvoAI::Neuron::ActivationType at) noexcept{
+        using ActivationType = EvoAI::Neuron::ActivationType;
+        switch(at){
+            case ActivationType::IDENTITY:
+            case ActivationType::SOFTMAX:
+                return {"identity", "return v;"};
+            case ActivationType::MODULUS:
+                return {"modulus", "return std::fmod(v, 2.0);"};
+            case ActivationType::TANH:
+                return {"tanh", "return std::tanh(v);"};
+            case ActivationType::SINUSOID:
+                return {"sinusoid", "return std::sin(v);"};
+            case ActivationType::COSINE:
+                return {"cosine", "return std::cos(v);"};
+            case ActivationType::TAN:
+                return {"tan", "return std::tan(v);"};
+            case ActivationType::RELU:
+                return {"relu", "return std::max(0.0, v);"};
+            case ActivationType::NOISY_RELU:
+                return {"noisyRelu", "thread_local std::mt19937 engine;\n"
+                                     "            std::normal_distribution<double> dis(0.0, 1.0);\n"
+                                     "            return std::max(0.0, v + dis(engine) * 0.01);"};
+            case ActivationType::LEAKY_RELU:
+                return {"leakyRelu", "return (v > 0.0 ? v:(0.01 * v));"};
+            case ActivationType::EXPONENTIAL:
+                return {"exponential", "return std::exp(v);"};
+            case ActivationType::GAUSSIAN:
+                return {"gaussian", "const double sqpi = std::sqrt(2.0 / 3.14159265358979323846);\n"
+                                    "            double cdf = 0.5 * (1.0 + std::tanh(sqpi * (v + 0.044715 * std::pow(v, 3))));\n"
+                                    "            return v * cdf;"};
+            case ActivationType::STEPPED_SIGMOID:
+                return {"steepenedSigmoid", "return (1.0 / (1.0 + std::exp(-(4.9 * v))));"};
+            case ActivationType::SWISH:
+                return {"swish", "return v / (1.0 + std::exp(-(b * v)));"};
+            case ActivationType::SQUARE:
+                return {"square", "return (v * v);"};
+            case ActivationType::CUBE:
+                return {"cube", "return (v * v * v);"};
+            case ActivationType::SOFTPLUS:
+                return {"softplus", "return std::log(1.0 + std::exp(-std::abs(v))) + std::max(0.0, v);"};
+            case ActivationType::CLAMP:
+                return {"clamp", "return std::clamp(v, -1.0, 1.0);"};
+            case ActivationType::INV:
+                return {"inv", "return -v;"};
+            case ActivationType::LOG:
+                return {"log", "return std::log(v);"};
+            case ActivationType::ABS:
+                return {"abs", "return std::abs(v);"};
+            case ActivationType::HAT:
+                return {"hat", "return std::max(0.0, 1.0 - std::abs(v));"};
+            case ActivationType::SIGMOID:
+            case ActivationType::LAST_CPPN_ACTIVATION_TYPE:
+                break;
+        }
+        return {"sigmoid", "return (1.0 / (1.0 + std::exp(-v)));"};
+    }
+    /**
+     * @brief double literal that gives back the same value.
+     */
+    std::string literal(double v){
+        if(std::isnan(v)){
+            return "std::numeric_limits<double>::quiet_NaN()";
+        }
+        if(std::isinf(v)){
+            return v > 0.0 ? "std::numeric_limits<double>::infinity()":"-std::numeric_limits<double>::infinity()";
+        }
+        std::ostringstream out;
+        out << std::setprecision(std::numeric_limits<double>::max_digits10) << v;
+        return out.str();
+    }
+    bool isIdentifier(const std::string& name) noexcept{
+        if(name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))){
+            return false;
+        }
+        return std::all_of(std::begin(name), std::end(name), [](char c){
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        });
+    }
+    /**
+     * @brief writes values as a constexpr array, 8 values per line.
+     */
+    void writeArray(std::ostream& out, const std::string& name, const std::vector<double>& values){
+        if(values.empty()){
+            return;
+        }
+        out << "        constexpr double " << name << "[" << values.size() << "] = {";
+        for(auto i=0u;i<values.size();++i){
+            out << (i % 8u == 0u ? "\n            ":" ") << literal(values[i]) << (i + 1 < values.size() ? ",":"");
+        }
+        out << "\n        };\n";
+    }
+}
+
+namespace EvoAI{
+    std::string generateCpp(const ExecutionPlan& plan, const std::string& name){
+        if(!isIdentifier(name)){
+            return {};
+        }
+        auto size = plan.numNeurons();
+        auto numInputs = plan.numInputs();
+        auto outputBegin = size - plan.numOutputs();
+        auto& types = plan.getTypes();
+        auto& activations = plan.getActivationTypes();
+        auto& rowPtr = plan.getRowPtr();
+        auto& dest = plan.getDestinations();
+        auto& order = plan.getOrder();
+        // only the sums that are read get a variable, the writes to the rest are dropped.
+        std::vector<bool> isRead(size, false);
+        std::vector<std::uint32_t> context;
+        for(auto n=0u;n<size;++n){
+            isRead[n] = rowPtr[n] != rowPtr[n + 1] || n >= outputBegin;
+            if(types[n] == Neuron::Type::CONTEXT && n >= numInputs){
+                isRead[n] = true;
+                context.emplace_back(n);
+            }
+        }
+        // the cycles of the self connections of context neurons go after their sums in context.
+        std::vector<std::uint32_t> cycles;
+        std::map<std::string, const char*> functions;
+        auto call = [&](std::uint32_t n){
+            auto source = activationSource(activations[n]);
+            functions.emplace(source.name, source.body);
+            return "detail::" + std::string(source.name) + "(s" + std::to_string(n) + ", detail::biases[" + std::to_string(n) + "])";
+        };
+        std::ostringstream body;
+        for(auto n:order){
+            auto begin = rowPtr[n];
+            auto end = rowPtr[n + 1];
+            if(begin == end){
+                continue;
+            }
+            auto sn = "s" + std::to_string(n);
+            body << "        // neuron " << n << " " << Neuron::typeToString(types[n]) << "\n";
+            for(auto c=begin;c<end;++c){
+                auto d = dest[c];
+                auto sd = "s" + std::to_string(d);
+                auto w = "detail::weights[" + std::to_string(c) + "]";
+                switch(types[n]){
+                    case Neuron::Type::INPUT:
+                            if(isRead[d]){
+                                body << "        " << sd << " += " << sn << " * " << w << ";\n";
+                            }
+                            break;
+                    case Neuron::Type::HIDDEN:
+                    case Neuron::Type::CONTEXT:
+                            // like NeuralNetwork::run the bias is added and the neuron activated for each connection.
+                            if(types[n] == Neuron::Type::HIDDEN){
+                                body << "        " << sn << " += detail::biases[" << n << "];\n";
+                            }
+                            // a context neuron stores the sum of n, when it is n the weighted output is kept
+                            // until the cycles of the connection go over the limit and it starts again from 0.
+                            if(types[d] == Neuron::Type::CONTEXT && d == n){
+                                auto counter = "context[" + std::to_string(context.size() + cycles.size()) + "]";
+                                cycles.emplace_back(c);
+                                body << "        " << sd << " += " << call(n) << " * " << w << ";\n"
+                                     << "        if(" << counter << " > " << plan.getCyclesLimits()[d] << ".0){\n"
+                                     << "            " << sd << " = 0.0;\n"
+                                     << "            " << counter << " = 0.0;\n"
+                                     << "        }\n"
+                                     << "        " << counter << " += 1.0;\n";
+                            }else if(types[d] == Neuron::Type::CONTEXT){
+                                if(isRead[d]){
+                                    body << "        " << sd << " = " << sn << ";\n";
+                                }
+                            }else if(isRead[d]){
+                                body << "        " << sd << " += " << call(n) << " * " << w << ";\n";
+                            }
+                            break;
+                    case Neuron::Type::OUTPUT:
+                            if(d != n && isRead[d]){
+                                body << "        " << sd << " = " << sn << " + detail::biases[" << n << "];\n";
+                            }
+                            break;
+                }
+            }
+        }
+        for(auto i=0u;i<context.size();++i){
+            body << "        context[" << i << "] = s" << context[i] << ";\n";
+        }
+        for(auto n=outputBegin;n<size;++n){
+            body << "        s" << n << " += detail::biases[" << n << "];\n";
+            body << "        outputs[" << n - outputBegin << "] = " << call(n) << ";\n";
+        }
+        if(plan.hasSoftmax() && size > outputBegin){
+            body << "        // same as Activations::softmax\n"
+                    "        auto max = *std::max_element(outputs, outputs + numOutputs);\n"
+                    "        for(std::size_t i=0u;i<numOutputs;++i){\n"
+                    "            outputs[i] = std::exp(outputs[i] - max);\n"
+                    "        }\n"
+                    "        auto totalSum = 0.0;\n"
+                    "        for(std::size_t i=0u;i<numOutputs;++i){\n"
+                    "            totalSum = totalSum + outputs[i];\n"
+                    "        }\n"
+                    "        for(std::size_t i=0u;i<numOutputs;++i){\n"
+                    "            outputs[i] = outputs[i] / totalSum;\n"
+                    "        }\n";
+        }
+        std::string guard = "EVOAI_GENERATED_";
+        for(auto c:name){
+            guard += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        guard += "_HPP";
+        std::ostringstream out;
+        out << "// Generated by EvoAI, " << numInputs << " inputs, " << plan.numOutputs() << " outputs, "
+            << size << " neurons and " << plan.numConnections() << " connections.\n";
+        out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+        out << "#include <algorithm>\n#include <cmath>\n#include <cstddef>\n#include <limits>\n";
+        if(functions.count("noisyRelu") > 0u){
+            out << "#include <random>\n";
+        }
+        out << "\nnamespace " << name << "{\n";
+        out << "    constexpr std::size_t numInputs = " << numInputs << ";\n";
+        out << "    constexpr std::size_t numOutputs = " << plan.numOutputs() << ";\n";
+        out << "    constexpr std::size_t contextSize = " << context.size() + cycles.size() << ";\n";
+        out << "    namespace detail{\n";
+        auto& weights = plan.getWeights();
+        auto& biases = plan.getBiases();
+        writeArray(out, "weights", weights);
+        writeArray(out, "biases", biases);
+        for(auto& [function, source]:functions){
+            out << "        inline double " << function << "([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{\n"
+                << "            " << source << "\n        }\n";
+        }
+        out << "    }\n";
+        out << "    /**\n"
+               "     * @brief same as NeuralNetwork::forward followed by NeuralNetwork::reset.\n"
+               "     * @param inputs const double* numInputs values\n"
+               "     * @param outputs double* numOutputs values\n"
+               "     * @param context double* contextSize values zeroed before the first call, can be nullptr if contextSize is 0.\n"
+               "     */\n";
+        out << "    inline void forward(const double* inputs, double* outputs, [[maybe_unused]] double* context) noexcept{\n";
+        for(auto n=0u;n<size;++n){
+            if(!isRead[n]){
+                continue;
+            }
+            out << "        double s" << n << " = ";
+            if(n < numInputs){
+                out << "inputs[" << n << "];\n";
+            }else if(types[n] == Neuron::Type::CONTEXT){
+                auto index = std::find(std::begin(context), std::end(context), n) - std::begin(context);
+                out << "context[" << index << "];\n";
+            }else{
+                out << "0.0;\n";
+            }
+        }
+        out << body.str();
+        out << "    }\n}\n\n#endif // " << guard << "\n";
+        return out.str();
+    }
+}
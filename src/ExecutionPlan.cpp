@@ -0,0 +1,1378 @@
+#include <EvoAI/ExecutionPlan.hpp>
+#include <EvoAI/NeuralNetwork.hpp>
+#include <EvoAI/ThreadPool.hpp>
+#include <EvoAI/Optimizers/ParameterBuffer.hpp>
+
+#include <numeric>
+#include <atomic>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+namespace{
+    /**
+     * @brief size of the register tiles used by the dense blocks.
+     */
+    struct DenseTile{
+        static constexpr std::size_t rows = 4u;
+        static constexpr std::size_t lanes = 8u;
+    };
+    /**
+     * @brief adds the sources to a [Rows x Lanes] tile of the dest sums starting at dest j and lane b.
+     * @details the source n row of weights is weights + rowPtr[n], the outputs are [source x L] and the sums [dest x L].
+     */
+    template<typename T, std::size_t Rows, std::size_t Lanes>
+    void denseTile(const T* weights, const std::uint32_t* rowPtr, std::size_t numSrc, const T* outputs,
+                    T* sums, std::size_t L, std::size_t j, std::size_t b) noexcept{
+        T acc[Rows][Lanes];
+        for(std::size_t r=0u;r<Rows;++r){
+            for(std::size_t l=0u;l<Lanes;++l){
+                acc[r][l] = sums[(j + r) * L + b + l];
+            }
+        }
+        for(std::size_t n=0u;n<numSrc;++n){
+            auto w = weights + rowPtr[n] + j;
+            auto out = outputs + n * L + b;
+            for(std::size_t r=0u;r<Rows;++r){
+                auto wr = w[r];
+                for(std::size_t l=0u;l<Lanes;++l){
+                    acc[r][l] += out[l] * wr;
+                }
+            }
+        }
+        for(std::size_t r=0u;r<Rows;++r){
+            for(std::size_t l=0u;l<Lanes;++l){
+                sums[(j + r) * L + b + l] = acc[r][l];
+            }
+        }
+    }
+    /**
+     * @brief same as denseTile for the dests [j0, j1) and lanes [b0, b1) that don't fill a tile.
+     */
+    template<typename T>
+    void denseEdge(const T* weights, const std::uint32_t* rowPtr, std::size_t numSrc, const T* outputs,
+                    T* sums, std::size_t L, std::size_t j0, std::size_t j1, std::size_t b0, std::size_t b1) noexcept{
+        for(auto j=j0;j<j1;++j){
+            for(auto b=b0;b<b1;++b){
+                auto acc = sums[j * L + b];
+                for(std::size_t n=0u;n<numSrc;++n){
+                    acc += outputs[n * L + b] * weights[rowPtr[n] + j];
+                }
+                sums[j * L + b] = acc;
+            }
+        }
+    }
+}
+
+namespace EvoAI{
+    namespace{
+        /**
+         * @brief m_firstPending when no step has loss gradients waiting to be propagated.
+         */
+        constexpr std::size_t NoPending = std::numeric_limits<std::size_t>::max();
+    }
+    template<typename T>
+    BasicExecutionPlan<T>::BasicExecutionPlan()
+    : m_layerOffsets()
+    , m_order()
+    , m_types()
+    , m_activations()
+    , m_biases()
+    , m_cyclesLimits()
+    , m_rowPtr()
+    , m_dest()
+    , m_weights()
+    , m_sums()
+    , m_outputs()
+    , m_cycles()
+    , m_batchSums()
+    , m_batchOutputs()
+    , m_batchGradients()
+    , m_batchCycles()
+    , m_weightGradients()
+    , m_biasGradients()
+    , m_derivatives()
+    , m_denseBlocks()
+    , m_denseBlockOf()
+    , m_activationTable()
+    , m_threadPool()
+    , m_levels()
+    , m_levelOffsets()
+    , m_levelConnections()
+    , m_levelBlocks()
+    , m_inPtr()
+    , m_inConns()
+    , m_inSrcs()
+    , m_timeArena()
+    , m_contextSources()
+    , m_timeDeltas()
+    , m_timeOutputGradients()
+    , m_timeWeightGradients()
+    , m_timeBiasGradients()
+    , m_window(0u)
+    , m_timeHead(0u)
+    , m_timeSteps(0u)
+    , m_stepCount(0u)
+    , m_firstPending(NoPending)
+    , m_shards()
+    , m_minConnections(DefaultMinConnections)
+    , m_numShards(0u)
+    , m_batchSize(0u)
+    , m_numInputs(0u)
+    , m_outputBegin(0u)
+    , m_activationCount(0u)
+    , m_mode(EvaluationMode::EDGE_MAJOR)
+    , m_softmax(false)
+    , m_usesCycles(false)
+    , m_exactActivations(false){}
+    template<typename T>
+    BasicExecutionPlan<T>::BasicExecutionPlan(NeuralNetwork& nn, EvaluationMode mode)
+    : BasicExecutionPlan(){
+        m_mode = mode;
+        auto numLayers = nn.size();
+        m_layerOffsets.reserve(numLayers + 1);
+        m_layerOffsets.emplace_back(0u);
+        for(auto i=0u;i<numLayers;++i){
+            m_layerOffsets.emplace_back(m_layerOffsets.back() + nn[i].size());
+        }
+        auto size = m_layerOffsets.back();
+        auto& conns = nn.getConnections();
+        m_types.reserve(size);
+        m_activations.reserve(size);
+        m_biases.reserve(size);
+        m_cyclesLimits.reserve(size);
+        m_sums.reserve(size);
+        m_outputs.reserve(size);
+        m_rowPtr.reserve(size + 1);
+        m_dest.reserve(conns.size());
+        m_weights.reserve(conns.size());
+        m_cycles.reserve(conns.size());
+        m_rowPtr.emplace_back(0u);
+        for(auto i=0u;i<numLayers;++i){
+            auto& layer = nn[i];
+            for(auto& n:layer.getNeurons()){
+                m_types.emplace_back(n.getType());
+                m_activations.emplace_back(n.getActivationType());
+                m_biases.emplace_back(n.getBiasWeight());
+                m_cyclesLimits.emplace_back(layer.getCyclesLimit());
+                m_sums.emplace_back(n.getSum());
+                m_outputs.emplace_back(n.getOutput());
+                for(auto& c:n.getConnections()){
+                    auto& dest = c.getDest();
+                    m_dest.emplace_back(m_layerOffsets[dest.layer] + dest.neuron);
+                    m_weights.emplace_back(c.getWeight());
+                    m_cycles.emplace_back(c.getCycles());
+                }
+                m_rowPtr.emplace_back(m_dest.size());
+            }
+        }
+        m_activationTable = nn.getActivationTable();
+        finishBuild(numLayers > 0u && nn[numLayers - 1].getActivationType() == Neuron::ActivationType::SOFTMAX);
+        setThreadPool(nn.getThreadPool());
+    }
+    template<typename T>
+    BasicExecutionPlan<T>::BasicExecutionPlan(const ModelFile& model, EvaluationMode mode)
+    : BasicExecutionPlan(){
+        m_mode = mode;
+        if(!model.isValid()){
+            return;
+        }
+        auto& header = model.getHeader();
+        auto layers = model.getLayers();
+        auto neurons = model.getNeurons();
+        auto connections = model.getConnections();
+        auto size = header.numNeurons;
+        auto numConnections = header.numConnections;
+        m_layerOffsets.reserve(header.numLayers + 1);
+        m_layerOffsets.emplace_back(0u);
+        m_cyclesLimits.reserve(size);
+        for(auto i=0u;i<header.numLayers;++i){
+            m_layerOffsets.emplace_back(layers[i].firstNeuron + layers[i].numNeurons);
+            m_cyclesLimits.insert(std::end(m_cyclesLimits), layers[i].numNeurons, layers[i].cyclesLimit);
+        }
+        m_types.reserve(size);
+        m_activations.reserve(size);
+        for(auto i=0u;i<size;++i){
+            m_types.emplace_back(static_cast<Neuron::Type>(neurons[i].type));
+            m_activations.emplace_back(static_cast<Neuron::ActivationType>(neurons[i].activationType));
+        }
+        m_biases.assign(model.getBiases(), model.getBiases() + size);
+        m_sums.assign(size, 0.0);
+        m_outputs.assign(size, 0.0);
+        m_rowPtr.assign(model.getRowPtr(), model.getRowPtr() + size + 1);
+        m_dest.reserve(numConnections);
+        for(auto i=0u;i<numConnections;++i){
+            m_dest.emplace_back(connections[i].dest);
+        }
+        m_weights.assign(model.getWeights(), model.getWeights() + numConnections);
+        m_cycles.assign(numConnections, 0);
+        finishBuild(header.numLayers > 0u && layers[header.numLayers - 1].activationType == Neuron::ActivationType::SOFTMAX);
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::setInputs(const std::vector<T>& inputs) noexcept{
+        if(inputs.size() != m_numInputs){
+            return false;
+        }
+        std::copy(std::begin(inputs), std::end(inputs), std::begin(m_sums));
+        return true;
+    }
+    template<typename T>
+    std::vector<T> BasicExecutionPlan<T>::run() noexcept{
+        runStep();
+        return std::vector<T>(std::begin(m_outputs) + m_outputBegin, std::end(m_outputs));
+    }
+    template<typename T>
+    std::vector<T> BasicExecutionPlan<T>::forward(const std::vector<T>& inputs) noexcept{
+        setInputs(inputs);
+        return run();
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::forward(const T* inputs, std::size_t inputSize, T* outputs, std::size_t outputSize) noexcept{
+        if(inputSize != m_numInputs || outputSize != numOutputs()){
+            return false;
+        }
+        std::copy(inputs, inputs + inputSize, std::begin(m_sums));
+        runStep();
+        std::copy(std::begin(m_outputs) + m_outputBegin, std::end(m_outputs), outputs);
+        return true;
+    }
+    template<typename T>
+    std::vector<T> BasicExecutionPlan<T>::forward(const std::vector<T>& inputs, State& state) const noexcept{
+        if(inputs.size() != m_numInputs || state.sums.size() != numNeurons() ||
+                state.outputs.size() != numNeurons() || state.cycles.size() != numConnections()){
+            return {};
+        }
+        std::copy(std::begin(inputs), std::end(inputs), std::begin(state.sums));
+        // getActivationCount is not updated, other threads could be using the plan.
+        std::size_t activationCount = 0u;
+        runLanes(Lanes{state.sums.data(), state.outputs.data(), state.cycles.data(), 1u, &activationCount});
+        return std::vector<T>(std::begin(state.outputs) + m_outputBegin, std::end(state.outputs));
+    }
+    template<typename T>
+    typename BasicExecutionPlan<T>::State BasicExecutionPlan<T>::makeState() const{
+        return State{m_sums, m_outputs, m_cycles};
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::reset(State& state) const noexcept{
+        auto size = std::min(numNeurons(), state.sums.size());
+        for(auto i=0u;i<size;++i){
+            if(m_types[i] != Neuron::Type::CONTEXT){
+                state.sums[i] = 0.0;
+                state.outputs[i] = 0.0;
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::resetContext(State& state) const noexcept{
+        std::fill(std::begin(state.sums), std::end(state.sums), 0.0);
+        std::fill(std::begin(state.outputs), std::end(state.outputs), 0.0);
+    }
+    template<typename T>
+    typename BasicExecutionPlan<T>::BatchState BasicExecutionPlan<T>::makeBatchState(std::size_t batchSize) const{
+        BatchState state;
+        loadBatchState(state, batchSize);
+        return state;
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::forwardBatch(const T* inputs, std::size_t inputSize, T* outputs, std::size_t outputSize, BatchState& state) const noexcept{
+        auto batchSize = state.batchSize;
+        if(batchSize == 0u || inputSize != batchSize * m_numInputs || outputSize != batchSize * numOutputs() ||
+                state.sums.size() != numNeurons() * batchSize || state.outputs.size() != numNeurons() * batchSize ||
+                state.cycles.size() != numConnections() * batchSize){
+            return false;
+        }
+        // getActivationCount is not updated, other threads could be using the plan.
+        std::size_t activationCount = 0u;
+        runBatch(inputs, outputs, state, activationCount);
+        return true;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::reset(BatchState& state) const noexcept{
+        auto batchSize = state.batchSize;
+        auto size = std::min(numNeurons(), state.sums.size() / std::max<std::size_t>(1u, batchSize));
+        for(auto n=0u;n<size;++n){
+            if(m_types[n] != Neuron::Type::CONTEXT){
+                std::fill_n(std::begin(state.sums) + n * batchSize, batchSize, 0.0);
+                std::fill_n(std::begin(state.outputs) + n * batchSize, batchSize, 0.0);
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::resetContext(BatchState& state, std::size_t lane) const noexcept{
+        auto batchSize = state.batchSize;
+        if(lane >= batchSize){
+            return;
+        }
+        for(auto i=lane;i<state.sums.size();i+=batchSize){
+            state.sums[i] = 0.0;
+            state.outputs[i] = 0.0;
+        }
+        for(auto i=lane;i<state.cycles.size();i+=batchSize){
+            state.cycles[i] = 0;
+        }
+    }
+    template<typename T>
+    std::vector<T> BasicExecutionPlan<T>::forwardBatch(const std::vector<T>& inputs, std::size_t batchSize) noexcept{
+        std::vector<T> result;
+        forwardBatch(inputs, batchSize, result);
+        return result;
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::forwardBatch(const std::vector<T>& inputs, std::size_t batchSize, std::vector<T>& result) noexcept{
+        if(batchSize == 0u || inputs.size() != batchSize * m_numInputs){
+            result.clear();
+            return false;
+        }
+        auto size = numNeurons();
+        auto connections = numConnections();
+        auto outputs = numOutputs();
+        m_batchSize = batchSize;
+        m_numShards = numShardsFor(batchSize);
+        result.resize(batchSize * outputs);
+        if(m_numShards > 0u){
+            forwardShards(inputs, result);
+            return true;
+        }
+        m_batchSums.resize(size * batchSize);
+        m_batchOutputs.resize(size * batchSize);
+        for(auto n=0u;n<size;++n){
+            std::fill_n(std::begin(m_batchSums) + n * batchSize, batchSize, m_sums[n]);
+            std::fill_n(std::begin(m_batchOutputs) + n * batchSize, batchSize, m_outputs[n]);
+        }
+        // the cycles have a lane per connection, they are only used by storeContext and storeOutput.
+        if(m_usesCycles){
+            m_batchCycles.resize(connections * batchSize);
+            for(auto c=0u;c<connections;++c){
+                std::fill_n(std::begin(m_batchCycles) + c * batchSize, batchSize, m_cycles[c]);
+            }
+        }
+        for(std::size_t b=0u;b<batchSize;++b){
+            for(auto i=0u;i<m_numInputs;++i){
+                m_batchSums[i * batchSize + b] = inputs[b * m_numInputs + i];
+            }
+        }
+        m_activationCount = 0u;
+        runLanes(Lanes{m_batchSums.data(), m_batchOutputs.data(), m_batchCycles.data(), batchSize, &m_activationCount});
+        for(auto j=0u;j<outputs;++j){
+            auto lane = (m_outputBegin + j) * batchSize;
+            for(std::size_t b=0u;b<batchSize;++b){
+                result[b * outputs + j] = m_batchOutputs[lane + b];
+            }
+        }
+        return true;
+    }
+    template<typename T>
+    std::vector<T> BasicExecutionPlan<T>::backwardBatch(const std::vector<T>& gradientLoss, bool gradientOfSums) noexcept{
+        std::vector<T> result;
+        backwardBatch(gradientLoss, result, gradientOfSums);
+        return result;
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::backwardBatch(const std::vector<T>& gradientLoss, std::vector<T>& result, bool gradientOfSums) noexcept{
+        auto batchSize = m_batchSize;
+        auto outputs = numOutputs();
+        if(batchSize == 0u || gradientLoss.size() != batchSize * outputs){
+            m_weightGradients.clear();
+            result.clear();
+            return false;
+        }
+        auto size = numNeurons();
+        auto connections = numConnections();
+        result.resize(batchSize * m_numInputs);
+        m_weightGradients.assign(connections, 0.0);
+        m_biasGradients.assign(size, 0.0);
+        if(m_numShards > 0u){
+            backwardShards(gradientLoss, gradientOfSums, result);
+            return true;
+        }
+        m_batchGradients.resize(size * batchSize);
+        m_derivatives.resize(batchSize);
+        backwardLanes(gradientLoss.data(), gradientOfSums, batchSize, m_batchSums.data(), m_batchOutputs.data(), m_batchGradients.data(),
+                      m_derivatives.data(), m_weightGradients.data(), m_biasGradients.data());
+        for(auto i=0u;i<m_numInputs;++i){
+            for(std::size_t b=0u;b<batchSize;++b){
+                result[b * m_numInputs + i] = m_batchGradients[i * batchSize + b];
+            }
+        }
+        return true;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::writeGradients(NeuralNetwork& nn) const noexcept{
+        if(m_weightGradients.empty()){
+            return;
+        }
+        auto& conns = nn.getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            conns[i]->addGradient(m_weightGradients[i]);
+        }
+        auto& nrns = nn.getNeurons();
+        auto connections = numConnections();
+        for(auto c=0u;c<connections;++c){
+            auto d = m_dest[c];
+            if(m_types[d] != Neuron::Type::INPUT){
+                nrns[d]->setBiasGradient(m_biasGradients[d]);
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::loadParameters(const std::atomic<T>* parameters) noexcept{
+        auto connections = numConnections();
+        for(auto c=0u;c<connections;++c){
+            m_weights[c] = parameters[c].load(std::memory_order_relaxed);
+        }
+        auto size = numNeurons();
+        for(auto n=0u;n<size;++n){
+            m_biases[n] = parameters[connections + n].load(std::memory_order_relaxed);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::applyGradients(std::atomic<T>* parameters, const std::vector<std::uint32_t>& trainable, T rate) const noexcept{
+        if(m_weightGradients.empty()){
+            return;
+        }
+        auto connections = numConnections();
+        for(auto i:trainable){
+            auto gradient = i < connections ? m_weightGradients[i]:m_biasGradients[i - connections];
+            if(gradient == 0.0){
+                continue;
+            }
+            auto step = static_cast<T>(rate * gradient);
+            auto& p = parameters[i];
+            auto value = p.load(std::memory_order_relaxed);
+            while(!p.compare_exchange_weak(value, value - step, std::memory_order_relaxed)){}
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::updateWeights(NeuralNetwork& nn) noexcept{
+        auto& conns = nn.getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            m_weights[i] = conns[i]->getWeight();
+        }
+        auto& nrns = nn.getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            m_biases[i] = nrns[i]->getBiasWeight();
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::writeWeights(NeuralNetwork& nn) const noexcept{
+        auto& conns = nn.getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            conns[i]->setWeight(m_weights[i]);
+        }
+        auto& nrns = nn.getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            nrns[i]->setBiasWeight(m_biases[i]);
+        }
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::bindParameters(NeuralNetwork& nn, ParameterBuffer& params) noexcept{
+        params.unbind();
+        if constexpr(!std::is_same_v<T, double>){
+            return false;
+        }else{
+            auto& conns = nn.getConnections();
+            auto& nrns = nn.getNeurons();
+            auto& parameters = params.getParameters();
+            if(conns.size() != numConnections() || nrns.size() != numNeurons()){
+                return false;
+            }
+            // backwardBatch assigns them without reallocating, so the views stay valid.
+            m_weightGradients.resize(numConnections(), 0.0);
+            m_biasGradients.resize(numNeurons(), 0.0);
+            std::vector<ParameterBuffer::Segment> segments;
+            std::size_t p = 0u;
+            auto add = [&](double* weight, double* gradient){
+                if(!segments.empty()){
+                    auto& last = segments.back();
+                    if(last.weights + last.size == weight && last.gradients + last.size == gradient){
+                        ++last.size;
+                        ++p;
+                        return;
+                    }
+                }
+                segments.emplace_back(ParameterBuffer::Segment{p, 1u, weight, gradient});
+                ++p;
+            };
+            for(auto i=0u;i<conns.size() && p < parameters.size();++i){
+                if(parameters[p] == conns[i]){
+                    add(&m_weights[i], &m_weightGradients[i]);
+                }
+            }
+            for(auto i=0u;i<nrns.size() && p < parameters.size();++i){
+                if(parameters[p] == nrns[i]->getBiasPtr()){
+                    add(&m_biases[i], &m_biasGradients[i]);
+                }
+            }
+            if(p != parameters.size()){
+                return false;
+            }
+            return params.bind(std::move(segments));
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::writeState(NeuralNetwork& nn) const noexcept{
+        auto& nrns = nn.getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            nrns[i]->setSum(m_sums[i]);
+            nrns[i]->setOutput(m_outputs[i]);
+        }
+        auto& conns = nn.getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            conns[i]->setCycles(m_cycles[i]);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::reset() noexcept{
+        auto size = numNeurons();
+        for(auto i=0u;i<size;++i){
+            if(m_types[i] != Neuron::Type::CONTEXT){
+                m_sums[i] = 0.0;
+                m_outputs[i] = 0.0;
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::resetContext() noexcept{
+        std::fill(std::begin(m_sums), std::end(m_sums), 0.0);
+        std::fill(std::begin(m_outputs), std::end(m_outputs), 0.0);
+        // a new sequence starts, the gradients don't go back to the old one.
+        propagateThroughTime();
+        m_timeHead = 0u;
+        m_timeSteps = 0u;
+        m_stepCount = 0u;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minConnections) noexcept{
+        m_threadPool = std::move(pool);
+        m_minConnections = std::max<std::size_t>(1u, minConnections);
+        if(m_threadPool && m_levelOffsets.empty()){
+            findLevels();
+        }
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::setTruncationWindow(std::size_t window){
+        auto size = numNeurons();
+        m_window = 0u;
+        m_timeHead = 0u;
+        m_timeSteps = 0u;
+        m_stepCount = 0u;
+        m_firstPending = NoPending;
+        if(window == 0u || !canRunThroughTime()){
+            m_timeArena.clear();
+            m_contextSources.clear();
+            return window == 0u;
+        }
+        // the last store into a context neuron is the one that stays, it is the one with the highest source.
+        m_contextSources.assign(size, -1);
+        for(auto n=0u;n<size;++n){
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                if(m_types[m_dest[c]] == Neuron::Type::CONTEXT){
+                    m_contextSources[m_dest[c]] = static_cast<std::int32_t>(n);
+                }
+            }
+        }
+        m_window = window;
+        m_timeArena.assign(window * (2u * size + numOutputs()), 0.0);
+        m_timeDeltas.assign(2u * size, 0.0);
+        m_timeOutputGradients.assign(size, 0.0);
+        m_timeWeightGradients.assign(numConnections(), 0.0);
+        m_timeBiasGradients.assign(size, 0.0);
+        return true;
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::backwardThroughTime(const std::vector<T>& gradientLoss) noexcept{
+        auto outputs = numOutputs();
+        if(m_timeSteps == 0u || gradientLoss.size() != outputs){
+            return false;
+        }
+        auto loss = timeStep(m_timeSteps - 1u) + 2u * numNeurons();
+        for(auto j=0u;j<outputs;++j){
+            loss[j] += gradientLoss[j];
+        }
+        if(m_firstPending == NoPending){
+            m_firstPending = m_stepCount - 1u;
+        }
+        return true;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::propagateThroughTime() noexcept{
+        if(m_firstPending == NoPending || m_timeSteps == 0u){
+            m_firstPending = NoPending;
+            return;
+        }
+        auto size = numNeurons();
+        auto delta = m_timeDeltas.data();
+        auto next = m_timeDeltas.data() + size;
+        auto outputGradients = m_timeOutputGradients.data();
+        std::fill_n(next, size, 0.0);
+        for(auto age=m_timeSteps;age>0u;--age){
+            auto sums = timeStep(age - 1u);
+            auto outs = sums + size;
+            auto loss = outs + size;
+            std::fill_n(delta, size, 0.0);
+            std::fill_n(outputGradients, size, 0.0);
+            // a context neuron of the next step holds the sum its source had in this step.
+            for(auto k=0u;k<size;++k){
+                if(m_types[k] == Neuron::Type::CONTEXT && m_contextSources[k] >= 0){
+                    delta[m_contextSources[k]] += next[k];
+                }
+            }
+            for(auto n=m_outputBegin;n<size;++n){
+                auto gradient = m_softmax ? outs[n] * (1.0 - outs[n]):0.0;
+                delta[n] += loss[n - m_outputBegin] * Derivatives::derivate(m_activations[n], sums[n], outs[n], m_biases[n], gradient);
+                m_timeBiasGradients[n] += delta[n];
+                loss[n - m_outputBegin] = 0.0;
+            }
+            for(auto n=m_outputBegin;n>0u;--n){
+                auto src = n - 1u;
+                for(auto c=m_rowPtr[src];c<m_rowPtr[src + 1];++c){
+                    auto d = m_dest[c];
+                    // the hidden neurons before src were finalized before it, what it adds to them is lost on reset.
+                    if(m_types[d] == Neuron::Type::OUTPUT || (m_types[d] == Neuron::Type::HIDDEN && d > src)){
+                        m_timeWeightGradients[c] += delta[d] * outs[src];
+                        outputGradients[src] += m_weights[c] * delta[d];
+                    }
+                }
+                if(m_types[src] == Neuron::Type::HIDDEN || m_types[src] == Neuron::Type::CONTEXT){
+                    delta[src] += outputGradients[src] * Derivatives::derivate(m_activations[src], sums[src], outs[src], m_biases[src], 0.0);
+                    if(m_types[src] == Neuron::Type::HIDDEN){
+                        m_timeBiasGradients[src] += delta[src];
+                    }
+                }
+            }
+            std::copy(delta, delta + size, next);
+        }
+        m_firstPending = NoPending;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::writeTimeGradients(NeuralNetwork& nn) noexcept{
+        if(m_timeWeightGradients.empty()){
+            return;
+        }
+        auto& conns = nn.getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            conns[i]->addGradient(m_timeWeightGradients[i]);
+        }
+        auto& nrns = nn.getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            nrns[i]->getBiasPtr()->addGradient(m_timeBiasGradients[i]);
+        }
+        std::fill(std::begin(m_timeWeightGradients), std::end(m_timeWeightGradients), 0.0);
+        std::fill(std::begin(m_timeBiasGradients), std::end(m_timeBiasGradients), 0.0);
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::hasContext() const noexcept{
+        return std::find(std::begin(m_types), std::end(m_types), Neuron::Type::CONTEXT) != std::end(m_types);
+    }
+//private member functions
+    template<typename T>
+    void BasicExecutionPlan<T>::finishBuild(bool softmax) noexcept{
+        auto size = numNeurons();
+        m_order.resize(size);
+        std::iota(std::begin(m_order), std::end(m_order), 0u);
+        if(m_layerOffsets.size() > 1u){
+            m_numInputs = m_layerOffsets[1];
+            m_outputBegin = m_layerOffsets[m_layerOffsets.size() - 2u];
+            m_softmax = softmax;
+        }
+        for(auto n=0u;n<size;++n){
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                m_usesCycles = m_usesCycles || m_types[n] == Neuron::Type::OUTPUT || m_types[m_dest[c]] == Neuron::Type::CONTEXT;
+            }
+        }
+        findDenseBlocks();
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::runStep() noexcept{
+        m_activationCount = 0u;
+        if(m_window > 0u){
+            beginStep();
+        }
+        runLanes(Lanes{m_sums.data(), m_outputs.data(), m_cycles.data(), 1u, &m_activationCount});
+        if(m_window > 0u){
+            endStep();
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::loadBatchState(BatchState& state, std::size_t batchSize) const{
+        auto size = numNeurons();
+        auto connections = numConnections();
+        state.batchSize = batchSize;
+        state.sums.resize(size * batchSize);
+        state.outputs.resize(size * batchSize);
+        state.cycles.resize(connections * batchSize);
+        for(auto n=0u;n<size;++n){
+            std::fill_n(std::begin(state.sums) + n * batchSize, batchSize, m_sums[n]);
+            std::fill_n(std::begin(state.outputs) + n * batchSize, batchSize, m_outputs[n]);
+        }
+        for(auto c=0u;c<connections;++c){
+            std::fill_n(std::begin(state.cycles) + c * batchSize, batchSize, m_cycles[c]);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::runBatch(const T* inputs, T* outputs, BatchState& state, std::size_t& activationCount) const noexcept{
+        auto batchSize = state.batchSize;
+        for(std::size_t b=0u;b<batchSize;++b){
+            for(auto i=0u;i<m_numInputs;++i){
+                state.sums[i * batchSize + b] = inputs[b * m_numInputs + i];
+            }
+        }
+        runLanes(Lanes{state.sums.data(), state.outputs.data(), state.cycles.data(), batchSize, &activationCount});
+        auto numOuts = numOutputs();
+        for(auto j=0u;j<numOuts;++j){
+            auto lane = (m_outputBegin + j) * batchSize;
+            for(std::size_t b=0u;b<batchSize;++b){
+                outputs[b * numOuts + j] = state.outputs[lane + b];
+            }
+        }
+    }
+    template<typename T>
+    std::size_t BasicExecutionPlan<T>::numShardsFor(std::size_t batchSize) const noexcept{
+        if(!m_threadPool || m_threadPool->size() < 2u || batchSize < 2u){
+            return 0u;
+        }
+        auto work = numConnections() * batchSize;
+        auto shards = std::min({m_threadPool->size(), batchSize, std::max<std::size_t>(1u, work / m_minConnections)});
+        return shards > 1u ? shards:0u;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::forwardShards(const std::vector<T>& inputs, std::vector<T>& outputs) noexcept{
+        auto batchSize = m_batchSize;
+        auto numShards = m_numShards;
+        auto numOuts = numOutputs();
+        m_shards.resize(numShards);
+        auto shardTask = [&](std::size_t task){
+            auto& shard = m_shards[task];
+            shard.begin = batchSize * task / numShards;
+            auto end = batchSize * (task + 1u) / numShards;
+            shard.activationCount = 0u;
+            loadBatchState(shard.state, end - shard.begin);
+            runBatch(inputs.data() + shard.begin * m_numInputs, outputs.data() + shard.begin * numOuts, shard.state, shard.activationCount);
+        };
+        m_threadPool->run(numShards, std::cref(shardTask));
+        m_activationCount = 0u;
+        for(auto& shard:m_shards){
+            m_activationCount += shard.activationCount;
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::backwardShards(const std::vector<T>& gradientLoss, bool gradientOfSums, std::vector<T>& inputGradients) noexcept{
+        auto numShards = m_numShards;
+        auto numOuts = numOutputs();
+        auto size = numNeurons();
+        auto connections = numConnections();
+        auto shardTask = [&](std::size_t task){
+            auto& shard = m_shards[task];
+            auto batchSize = shard.state.batchSize;
+            shard.gradients.resize(size * batchSize);
+            shard.derivatives.resize(batchSize);
+            shard.parameterGradients.assign(connections + size, 0.0);
+            backwardLanes(gradientLoss.data() + shard.begin * numOuts, gradientOfSums, batchSize, shard.state.sums.data(), shard.state.outputs.data(),
+                          shard.gradients.data(), shard.derivatives.data(), shard.parameterGradients.data(),
+                          shard.parameterGradients.data() + connections);
+            for(auto i=0u;i<m_numInputs;++i){
+                for(std::size_t b=0u;b<batchSize;++b){
+                    inputGradients[(shard.begin + b) * m_numInputs + i] = shard.gradients[i * batchSize + b];
+                }
+            }
+        };
+        m_threadPool->run(numShards, std::cref(shardTask));
+        // tree reduce, the pairs are always the same for a number of shards so the sums are deterministic.
+        for(std::size_t stride=1u;stride<numShards;stride*=2u){
+            auto pairs = (numShards - stride + 2u * stride - 1u) / (2u * stride);
+            auto reduceTask = [&](std::size_t pair){
+                auto& to = m_shards[pair * 2u * stride].parameterGradients;
+                auto& from = m_shards[pair * 2u * stride + stride].parameterGradients;
+                for(auto c=0u;c<connections;++c){
+                    to[c] += from[c];
+                }
+                // like backwardBatch, the bias gradients of the last sample are the ones that stay.
+                std::copy(std::begin(from) + connections, std::end(from), std::begin(to) + connections);
+            };
+            m_threadPool->run(pairs, std::cref(reduceTask));
+        }
+        auto& reduced = m_shards[0].parameterGradients;
+        std::copy(std::begin(reduced), std::begin(reduced) + connections, std::begin(m_weightGradients));
+        std::copy(std::begin(reduced) + connections, std::end(reduced), std::begin(m_biasGradients));
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::backwardLanes(const T* gradientLoss, bool gradientOfSums, std::size_t batchSize, const T* sums, const T* outs, T* grads,
+                                              T* derivatives, double* weightGradients, double* biasGradients) const noexcept{
+        auto outputs = numOutputs();
+        std::fill_n(grads, numNeurons() * batchSize, 0.0);
+        for(auto j=0u;j<outputs;++j){
+            auto n = m_outputBegin + j;
+            auto lane = n * batchSize;
+            if(gradientOfSums){
+                for(std::size_t b=0u;b<batchSize;++b){
+                    grads[lane + b] = gradientLoss[b * outputs + j];
+                }
+                continue;
+            }
+            if(m_softmax){
+                for(std::size_t b=0u;b<batchSize;++b){
+                    grads[lane + b] = outs[lane + b] * (1.0 - outs[lane + b]);
+                }
+            }
+            Derivatives::Array::derivate(m_activations[n], &sums[lane], &outs[lane], &grads[lane], derivatives, batchSize, m_biases[n]);
+            for(std::size_t b=0u;b<batchSize;++b){
+                grads[lane + b] = derivatives[b] * gradientLoss[b * outputs + j];
+            }
+        }
+        // same order as NeuralNetwork::backward, the connections in reverse.
+        for(auto it=std::rbegin(m_order);it!=std::rend(m_order);++it){
+            auto n = *it;
+            auto src = n * batchSize;
+            for(auto c=m_rowPtr[n + 1];c>m_rowPtr[n];--c){
+                auto conn = c - 1;
+                auto d = m_dest[conn];
+                auto dest = d * batchSize;
+                auto w = m_weights[conn];
+                auto weightGradient = 0.0;
+                auto gradient = T(0);
+                switch(m_types[d]){
+                    case Neuron::Type::OUTPUT:
+                        for(std::size_t b=0u;b<batchSize;++b){
+                            gradient = grads[dest + b];
+                            weightGradient += gradient * outs[src + b];
+                            grads[src + b] = (gradient + grads[src + b]) * w;
+                        }
+                        break;
+                    case Neuron::Type::CONTEXT:
+                    case Neuron::Type::HIDDEN:
+                        Derivatives::Array::derivate(m_activations[d], &sums[dest], &outs[dest], &grads[dest], derivatives, batchSize, m_biases[d]);
+                        for(std::size_t b=0u;b<batchSize;++b){
+                            gradient = grads[dest + b] * derivatives[b];
+                            weightGradient += gradient * outs[src + b];
+                            grads[src + b] = (gradient + grads[src + b]) * w;
+                        }
+                        break;
+                    case Neuron::Type::INPUT:
+                        continue;
+                }
+                weightGradients[conn] += weightGradient;
+                // NeuralNetwork::backward sets the bias gradient, so the last sample is the one that stays.
+                biasGradients[d] = gradient;
+            }
+        }
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::canRunThroughTime() const noexcept{
+        if(m_mode != EvaluationMode::NEURON_MAJOR){
+            return false;
+        }
+        auto size = numNeurons();
+        for(auto n=0u;n<size;++n){
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                auto d = m_dest[c];
+                auto toContext = m_types[d] == Neuron::Type::CONTEXT;
+                // inputs add to context neurons instead of storing, outputs store into any neuron.
+                if(toContext && (m_types[n] == Neuron::Type::INPUT || n < d)){
+                    return false;
+                }
+                if(m_types[n] == Neuron::Type::OUTPUT && !toContext){
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    template<typename T>
+    T* BasicExecutionPlan<T>::timeStep(std::size_t age) noexcept{
+        auto slot = (m_timeHead + age) % m_window;
+        return m_timeArena.data() + slot * (2u * numNeurons() + numOutputs());
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::beginStep() noexcept{
+        // the oldest step leaves the ring, its loss gradients can't wait any longer.
+        if(m_timeSteps == m_window && m_firstPending != NoPending && m_firstPending + m_window <= m_stepCount){
+            propagateThroughTime();
+        }
+        if(m_timeSteps == m_window){
+            m_timeHead = (m_timeHead + 1u) % m_window;
+            --m_timeSteps;
+        }
+        ++m_timeSteps;
+        ++m_stepCount;
+        auto sums = timeStep(m_timeSteps - 1u);
+        auto size = numNeurons();
+        std::copy(std::begin(m_sums), std::end(m_sums), sums);
+        std::fill_n(sums + 2u * size, numOutputs(), 0.0);
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::endStep() noexcept{
+        auto sums = timeStep(m_timeSteps - 1u);
+        auto size = numNeurons();
+        auto outputs = sums + size;
+        std::copy(std::begin(m_outputs), std::end(m_outputs), outputs);
+        for(auto n=0u;n<size;++n){
+            if(m_types[n] != Neuron::Type::CONTEXT){
+                sums[n] = m_sums[n];
+            }else if(m_rowPtr[n] != m_rowPtr[n + 1]){
+                // storeContext clears the output when the cycles limit is reached, the step used the one from its sum.
+                outputs[n] = static_cast<T>(m_activationTable ? m_activationTable->activate(m_activations[n], sums[n], m_biases[n])
+                                                              : Activations::activate(m_activations[n], sums[n], m_biases[n]));
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::findDenseBlocks() noexcept{
+        m_denseBlockOf.assign(numNeurons(), -1);
+        auto numLayers = m_layerOffsets.size() - 1u;
+        auto isDenseDest = [&](std::uint32_t d){
+            return m_types[d] == Neuron::Type::HIDDEN || m_types[d] == Neuron::Type::OUTPUT;
+        };
+        for(auto l=0u;l<numLayers;++l){
+            auto srcBegin = m_layerOffsets[l];
+            auto srcEnd = m_layerOffsets[l + 1];
+            if(srcBegin == srcEnd || m_types[srcBegin] == Neuron::Type::OUTPUT){
+                continue;
+            }
+            auto isDense = [&](DenseBlock& block){
+                auto numDest = block.destEnd - block.destBegin;
+                for(auto n=srcBegin;n<srcEnd;++n){
+                    if(m_types[n] == Neuron::Type::OUTPUT || m_rowPtr[n] + block.offset + numDest > m_rowPtr[n + 1]){
+                        return false;
+                    }
+                    block.inputsOnly = block.inputsOnly && m_types[n] == Neuron::Type::INPUT;
+                    for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                        auto j = c - m_rowPtr[n];
+                        auto d = m_dest[c];
+                        if(j >= block.offset && j < block.offset + numDest){
+                            if(d != block.destBegin + (j - block.offset) || !isDenseDest(d)){
+                                return false;
+                            }
+                        }else if((d >= srcBegin && d < srcEnd) || (d >= block.destBegin && d < block.destEnd)){
+                            // the rest of the connections run after the whole layer is activated and after the block,
+                            // so they can't go back into the layer or into the block without changing the order of the sums.
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            };
+            // any connection of the first neuron that goes to the start of another layer can start the block.
+            for(auto c=m_rowPtr[srcBegin];c<m_rowPtr[srcBegin + 1];++c){
+                auto d = m_dest[c];
+                auto dl = static_cast<std::size_t>(std::upper_bound(std::begin(m_layerOffsets), std::end(m_layerOffsets), d) - std::begin(m_layerOffsets)) - 1u;
+                if(dl == l || m_layerOffsets[dl] != d){
+                    continue;
+                }
+                DenseBlock block{srcBegin, srcEnd, d, m_layerOffsets[dl + 1], c - m_rowPtr[srcBegin], true};
+                if(isDense(block)){
+                    std::fill(std::begin(m_denseBlockOf) + srcBegin, std::begin(m_denseBlockOf) + srcEnd, static_cast<std::int32_t>(m_denseBlocks.size()));
+                    m_denseBlocks.emplace_back(block);
+                    break;
+                }
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::findLevels() noexcept{
+        auto size = numNeurons();
+        std::vector<std::uint32_t> level(size, 0u);
+        std::vector<std::uint32_t> inDegree(size, 0u);
+        auto numLevels = size > 0u ? 1u:0u;
+        for(auto n=0u;n<size;++n){
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                auto d = m_dest[c];
+                // the neurons run in order, a connection to an earlier neuron or to a context neuron needs the sequential run.
+                if(d <= n || m_types[n] == Neuron::Type::OUTPUT || m_types[d] == Neuron::Type::CONTEXT){
+                    return;
+                }
+                level[d] = std::max(level[d], level[n] + 1u);
+                numLevels = std::max(numLevels, level[d] + 1u);
+                ++inDegree[d];
+            }
+        }
+        m_levelOffsets.assign(numLevels + 1u, 0u);
+        m_levelConnections.assign(numLevels, 0u);
+        for(auto n=0u;n<size;++n){
+            ++m_levelOffsets[level[n] + 1u];
+            m_levelConnections[level[n]] += inDegree[n];
+        }
+        std::partial_sum(std::begin(m_levelOffsets), std::end(m_levelOffsets), std::begin(m_levelOffsets));
+        m_levels.resize(size);
+        auto next = m_levelOffsets;
+        for(auto n=0u;n<size;++n){
+            m_levels[next[level[n]]++] = n;
+        }
+        // a level that is all the dests of a DenseBlock and gets nothing else is added row by row, split by dest.
+        m_levelBlocks.assign(numLevels, -1);
+        for(auto b=0u;b<m_denseBlocks.size();++b){
+            auto& block = m_denseBlocks[b];
+            auto l = level[block.destBegin];
+            auto numSrc = block.srcEnd - block.srcBegin;
+            auto isLevel = m_levelOffsets[l + 1] - m_levelOffsets[l] == block.destEnd - block.destBegin;
+            for(auto d=block.destBegin;d<block.destEnd && isLevel;++d){
+                isLevel = level[d] == l && inDegree[d] == numSrc;
+            }
+            if(isLevel){
+                m_levelBlocks[l] = static_cast<std::int32_t>(b);
+            }
+        }
+        // the incoming connections of each neuron by source, the same order the sources push them.
+        m_inPtr.assign(size + 1u, 0u);
+        for(auto n=0u;n<size;++n){
+            m_inPtr[n + 1u] = m_inPtr[n] + inDegree[n];
+        }
+        m_inConns.resize(numConnections());
+        m_inSrcs.resize(numConnections());
+        auto in = std::vector<std::uint32_t>(std::begin(m_inPtr), std::end(m_inPtr) - 1);
+        for(auto n=0u;n<size;++n){
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                auto i = in[m_dest[c]]++;
+                m_inConns[i] = c;
+                m_inSrcs[i] = n;
+            }
+        }
+    }
+    template<typename T>
+    bool BasicExecutionPlan<T>::runLevels(Lanes lanes) const noexcept{
+        if(!m_threadPool || m_levelOffsets.empty()){
+            return false;
+        }
+        auto numThreads = m_threadPool->size();
+        auto numTasks = [&](std::size_t level){
+            auto work = static_cast<std::size_t>(m_levelConnections[level]) * lanes.size;
+            auto numNeurons = static_cast<std::size_t>(m_levelOffsets[level + 1] - m_levelOffsets[level]);
+            return std::min({numThreads, numNeurons, std::max<std::size_t>(1u, work / m_minConnections)});
+        };
+        auto numLevels = m_levelConnections.size();
+        auto split = false;
+        for(auto l=0u;l<numLevels && !split;++l){
+            split = numTasks(l) > 1u;
+        }
+        if(!split){
+            return false;
+        }
+        std::atomic<std::size_t> activationCount{0u};
+        for(auto l=0u;l<numLevels;++l){
+            auto begin = m_levelOffsets[l];
+            auto end = m_levelOffsets[l + 1];
+            auto tasks = numTasks(l);
+            auto runTask = [&](std::size_t task, Lanes taskLanes){
+                auto first = begin + (end - begin) * task / tasks;
+                auto last = begin + (end - begin) * (task + 1u) / tasks;
+                if(m_levelBlocks[l] >= 0){
+                    auto& block = m_denseBlocks[m_levelBlocks[l]];
+                    addDenseBlock(block, first - begin, last - begin, taskLanes);
+                    for(auto i=first;i<last;++i){
+                        finalizeLevel(m_levels[i], taskLanes);
+                    }
+                }else{
+                    for(auto i=first;i<last;++i){
+                        pull(m_levels[i], taskLanes);
+                    }
+                }
+            };
+            if(tasks <= 1u){
+                runTask(0u, lanes);
+                continue;
+            }
+            auto levelTask = [&](std::size_t task){
+                // each task counts its activations and adds them once it is done.
+                std::size_t taskCount = 0u;
+                auto taskLanes = lanes;
+                taskLanes.activationCount = &taskCount;
+                runTask(task, taskLanes);
+                activationCount += taskCount;
+            };
+            // std::cref keeps the std::function from allocating a copy of the lambda.
+            m_threadPool->run(tasks, std::cref(levelTask));
+        }
+        *lanes.activationCount += activationCount;
+        return true;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::pull(std::uint32_t n, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        auto sums = lanes.sums + n * L;
+        for(auto i=m_inPtr[n];i<m_inPtr[n + 1];++i){
+            auto outputs = lanes.outputs + m_inSrcs[i] * L;
+            auto w = m_weights[m_inConns[i]];
+            for(std::size_t b=0u;b<L;++b){
+                sums[b] += outputs[b] * w;
+            }
+        }
+        finalizeLevel(n, lanes);
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::finalizeLevel(std::uint32_t n, Lanes lanes) const noexcept{
+        // like runNeuronMajor, the neurons without connections are not finalized and the outputs are finalized by runLanes.
+        if(m_rowPtr[n] != m_rowPtr[n + 1] && m_types[n] != Neuron::Type::OUTPUT){
+            finalize(n, lanes);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::runLanes(Lanes lanes) const noexcept{
+        if(m_mode == EvaluationMode::NEURON_MAJOR){
+            if(!runLevels(lanes)){
+                runNeuronMajor(lanes);
+            }
+        }else{
+            runEdgeMajor(lanes);
+        }
+        auto size = numNeurons();
+        auto L = lanes.size;
+        for(auto n=m_outputBegin;n<size;++n){
+            auto sums = lanes.sums + n * L;
+            for(std::size_t b=0u;b<L;++b){
+                sums[b] += m_biases[n];
+            }
+            activate(n, lanes);
+        }
+        if(m_softmax){
+            auto outputs = numOutputs();
+            if constexpr(std::is_same_v<T, double>){
+                if(L == 1u){
+                    Activations::softmax(lanes.outputs + m_outputBegin, outputs);
+                    return;
+                }
+            }
+            // Activations::softmax works on doubles, each lane is copied out and back.
+            std::vector<double> values(outputs);
+            for(std::size_t b=0u;b<L;++b){
+                for(auto j=0u;j<outputs;++j){
+                    values[j] = lanes.outputs[(m_outputBegin + j) * L + b];
+                }
+                Activations::softmax(values.data(), outputs);
+                for(auto j=0u;j<outputs;++j){
+                    lanes.outputs[(m_outputBegin + j) * L + b] = static_cast<T>(values[j]);
+                }
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::runEdgeMajor(Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        for(auto n:m_order){
+            auto begin = m_rowPtr[n];
+            auto end = m_rowPtr[n + 1];
+            if(begin == end){
+                continue;
+            }
+            auto block = m_denseBlockOf[n];
+            if(block >= 0 && m_denseBlocks[block].inputsOnly){
+                if(n == m_denseBlocks[block].srcBegin){
+                    runDenseBlock(m_denseBlocks[block], lanes);
+                }
+                continue;
+            }
+            auto sums = lanes.sums + n * L;
+            auto outputs = lanes.outputs + n * L;
+            switch(m_types[n]){
+                case Neuron::Type::INPUT:{
+                        for(auto c=begin;c<end;++c){
+                            auto destSums = lanes.sums + m_dest[c] * L;
+                            auto w = m_weights[c];
+                            // a connection could feed back into n, so sum is read on each connection.
+                            for(std::size_t b=0u;b<L;++b){
+                                outputs[b] = sums[b];
+                                destSums[b] += sums[b] * w;
+                            }
+                        }
+                }   break;
+                case Neuron::Type::CONTEXT:
+                case Neuron::Type::HIDDEN:{
+                        auto isContext = m_types[n] == Neuron::Type::CONTEXT;
+                        for(auto c=begin;c<end;++c){
+                            if(!isContext){
+                                for(std::size_t b=0u;b<L;++b){
+                                    sums[b] += m_biases[n];
+                                }
+                            }
+                            activate(n, lanes);
+                            auto dest = m_dest[c];
+                            auto destSums = lanes.sums + dest * L;
+                            auto w = m_weights[c];
+                            for(std::size_t b=0u;b<L;++b){
+                                destSums[b] += outputs[b] * w;
+                            }
+                            if(m_types[dest] == Neuron::Type::CONTEXT){
+                                storeContext(n, dest, c, lanes);
+                            }
+                        }
+                }   break;
+                case Neuron::Type::OUTPUT:
+                        for(auto c=begin;c<end;++c){
+                            storeOutput(n, m_dest[c], c, lanes);
+                        }
+                        break;
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::runNeuronMajor(Lanes lanes) const noexcept{
+        for(auto n:m_order){
+            auto begin = m_rowPtr[n];
+            auto end = m_rowPtr[n + 1];
+            if(begin == end){
+                continue;
+            }
+            auto block = m_denseBlockOf[n];
+            if(block >= 0){
+                if(n == m_denseBlocks[block].srcBegin){
+                    runDenseBlock(m_denseBlocks[block], lanes);
+                }
+                continue;
+            }
+            if(m_types[n] == Neuron::Type::OUTPUT){
+                for(auto c=begin;c<end;++c){
+                    storeOutput(n, m_dest[c], c, lanes);
+                }
+                continue;
+            }
+            finalize(n, lanes);
+            propagate(n, begin, end, lanes);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::runDenseBlock(const DenseBlock& block, Lanes lanes) const noexcept{
+        for(auto n=block.srcBegin;n<block.srcEnd;++n){
+            finalize(n, lanes);
+        }
+        addDenseBlock(block, 0u, block.destEnd - block.destBegin, lanes);
+        auto numConns = block.destEnd - block.destBegin;
+        for(auto n=block.srcBegin;n<block.srcEnd;++n){
+            auto denseBegin = m_rowPtr[n] + block.offset;
+            propagate(n, m_rowPtr[n], denseBegin, lanes);
+            propagate(n, denseBegin + numConns, m_rowPtr[n + 1], lanes);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::addDenseBlock(const DenseBlock& block, std::size_t destBegin, std::size_t destEnd, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        if(L == 1u){
+            // one lane, each source row is added to the dest sums with contiguous loads.
+            auto destSums = lanes.sums + block.destBegin;
+            for(auto n=block.srcBegin;n<block.srcEnd;++n){
+                auto weights = m_weights.data() + m_rowPtr[n] + block.offset;
+                auto out = lanes.outputs[n];
+                for(auto j=destBegin;j<destEnd;++j){
+                    destSums[j] += out * weights[j];
+                }
+            }
+        }else{
+            // [dest x lanes] tiles of DenseTile::rows x DenseTile::lanes are kept in registers while all the sources are added,
+            // each dest still adds the sources in the same order as the connections.
+            auto srcBegin = block.srcBegin;
+            auto numSrc = static_cast<std::size_t>(block.srcEnd - block.srcBegin);
+            auto rowPtr = m_rowPtr.data() + srcBegin;
+            auto weights = m_weights.data() + block.offset;
+            auto outputs = lanes.outputs + srcBegin * L;
+            auto sums = lanes.sums + block.destBegin * L;
+            auto fullDest = destEnd - (destEnd - destBegin) % DenseTile::rows;
+            auto fullLanes = L - L % DenseTile::lanes;
+            for(auto j=destBegin;j<fullDest;j+=DenseTile::rows){
+                for(std::size_t b=0u;b<fullLanes;b+=DenseTile::lanes){
+                    denseTile<T, DenseTile::rows, DenseTile::lanes>(weights, rowPtr, numSrc, outputs, sums, L, j, b);
+                }
+                denseEdge(weights, rowPtr, numSrc, outputs, sums, L, j, j + DenseTile::rows, fullLanes, L);
+            }
+            denseEdge(weights, rowPtr, numSrc, outputs, sums, L, fullDest, destEnd, 0u, L);
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::finalize(std::uint32_t n, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        auto sums = lanes.sums + n * L;
+        auto outputs = lanes.outputs + n * L;
+        switch(m_types[n]){
+            case Neuron::Type::INPUT:
+                    std::copy(sums, sums + L, outputs);
+                    break;
+            case Neuron::Type::HIDDEN:
+                    for(std::size_t b=0u;b<L;++b){
+                        sums[b] += m_biases[n];
+                    }
+                    activate(n, lanes);
+                    break;
+            case Neuron::Type::CONTEXT:
+                    activate(n, lanes);
+                    break;
+            case Neuron::Type::OUTPUT:
+                    break;
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::propagate(std::uint32_t n, std::uint32_t begin, std::uint32_t end, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        auto outputs = lanes.outputs + n * L;
+        for(auto c=begin;c<end;++c){
+            auto dest = m_dest[c];
+            auto destSums = lanes.sums + dest * L;
+            auto w = m_weights[c];
+            for(std::size_t b=0u;b<L;++b){
+                destSums[b] += outputs[b] * w;
+            }
+            // like NeuralNetwork::run, only hidden and context neurons are saved into context neurons.
+            if(m_types[dest] == Neuron::Type::CONTEXT && m_types[n] != Neuron::Type::INPUT){
+                storeContext(n, dest, c, lanes);
+            }
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::activate(std::uint32_t n, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        auto sums = lanes.sums + n * L;
+        auto outputs = lanes.outputs + n * L;
+        // a single lane, or a plan with exact activations, runs the scalar activation so it gives the same results as run().
+        auto scalar = L == 1u || m_exactActivations;
+        if(m_activationTable){
+            if(scalar){
+                for(std::size_t b=0u;b<L;++b){
+                    outputs[b] = static_cast<T>(m_activationTable->activate(m_activations[n], sums[b], m_biases[n]));
+                }
+            }else{
+                m_activationTable->activate(m_activations[n], sums, outputs, L, m_biases[n]);
+            }
+        }else if(scalar){
+            for(std::size_t b=0u;b<L;++b){
+                outputs[b] = static_cast<T>(Activations::activate(m_activations[n], sums[b], m_biases[n]));
+            }
+        }else{
+            Activations::Array::activate(m_activations[n], sums, outputs, L, m_biases[n]);
+        }
+        *lanes.activationCount += L;
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::storeContext(std::uint32_t src, std::uint32_t dest, std::uint32_t conn, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        auto srcSums = lanes.sums + src * L;
+        auto destSums = lanes.sums + dest * L;
+        auto destOutputs = lanes.outputs + dest * L;
+        auto cycles = lanes.cycles + conn * L;
+        for(std::size_t b=0u;b<L;++b){
+            if(cycles[b] > m_cyclesLimits[dest]){
+                destSums[b] = 0.0;
+                destOutputs[b] = 0.0;
+                cycles[b] = 0;
+            }
+            destSums[b] = srcSums[b];
+            ++cycles[b];
+        }
+    }
+    template<typename T>
+    void BasicExecutionPlan<T>::storeOutput(std::uint32_t src, std::uint32_t dest, std::uint32_t conn, Lanes lanes) const noexcept{
+        auto L = lanes.size;
+        auto srcSums = lanes.sums + src * L;
+        auto destSums = lanes.sums + dest * L;
+        auto destOutputs = lanes.outputs + dest * L;
+        auto cycles = lanes.cycles + conn * L;
+        for(std::size_t b=0u;b<L;++b){
+            auto oldSum = srcSums[b];
+            srcSums[b] += m_biases[src];
+            if(cycles[b] > m_cyclesLimits[dest]){
+                destSums[b] = 0.0;
+                destOutputs[b] = 0.0;
+                cycles[b] = 0;
+            }
+            destSums[b] = srcSums[b];
+            srcSums[b] = oldSum;
+            ++cycles[b];
+        }
+    }
+    template class BasicExecutionPlan<double>;
+    template class BasicExecutionPlan<float>;
+}
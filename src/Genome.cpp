@@ -4,6 +4,8 @@
 #include <random>
 #include <algorithm>
 #include <optional>
+#include <array>
+#include <set>
 //#include <execution>
 #include <cassert>
 #include <future>
@@ -724,6 +726,153 @@ namespace EvoAI{
         }
         return nn;
     }
+    NeuralNetwork Genome::makeLayeredPhenotype(const Genome& g) noexcept{
+        // the genes of each layer by id, the id is the position of the neuron.
+        std::array<std::vector<const NodeGene*>, 3> genes;
+        for(auto& n:g.getNodeChromosomes()){
+            if(n.getLayerID() < genes.size()){
+                genes[n.getLayerID()].emplace_back(&n);
+            }
+        }
+        auto byID = [](const NodeGene* lhs, const NodeGene* rhs){
+            return lhs->getNeuronID() < rhs->getNeuronID();
+        };
+        auto sameID = [](const NodeGene* lhs, const NodeGene* rhs){
+            return lhs->getNeuronID() == rhs->getNeuronID();
+        };
+        for(auto& layer:genes){
+            std::stable_sort(std::begin(layer), std::end(layer), byID);
+            layer.erase(std::unique(std::begin(layer), std::end(layer), sameID), std::end(layer));
+        }
+        auto position = [&](const Link& l) -> std::optional<std::size_t>{
+            if(l.layer >= genes.size()){
+                return std::nullopt;
+            }
+            auto& layer = genes[l.layer];
+            auto it = std::lower_bound(std::begin(layer), std::end(layer), l.neuron, [](const NodeGene* ng, std::size_t id){
+                return ng->getNeuronID() < id;
+            });
+            if(it == std::end(layer) || (*it)->getNeuronID() != l.neuron){
+                return std::nullopt;
+            }
+            return static_cast<std::size_t>(std::distance(std::begin(layer), it));
+        };
+        struct Edge{
+            Link src;
+            Link dest;
+            const ConnectionGene* gene;
+        };
+        std::vector<Edge> edges;
+        for(auto& cg:g.getConnectionChromosomes()){
+            auto src = position(cg.getSrc());
+            auto dest = position(cg.getDest());
+            if(cg.isEnabled() && src && dest){
+                edges.push_back({Link(cg.getSrc().layer, *src), Link(cg.getDest().layer, *dest), &cg});
+            }
+        }
+        // depth of the hidden nodes in topological order, the lowest id goes first.
+        auto numHidden = genes[1].size();
+        std::vector<std::vector<std::size_t>> next(numHidden);
+        std::vector<std::size_t> numPrevious(numHidden, 0u);
+        for(auto& e:edges){
+            if(e.src.layer == 1u && e.dest.layer == 1u && e.src.neuron != e.dest.neuron){
+                next[e.src.neuron].emplace_back(e.dest.neuron);
+                ++numPrevious[e.dest.neuron];
+            }
+        }
+        std::vector<std::size_t> depth(numHidden, 1u);
+        std::vector<bool> placed(numHidden, false);
+        std::set<std::size_t> ready;
+        for(auto h=0u;h<numHidden;++h){
+            if(numPrevious[h] == 0u){
+                ready.emplace(h);
+            }
+        }
+        auto maxDepth = 0u;
+        auto lowestUnplaced = 0u;
+        for(auto numPlaced=0u;numPlaced<numHidden;++numPlaced){
+            if(ready.empty()){
+                // a cycle, the connections to the node with the lowest id that are left will be recurrent.
+                while(placed[lowestUnplaced]){
+                    ++lowestUnplaced;
+                }
+                ready.emplace(lowestUnplaced);
+            }
+            auto h = *std::begin(ready);
+            ready.erase(std::begin(ready));
+            placed[h] = true;
+            maxDepth = std::max<std::size_t>(maxDepth, depth[h]);
+            for(auto k:next[h]){
+                if(!placed[k]){
+                    depth[k] = std::max(depth[k], depth[h] + 1u);
+                    if(--numPrevious[k] == 0u){
+                        ready.emplace(k);
+                    }
+                }
+            }
+        }
+        auto makeNeuron = [](const NodeGene& n){
+            Neuron nrn(n.getNeuronType());
+            nrn.setActivationType(n.getActType());
+            nrn.setBiasWeight(n.getBias());
+            return nrn;
+        };
+        auto makeLayer = [](Neuron::Type type){
+            NeuronLayer layer;
+            layer.setType(type);
+            layer.setBias(1.0);
+            return layer;
+        };
+        auto outputLayerID = maxDepth + 1u;
+        std::vector<NeuronLayer> layers;
+        layers.reserve(outputLayerID + 1u);
+        layers.emplace_back(makeLayer(Neuron::Type::INPUT));
+        for(auto n:genes[0]){
+            layers.back().addNeuron(makeNeuron(*n));
+        }
+        std::vector<Link> hiddenLinks;
+        hiddenLinks.reserve(numHidden);
+        for(auto d=1u;d<=maxDepth;++d){
+            layers.emplace_back(makeLayer(Neuron::Type::HIDDEN));
+        }
+        for(auto h=0u;h<numHidden;++h){
+            auto& layer = layers[depth[h]];
+            hiddenLinks.emplace_back(depth[h], layer.size());
+            layer.addNeuron(makeNeuron(*genes[1][h]));
+        }
+        layers.emplace_back(makeLayer(Neuron::Type::OUTPUT));
+        for(auto n:genes[2]){
+            layers.back().addNeuron(makeNeuron(*n));
+        }
+        auto& outputs = layers.back().getNeurons();
+        if(!outputs.empty()){
+            auto actType = outputs[0].getActivationType();
+            if(std::all_of(std::begin(outputs), std::end(outputs), [actType](auto& n){ return n.getActivationType() == actType; })){
+                layers.back().setActivationType(actType);
+            }
+        }
+        auto nn = NeuralNetwork();
+        for(auto& layer:layers){
+            nn.addLayer(layer);
+        }
+        auto toLink = [&](const Link& l){
+            switch(l.layer){
+                case 0u:
+                    return l;
+                case 1u:
+                    return hiddenLinks[l.neuron];
+                default:
+                    return Link(outputLayerID, l.neuron);
+            }
+        };
+        for(auto& e:edges){
+            auto c = e.gene->getConnection();
+            c.setSrc(toLink(e.src));
+            c.setDest(toLink(e.dest));
+            nn.addConnection(c);
+        }
+        return nn;
+    }
     Genome Genome::makeGenome(NeuralNetwork& nn) noexcept{
         auto g = Genome();
         std::vector<NodeGene> nGenes;
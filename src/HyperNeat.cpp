@@ -1,6 +1,36 @@
 #include <EvoAI/HyperNeat.hpp>
 #include <EvoAI/Genome.hpp>
 
+namespace{
+    /**
+     * @brief queries the cppn with each row of inputs, the cppn needs to be compiled.
+     * @details when the cppn doesn't have context neurons the rows are independent
+     * and they run together through NeuralNetwork::forwardBatch, with ExecutionPlan::setExactActivations
+     * so the leo of each connection is the same one run would give.
+     * @param cppn EvoAI::NeuralNetwork&
+     * @param inputs const std::vector<double>& row-major [rows x cppn inputs]
+     * @param rows std::size_t
+     * @return std::vector<double> row-major [rows x cppn outputs]
+     */
+    std::vector<double> queryCppn(EvoAI::NeuralNetwork& cppn, const std::vector<double>& inputs, std::size_t rows) noexcept{
+        if(rows == 0u){
+            return {};
+        }
+        if(!cppn.getExecutionPlan().hasContext()){
+            return cppn.forwardBatch(inputs, rows);
+        }
+        auto numInputs = inputs.size() / rows;
+        std::vector<double> outputs;
+        for(auto r=0u;r<rows;++r){
+            auto begin = std::begin(inputs) + r * numInputs;
+            auto out = cppn.forward(std::vector<double>(begin, begin + numInputs));
+            cppn.reset();
+            outputs.insert(std::end(outputs), std::begin(out), std::end(out));
+        }
+        return outputs;
+    }
+}
+
 namespace EvoAI{
     SubstrateInfo::SubstrateInfo()
     : numInputs(0)
@@ -70,6 +100,7 @@ namespace EvoAI{
     , substrate(o["Substrate"].getObject())
     , substrateInfo(o["substrateInfo"].getObject())
     , substrateConf(SubstrateConfigurationToEnum(o["substrateConf"].getString()))
+    , cppnActivationTable()
     , isSubstrateValid(false)
     , isSubstrateReady(true){
         makeSubstrate();
@@ -79,6 +110,7 @@ namespace EvoAI{
     , substrate()
     , substrateInfo()
     , substrateConf(SubstrateConfiguration::GRID)
+    , cppnActivationTable()
     , isSubstrateValid(false)
     , isSubstrateReady(true){
         JsonBox::Value json;
@@ -95,6 +127,7 @@ namespace EvoAI{
     , substrate(si.numInputs, si.numHiddenLayers,si.numHiddenNeurons,si.numOutputs, 1.0)
     , substrateInfo(si)
     , substrateConf(sc)
+    , cppnActivationTable()
     , isSubstrateValid(false)
     , isSubstrateReady(true){
         makeSubstrate();
@@ -104,6 +137,7 @@ namespace EvoAI{
     , substrate(si.numInputs, si.numHiddenLayers,si.numHiddenNeurons,si.numOutputs, 1.0)
     , substrateInfo(si)
     , substrateConf(sc)
+    , cppnActivationTable()
     , isSubstrateValid(false)
     , isSubstrateReady(true){
         switch(sc){
@@ -156,6 +190,13 @@ namespace EvoAI{
     const Genome& HyperNeat::getGenome() const noexcept{
         return genome;
     }
+    void HyperNeat::setCppnActivationTable(std::shared_ptr<const Activations::LookupTable> table) noexcept{
+        isSubstrateValid = false;
+        cppnActivationTable = std::move(table);
+    }
+    const std::shared_ptr<const Activations::LookupTable>& HyperNeat::getCppnActivationTable() const noexcept{
+        return cppnActivationTable;
+    }
     void HyperNeat::setSubstrate(NeuralNetwork&& subst) noexcept{
         isSubstrateReady = true;
         isSubstrateValid = true;
@@ -176,15 +217,28 @@ namespace EvoAI{
                     /// Genome has 5 inputs x1,x2, y1,y2, d
                     /// Genome has 2 outputs weight and leo.
                     auto nn = Genome::makePhenotype(genome);
+                    nn.setActivationTable(cppnActivationTable);
+                    nn.compile();
+                    nn.getExecutionPlan().setExactActivations(true);
+                    std::vector<double> inputs;
                     for(auto x1=0u;x1<substrate.size();++x1){
                         for(auto y1=0u;y1<substrate[x1].size();++y1){
+                            inputs.clear();
+                            auto rows = 0u;
                             for(auto x2=0u;x2<substrate.size();++x2){
                                 for(auto y2=0u;y2<substrate[x2].size();++y2){
                                     auto sized = static_cast<double>(substrate.size());
                                     auto d = EvoAI::distanceCenter<double>(static_cast<double>(x1),static_cast<double>(y1), sized, static_cast<double>(substrate[x1].size())) +
                                         EvoAI::distanceCenter<double>(static_cast<double>(x2),static_cast<double>(y2), sized, static_cast<double>(substrate[x2].size()));
-                                    auto out = nn.forward({static_cast<double>(x1), static_cast<double>(y1), static_cast<double>(x2), static_cast<double>(y2), static_cast<double>(d)});
-                                    nn.reset();
+                                    inputs.insert(std::end(inputs), {static_cast<double>(x1), static_cast<double>(y1), static_cast<double>(x2), static_cast<double>(y2), static_cast<double>(d)});
+                                    ++rows;
+                                }
+                            }
+                            auto outputs = queryCppn(nn, inputs, rows);
+                            auto row = 0u;
+                            for(auto x2=0u;x2<substrate.size();++x2){
+                                for(auto y2=0u;y2<substrate[x2].size();++y2){
+                                    auto out = &outputs[2 * row++];
                                     if(out[1] >= substrateInfo.leo){
                                         auto weight = std::clamp(out[0], -substrateInfo.minmaxWeight, substrateInfo.minmaxWeight);
                                         auto c = Connection(Link(x1, y1), Link(x2, y2), weight);
@@ -206,11 +260,20 @@ namespace EvoAI{
                     auto& neurons = substrate.getNeurons();
                     auto size = neurons.size();
                     auto nn = Genome::makePhenotype(genome);
+                    nn.setActivationTable(cppnActivationTable);
+                    nn.compile();
+                    nn.getExecutionPlan().setExactActivations(true);
+                    std::vector<double> inputs;
+                    inputs.reserve(size * 3);
                     for(auto i=0u;i<size;++i){
+                        inputs.clear();
                         for(auto j=0u;j<size;++j){
                             auto d = EvoAI::distanceCenter<double>(static_cast<double>(i), static_cast<double>(j), static_cast<double>(size), static_cast<double>(size));
-                            auto out = nn.forward({static_cast<double>(i), static_cast<double>(j), d});
-                            nn.reset();
+                            inputs.insert(std::end(inputs), {static_cast<double>(i), static_cast<double>(j), d});
+                        }
+                        auto outputs = queryCppn(nn, inputs, size);
+                        for(auto j=0u;j<size;++j){
+                            auto out = &outputs[2 * j];
                             if(out[1] >= substrateInfo.leo){
                                 auto weight = std::clamp(out[0], -substrateInfo.minmaxWeight, substrateInfo.minmaxWeight);
                                 auto c = Connection(substrate.getIndex(neurons[i]),substrate.getIndex(neurons[j]), weight);
@@ -252,6 +315,12 @@ namespace EvoAI{
         setInputs(std::forward<std::vector<double>>(input));
         return run();
     }
+    bool HyperNeat::forward(const double* inputs, std::size_t numInputs, double* outputs, std::size_t numOutputs) noexcept{
+        if(!isSubstrateValid){
+            makeSubstrate();
+        }
+        return substrate.forward(inputs, numInputs, outputs, numOutputs);
+    }
     void HyperNeat::backward(std::vector<double>&& gradientLoss) noexcept{
         if(!isSubstrateValid){
             makeSubstrate();
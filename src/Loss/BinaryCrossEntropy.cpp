@@ -22,5 +22,15 @@ namespace EvoAI{
             }
             return grads;
         }
+        double BinaryCrossEntropy::lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+            double sum = 0.0;
+            const double epsilon = 1e-15;
+            for(auto i=0u;i<size;++i){
+                auto out = std::clamp(outputs[i], epsilon, 1.0 - epsilon);
+                sum += expectedOutputs[i] * std::log(out) + (1.0 - expectedOutputs[i]) * std::log(1.0 - out);
+                gradients[i] = -((expectedOutputs[i] - outputs[i]) / (out * (1.0 - out)));
+            }
+            return -(sum / size);
+        }
     }
 }
\ No newline at end of file
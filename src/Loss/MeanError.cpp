@@ -18,5 +18,13 @@ namespace EvoAI{
             }
             return grads;
         }
+        double MeanError::lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+            double totalError = 0.0;
+            for(auto i=0u;i<size;++i){
+                totalError += outputs[i] - expectedOutputs[i];
+                gradients[i] = 1.0 / size;
+            }
+            return totalError / size;
+        }
     }
 }
\ No newline at end of file
@@ -19,5 +19,14 @@ namespace EvoAI{
             }
             return grads;
         }
+        double MeanSquaredError::lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+            double totalError = 0.0;
+            for(auto i=0u;i<size;++i){
+                auto error = outputs[i] - expectedOutputs[i];
+                totalError += error * error;
+                gradients[i] = (2.0 * error) / size;
+            }
+            return totalError / size;
+        }
     }
 }
\ No newline at end of file
@@ -22,5 +22,26 @@ namespace EvoAI{
             }
             return grads;
         }
+        double MultiClassCrossEntropy::lossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+            double sum = 0.0;
+            const double epsilon = 1e-15;
+            for(auto i=0u;i<size;++i){
+                auto out = std::clamp(outputs[i], epsilon, 1.0 - epsilon);
+                sum += expectedOutputs[i] * std::log(out);
+                gradients[i] = (1.0 - expectedOutputs[i]) / (1.0 - out) - expectedOutputs[i] / out;
+            }
+            return -(sum / size);
+        }
+        double MultiClassCrossEntropy::softmaxLossAndGrad(const double* expectedOutputs, const double* outputs, double* gradients, std::size_t size) noexcept{
+            double sum = 0.0;
+            const double epsilon = 1e-15;
+            for(auto i=0u;i<size;++i){
+                auto out = std::clamp(outputs[i], epsilon, 1.0 - epsilon);
+                sum += expectedOutputs[i] * std::log(out);
+                // outputs * (1.0 - outputs) * backward without dividing by the clamped outputs.
+                gradients[i] = outputs[i] - expectedOutputs[i];
+            }
+            return -(sum / size);
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include <EvoAI/ModelFile.hpp>
+#include <EvoAI/NeuralNetwork.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace{
+    constexpr char Magic[8] = "EVOAINN";
+    /**
+     * @brief rounds offset up to the alignment of the tables.
+     */
+    constexpr std::uint64_t align(std::uint64_t offset) noexcept{
+        return (offset + 7u) & ~std::uint64_t{7u};
+    }
+    template<typename Record>
+    void copyTable(std::vector<unsigned char>& buffer, std::uint64_t offset, const std::vector<Record>& records) noexcept{
+        if(!records.empty()){
+            std::memcpy(buffer.data() + offset, records.data(), records.size() * sizeof(Record));
+        }
+    }
+}
+
+namespace EvoAI{
+    ModelFile::ModelFile() noexcept
+    : m_data(nullptr)
+    , m_size(0u)
+    , m_mapping(nullptr)
+    , m_valid(false){}
+    ModelFile::ModelFile(const std::string& filename)
+    : ModelFile(){
+#if defined(_WIN32)
+        auto file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE){
+            return;
+        }
+        LARGE_INTEGER fileSize;
+        if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0){
+            m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if(m_mapping){
+                m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                m_size = m_data ? static_cast<std::size_t>(fileSize.QuadPart) : 0u;
+            }
+        }
+        CloseHandle(file);
+#else
+        auto fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd < 0){
+            return;
+        }
+        struct stat st;
+        if(::fstat(fd, &st) == 0 && st.st_size > 0){
+            auto data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data != MAP_FAILED){
+                m_data = static_cast<const unsigned char*>(data);
+                m_size = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+        m_valid = validate();
+    }
+    ModelFile::ModelFile(ModelFile&& rhs) noexcept
+    : m_data(rhs.m_data)
+    , m_size(rhs.m_size)
+    , m_mapping(rhs.m_mapping)
+    , m_valid(rhs.m_valid){
+        rhs.m_data = nullptr;
+        rhs.m_size = 0u;
+        rhs.m_mapping = nullptr;
+        rhs.m_valid = false;
+    }
+    ModelFile& ModelFile::operator=(ModelFile&& rhs) noexcept{
+        if(this != &rhs){
+            unmap();
+            m_data = rhs.m_data;
+            m_size = rhs.m_size;
+            m_mapping = rhs.m_mapping;
+            m_valid = rhs.m_valid;
+            rhs.m_data = nullptr;
+            rhs.m_size = 0u;
+            rhs.m_mapping = nullptr;
+            rhs.m_valid = false;
+        }
+        return *this;
+    }
+    bool ModelFile::write(NeuralNetwork& nn, const std::string& filename){
+        std::vector<LayerRecord> layers;
+        std::vector<NeuronRecord> neurons;
+        std::vector<std::uint32_t> rowPtr;
+        std::vector<ConnectionRecord> connections;
+        std::vector<double> weights;
+        std::vector<double> biases;
+        std::vector<std::uint32_t> layerOffsets;
+        layers.reserve(nn.size());
+        layerOffsets.reserve(nn.size() + 1u);
+        layerOffsets.emplace_back(0u);
+        for(auto i=0u;i<nn.size();++i){
+            auto& layer = nn[i];
+            layers.emplace_back(LayerRecord{layerOffsets.back(), static_cast<std::uint32_t>(layer.size()),
+                                            static_cast<std::uint32_t>(layer.getType()),
+                                            static_cast<std::uint32_t>(layer.getActivationType()),
+                                            layer.getCyclesLimit(), 0u, layer.getBias()});
+            layerOffsets.emplace_back(layerOffsets.back() + layer.size());
+        }
+        rowPtr.emplace_back(0u);
+        for(auto i=0u;i<nn.size();++i){
+            for(auto& n:nn[i].getNeurons()){
+                auto bias = n.getBiasPtr();
+                neurons.emplace_back(NeuronRecord{static_cast<std::uint8_t>(n.getType()),
+                                                  static_cast<std::uint8_t>(n.getActivationType()),
+                                                  static_cast<std::uint8_t>(bias->isFrozen() ? FrozenFlag : 0u), 0u});
+                biases.emplace_back(bias->getWeight());
+                for(auto& c:n.getConnections()){
+                    auto& dest = c.getDest();
+                    if(dest.layer >= nn.size() || dest.neuron >= nn[dest.layer].size()){
+                        return false;
+                    }
+                    connections.emplace_back(ConnectionRecord{static_cast<std::uint32_t>(layerOffsets[dest.layer] + dest.neuron),
+                                                              c.isFrozen() ? FrozenFlag : 0u});
+                    weights.emplace_back(c.getWeight());
+                }
+                rowPtr.emplace_back(static_cast<std::uint32_t>(connections.size()));
+            }
+        }
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(header.magic));
+        header.version = Version;
+        header.byteOrder = ByteOrderMark;
+        header.globalStep = nn.getGlobalStep();
+        header.numLayers = static_cast<std::uint32_t>(layers.size());
+        header.numNeurons = static_cast<std::uint32_t>(neurons.size());
+        header.numConnections = static_cast<std::uint32_t>(connections.size());
+        header.layersOffset = align(sizeof(Header));
+        header.neuronsOffset = align(header.layersOffset + layers.size() * sizeof(LayerRecord));
+        header.rowPtrOffset = align(header.neuronsOffset + neurons.size() * sizeof(NeuronRecord));
+        header.connectionsOffset = align(header.rowPtrOffset + rowPtr.size() * sizeof(std::uint32_t));
+        header.weightsOffset = align(header.connectionsOffset + connections.size() * sizeof(ConnectionRecord));
+        header.biasesOffset = align(header.weightsOffset + weights.size() * sizeof(double));
+        header.fileSize = header.biasesOffset + biases.size() * sizeof(double);
+        std::vector<unsigned char> buffer(header.fileSize, 0u);
+        std::memcpy(buffer.data(), &header, sizeof(Header));
+        copyTable(buffer, header.layersOffset, layers);
+        copyTable(buffer, header.neuronsOffset, neurons);
+        copyTable(buffer, header.rowPtrOffset, rowPtr);
+        copyTable(buffer, header.connectionsOffset, connections);
+        copyTable(buffer, header.weightsOffset, weights);
+        copyTable(buffer, header.biasesOffset, biases);
+        std::ofstream out(filename, std::ios_base::out | std::ios_base::binary);
+        out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return static_cast<bool>(out);
+    }
+    bool ModelFile::jsonToBinary(const std::string& jsonFile, const std::string& binaryFile){
+        NeuralNetwork nn(jsonFile);
+        return write(nn, binaryFile);
+    }
+    bool ModelFile::binaryToJson(const std::string& binaryFile, const std::string& jsonFile){
+        ModelFile model(binaryFile);
+        if(!model.isValid()){
+            return false;
+        }
+        NeuralNetwork(model).writeToFile(jsonFile);
+        return true;
+    }
+    ModelFile::~ModelFile(){
+        unmap();
+    }
+//private member functions
+    bool ModelFile::validate() const noexcept{
+        if(!m_data || m_size < sizeof(Header)){
+            return false;
+        }
+        auto& header = getHeader();
+        if(std::memcmp(header.magic, Magic, sizeof(header.magic)) != 0 || header.version != Version ||
+                header.byteOrder != ByteOrderMark || header.fileSize != m_size){
+            return false;
+        }
+        auto fits = [this](std::uint64_t offset, std::uint64_t bytes){
+            return offset % 8u == 0u && offset >= sizeof(Header) && offset <= m_size && bytes <= m_size - offset;
+        };
+        if(!fits(header.layersOffset, header.numLayers * std::uint64_t{sizeof(LayerRecord)}) ||
+                !fits(header.neuronsOffset, header.numNeurons * std::uint64_t{sizeof(NeuronRecord)}) ||
+                !fits(header.rowPtrOffset, (header.numNeurons + std::uint64_t{1u}) * sizeof(std::uint32_t)) ||
+                !fits(header.connectionsOffset, header.numConnections * std::uint64_t{sizeof(ConnectionRecord)}) ||
+                !fits(header.weightsOffset, header.numConnections * std::uint64_t{sizeof(double)}) ||
+                !fits(header.biasesOffset, header.numNeurons * std::uint64_t{sizeof(double)})){
+            return false;
+        }
+        auto isType = [](std::uint32_t type){ return type <= Neuron::Type::OUTPUT; };
+        auto isActivation = [](std::uint32_t activation){
+            return activation <= Neuron::ActivationType::SOFTMAX && activation != Neuron::ActivationType::LAST_CPPN_ACTIVATION_TYPE;
+        };
+        auto layers = getLayers();
+        std::uint64_t numNeurons = 0u;
+        for(auto i=0u;i<header.numLayers;++i){
+            if(layers[i].firstNeuron != numNeurons || !isType(layers[i].neuronType) || !isActivation(layers[i].activationType)){
+                return false;
+            }
+            numNeurons += layers[i].numNeurons;
+        }
+        if(numNeurons != header.numNeurons){
+            return false;
+        }
+        auto neurons = getNeurons();
+        for(auto i=0u;i<header.numNeurons;++i){
+            if(!isType(neurons[i].type) || !isActivation(neurons[i].activationType)){
+                return false;
+            }
+        }
+        auto rowPtr = getRowPtr();
+        if(rowPtr[0] != 0u || rowPtr[header.numNeurons] != header.numConnections){
+            return false;
+        }
+        for(auto i=0u;i<header.numNeurons;++i){
+            if(rowPtr[i] > rowPtr[i + 1u]){
+                return false;
+            }
+        }
+        auto connections = getConnections();
+        for(auto i=0u;i<header.numConnections;++i){
+            if(connections[i].dest >= header.numNeurons){
+                return false;
+            }
+        }
+        return true;
+    }
+    void ModelFile::unmap() noexcept{
+        if(m_data){
+#if defined(_WIN32)
+            UnmapViewOfFile(m_data);
+#else
+            ::munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+        }
+#if defined(_WIN32)
+        if(m_mapping){
+            CloseHandle(m_mapping);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0u;
+        m_mapping = nullptr;
+        m_valid = false;
+    }
+}
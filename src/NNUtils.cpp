@@ -1,5 +1,7 @@
 #include <EvoAI/Utils/NNUtils.hpp>
+#include <EvoAI/Activations.hpp>
 #include <fstream>
+#include <set>
 
 namespace EvoAI{
     std::unique_ptr<NeuralNetwork> createFeedForwardNN(const size_t& numInputs, const size_t& numHidden,
@@ -295,4 +297,381 @@ namespace EvoAI{
                 return n1.getOutput() < n2.getOutput();
         }));
     }
+    AccuracyReport compareFloatPlan(NeuralNetwork& nn, const std::vector<double>& inputs, std::size_t batchSize) noexcept{
+        ExecutionPlan reference(nn);
+        ExecutionPlanF plan(nn);
+        auto outputs = plan.forwardBatch(std::vector<float>(std::begin(inputs), std::end(inputs)), batchSize);
+        return compareOutputs(reference.forwardBatch(inputs, batchSize), outputs, reference.numOutputs());
+    }
+    PhenotypeReport optimizePhenotype(NeuralNetwork& nn, bool foldConstants) noexcept{
+        PhenotypeReport report;
+        if(nn.size() < 2u){
+            return report;
+        }
+        auto layers = std::move(nn.getLayers());
+        auto lastLayer = layers.size() - 1;
+        // the bias of a hidden neuron is added for each connection, the connections before the last one kept
+        // see a different sum, so only a run of removable connections at the end can go.
+        auto keepSuffix = [](const Neuron& src, std::vector<bool>& remove){
+            if(src.getType() != Neuron::Type::HIDDEN || src.getBiasWeight() == 0.0){
+                return;
+            }
+            auto i = remove.size();
+            while(i > 0u && remove[i - 1]){
+                --i;
+            }
+            std::fill(std::begin(remove), std::begin(remove) + i, false);
+        };
+        auto erase = [](Neuron& src, const std::vector<bool>& remove){
+            auto& conns = src.getConnections();
+            std::size_t removed = 0u;
+            auto i = 0u;
+            conns.erase(std::remove_if(std::begin(conns), std::end(conns), [&](const Connection&){
+                return remove[i++];
+            }), std::end(conns));
+            for(auto r:remove){
+                removed += r ? 1u:0u;
+            }
+            return removed;
+        };
+        auto changed = true;
+        while(changed){
+            changed = false;
+            // neurons numbered layer by layer, like ExecutionPlan.
+            std::vector<std::size_t> first(layers.size() + 1, 0u);
+            for(auto l=0u;l<layers.size();++l){
+                first[l + 1] = first[l] + layers[l].size();
+            }
+            auto index = [&](const Link& link){ return first[link.layer] + link.neuron; };
+            auto neuronAt = [&](const Link& link) -> Neuron&{ return layers[link.layer][link.neuron]; };
+            auto numNeurons = first.back();
+            std::vector<std::vector<std::size_t>> sources(numNeurons);
+            for(auto& l:layers){
+                for(auto& n:l.getNeurons()){
+                    for(auto& c:n.getConnections()){
+                        sources[index(c.getDest())].emplace_back(index(c.getSrc()));
+                    }
+                }
+            }
+            std::vector<bool> live(numNeurons, false);
+            std::vector<std::size_t> pending;
+            for(auto i=first[lastLayer];i<numNeurons;++i){
+                live[i] = true;
+                pending.emplace_back(i);
+            }
+            while(!pending.empty()){
+                auto n = pending.back();
+                pending.pop_back();
+                for(auto src:sources[n]){
+                    if(!live[src]){
+                        live[src] = true;
+                        pending.emplace_back(src);
+                    }
+                }
+            }
+            // connections to dead neurons and with a weight of 0.0, a context neuron takes the sum of the source
+            // and an output neuron its own sum whatever the weight is.
+            for(auto& l:layers){
+                for(auto& n:l.getNeurons()){
+                    auto& conns = n.getConnections();
+                    std::vector<bool> remove(conns.size(), false);
+                    for(auto i=0u;i<conns.size();++i){
+                        auto& dest = neuronAt(conns[i].getDest());
+                        remove[i] = !live[index(conns[i].getDest())]
+                                    || (conns[i].getWeight() == 0.0 && dest.getType() != Neuron::Type::CONTEXT
+                                        && n.getType() != Neuron::Type::OUTPUT);
+                    }
+                    keepSuffix(n, remove);
+                    auto removed = erase(n, remove);
+                    report.removedConnections += removed;
+                    changed = changed || removed > 0u;
+                }
+            }
+            if(foldConstants){
+                // parallel connections from a neuron that gives the same output to all of them.
+                for(auto l=0u;l<layers.size();++l){
+                    for(auto j=0u;j<layers[l].size();++j){
+                        auto& n = layers[l][j];
+                        auto& conns = n.getConnections();
+                        auto selfConnected = std::any_of(std::begin(conns), std::end(conns), [&](const Connection& c){
+                            return index(c.getDest()) == first[l] + j;
+                        });
+                        auto sameOutput = n.getType() == Neuron::Type::INPUT || n.getType() == Neuron::Type::CONTEXT
+                                            || (n.getType() == Neuron::Type::HIDDEN && n.getBiasWeight() == 0.0);
+                        if(!sameOutput || selfConnected || n.getActivationType() == Neuron::ActivationType::NOISY_RELU){
+                            continue;
+                        }
+                        std::vector<bool> remove(conns.size(), false);
+                        for(auto i=0u;i<conns.size();++i){
+                            if(neuronAt(conns[i].getDest()).getType() == Neuron::Type::CONTEXT){
+                                continue;
+                            }
+                            for(auto k=0u;k<i;++k){
+                                if(!remove[k] && conns[k].getDest() == conns[i].getDest()){
+                                    conns[k].setWeight(conns[k].getWeight() + conns[i].getWeight());
+                                    remove[i] = true;
+                                    break;
+                                }
+                            }
+                        }
+                        auto removed = erase(n, remove);
+                        report.mergedConnections += removed;
+                        report.removedConnections += removed;
+                        changed = changed || removed > 0u;
+                    }
+                }
+                // hidden neurons without inputs, their sum starts at 0.0 so each connection gives a constant.
+                // an output neuron connected to another one overwrites its sum.
+                std::vector<bool> hasInputs(numNeurons, false);
+                std::vector<bool> overwritten(numNeurons, false);
+                for(auto& l:layers){
+                    for(auto& n:l.getNeurons()){
+                        for(auto& c:n.getConnections()){
+                            hasInputs[index(c.getDest())] = true;
+                            if(n.getType() == Neuron::Type::OUTPUT){
+                                overwritten[index(c.getDest())] = true;
+                            }
+                        }
+                    }
+                }
+                for(auto l=1u;l<lastLayer;++l){
+                    for(auto j=0u;j<layers[l].size();++j){
+                        auto& n = layers[l][j];
+                        auto& conns = n.getConnections();
+                        if(n.getType() != Neuron::Type::HIDDEN || hasInputs[first[l] + j] || conns.empty()
+                            || n.getActivationType() == Neuron::ActivationType::NOISY_RELU){
+                            continue;
+                        }
+                        std::vector<bool> remove(conns.size(), false);
+                        std::vector<double> values(conns.size(), 0.0);
+                        auto sum = 0.0;
+                        for(auto i=0u;i<conns.size();++i){
+                            sum += n.getBiasWeight();
+                            values[i] = Activations::activate(n.getActivationType(), sum, n.getBiasWeight()) * conns[i].getWeight();
+                            auto& destLink = conns[i].getDest();
+                            auto& dest = neuronAt(destLink);
+                            // the bias is the parameter of swish, and a hidden neuron adds it for each connection.
+                            auto isOutput = destLink.layer == lastLayer && dest.getType() == Neuron::Type::OUTPUT;
+                            auto isHidden = dest.getType() == Neuron::Type::HIDDEN && dest.size() == 1u
+                                            && index(destLink) > first[l] + j;
+                            remove[i] = (isOutput || isHidden) && !overwritten[index(destLink)]
+                                        && dest.getActivationType() != Neuron::ActivationType::SWISH;
+                        }
+                        keepSuffix(n, remove);
+                        for(auto i=0u;i<conns.size();++i){
+                            if(remove[i]){
+                                auto& dest = neuronAt(conns[i].getDest());
+                                dest.setBiasWeight(dest.getBiasWeight() + values[i]);
+                            }
+                        }
+                        auto removed = erase(n, remove);
+                        report.foldedConnections += removed;
+                        report.removedConnections += removed;
+                        changed = changed || removed > 0u;
+                    }
+                }
+            }
+            // hidden and context neurons without connections.
+            std::vector<bool> connected(numNeurons, false);
+            for(auto& l:layers){
+                for(auto& n:l.getNeurons()){
+                    for(auto& c:n.getConnections()){
+                        connected[index(c.getSrc())] = true;
+                        connected[index(c.getDest())] = true;
+                    }
+                }
+            }
+            std::vector<std::vector<std::size_t>> newIndex(layers.size());
+            for(auto l=0u;l<layers.size();++l){
+                auto& neurons = layers[l].getNeurons();
+                newIndex[l].resize(neurons.size());
+                std::vector<Neuron> kept;
+                kept.reserve(neurons.size());
+                for(auto j=0u;j<neurons.size();++j){
+                    newIndex[l][j] = kept.size();
+                    if(l == 0u || l == lastLayer || connected[first[l] + j]){
+                        kept.emplace_back(std::move(neurons[j]));
+                    }
+                }
+                if(kept.size() != neurons.size()){
+                    report.removedNeurons += neurons.size() - kept.size();
+                    changed = true;
+                    layers[l].setNeurons(std::move(kept));
+                }
+            }
+            for(auto& l:layers){
+                for(auto& n:l.getNeurons()){
+                    for(auto& c:n.getConnections()){
+                        auto src = c.getSrc();
+                        auto dest = c.getDest();
+                        c.setSrc(Link(src.layer, newIndex[src.layer][src.neuron]));
+                        c.setDest(Link(dest.layer, newIndex[dest.layer][dest.neuron]));
+                    }
+                }
+            }
+        }
+        nn.setLayers(std::move(layers));
+        return report;
+    }
+    LocalityReport reorderForLocality(NeuralNetwork& nn) noexcept{
+        LocalityReport report;
+        auto layers = std::move(nn.getLayers());
+        std::vector<std::size_t> first(layers.size() + 1, 0u);
+        for(auto l=0u;l<layers.size();++l){
+            first[l + 1] = first[l] + layers[l].size();
+        }
+        auto meanSpan = [&](){
+            auto total = 0.0;
+            std::size_t numConnections = 0u;
+            for(auto l=0u;l<layers.size();++l){
+                for(auto j=0u;j<layers[l].size();++j){
+                    for(auto& c:layers[l][j].getConnections()){
+                        auto src = static_cast<double>(first[l] + j);
+                        auto dest = static_cast<double>(first[c.getDest().layer] + c.getDest().neuron);
+                        total += std::abs(dest - src);
+                        ++numConnections;
+                    }
+                }
+            }
+            return numConnections > 0u ? total / numConnections:0.0;
+        };
+        report.meanSpanBefore = meanSpan();
+        for(auto l=1u;l+1<layers.size();++l){
+            auto size = layers[l].size();
+            // pairs that have to keep their order: a source and a destination in the layer and
+            // two neurons of the layer that add to the same sum.
+            std::vector<std::vector<std::size_t>> next(size);
+            std::vector<std::size_t> numPrevious(size, 0u);
+            auto addOrder = [&](std::size_t before, std::size_t after){
+                next[before].emplace_back(after);
+                ++numPrevious[after];
+            };
+            std::vector<std::size_t> lastWriter(first.back(), size);
+            for(auto sl=0u;sl<layers.size();++sl){
+                for(auto j=0u;j<layers[sl].size();++j){
+                    for(auto& c:layers[sl][j].getConnections()){
+                        auto& dest = c.getDest();
+                        if(sl == l && dest.layer == l && dest.neuron != j){
+                            addOrder(std::min<std::size_t>(j, dest.neuron), std::max<std::size_t>(j, dest.neuron));
+                        }
+                        if(sl == l){
+                            auto& writer = lastWriter[first[dest.layer] + dest.neuron];
+                            if(writer != size && writer != j){
+                                addOrder(writer, j);
+                            }
+                            writer = j;
+                        }
+                    }
+                }
+            }
+            // like Cuthill-McKee, the next neuron is the one with the neighbour placed first, the old order breaks the ties.
+            std::vector<std::vector<std::size_t>> neighbours(size);
+            for(auto j=0u;j<size;++j){
+                for(auto& c:layers[l][j].getConnections()){
+                    if(c.getDest().layer == l && c.getDest().neuron != j){
+                        neighbours[j].emplace_back(c.getDest().neuron);
+                        neighbours[c.getDest().neuron].emplace_back(j);
+                    }
+                }
+            }
+            auto unplaced = std::numeric_limits<std::size_t>::max();
+            std::vector<std::size_t> firstNeighbour(size, unplaced);
+            std::set<std::pair<std::size_t, std::size_t>> ready;
+            for(auto j=0u;j<size;++j){
+                if(numPrevious[j] == 0u){
+                    ready.emplace(unplaced, j);
+                }
+            }
+            std::vector<std::size_t> order;
+            order.reserve(size);
+            while(!ready.empty()){
+                auto j = std::begin(ready)->second;
+                ready.erase(std::begin(ready));
+                for(auto k:neighbours[j]){
+                    if(firstNeighbour[k] == unplaced){
+                        if(numPrevious[k] == 0u && ready.erase({unplaced, k}) > 0u){
+                            ready.emplace(order.size(), k);
+                        }
+                        firstNeighbour[k] = order.size();
+                    }
+                }
+                order.emplace_back(j);
+                for(auto k:next[j]){
+                    if(--numPrevious[k] == 0u){
+                        ready.emplace(firstNeighbour[k], k);
+                    }
+                }
+            }
+            // the old order is kept if the connections of the layer would not get shorter.
+            auto layerSpan = [&](const std::vector<std::size_t>& position){
+                auto total = 0.0;
+                for(auto sl=0u;sl<layers.size();++sl){
+                    for(auto j=0u;j<layers[sl].size();++j){
+                        for(auto& c:layers[sl][j].getConnections()){
+                            auto& dest = c.getDest();
+                            if(sl != l && dest.layer != l){
+                                continue;
+                            }
+                            auto src = static_cast<double>(first[sl] + (sl == l ? position[j]:j));
+                            auto d = static_cast<double>(first[dest.layer] + (dest.layer == l ? position[dest.neuron]:dest.neuron));
+                            total += std::abs(d - src);
+                        }
+                    }
+                }
+                return total;
+            };
+            std::vector<std::size_t> identity(size);
+            std::iota(std::begin(identity), std::end(identity), 0u);
+            std::vector<std::size_t> position(size);
+            for(auto k=0u;k<order.size();++k){
+                position[order[k]] = k;
+            }
+            if(order.size() != size || layerSpan(position) >= layerSpan(identity)){
+                continue;
+            }
+            auto& neurons = layers[l].getNeurons();
+            std::vector<Neuron> reordered;
+            reordered.reserve(size);
+            for(auto k=0u;k<order.size();++k){
+                report.movedNeurons += order[k] != k ? 1u:0u;
+                reordered.emplace_back(std::move(neurons[order[k]]));
+            }
+            layers[l].setNeurons(std::move(reordered));
+            for(auto& layer:layers){
+                for(auto& n:layer.getNeurons()){
+                    for(auto& c:n.getConnections()){
+                        if(c.getSrc().layer == l){
+                            c.setSrc(Link(l, position[c.getSrc().neuron]));
+                        }
+                        if(c.getDest().layer == l){
+                            c.setDest(Link(l, position[c.getDest().neuron]));
+                        }
+                    }
+                }
+            }
+        }
+        // the connections of a neuron that gives the same output to all of them can go in any order.
+        for(auto l=0u;l<layers.size();++l){
+            for(auto j=0u;j<layers[l].size();++j){
+                auto& n = layers[l][j];
+                auto& conns = n.getConnections();
+                auto selfConnected = std::any_of(std::begin(conns), std::end(conns), [&](const Connection& c){
+                    return c.getDest().layer == l && c.getDest().neuron == j;
+                });
+                auto sameOutput = n.getType() == Neuron::Type::INPUT || n.getType() == Neuron::Type::CONTEXT
+                                    || n.getType() == Neuron::Type::OUTPUT
+                                    || (n.getType() == Neuron::Type::HIDDEN && n.getBiasWeight() == 0.0);
+                if(sameOutput && !selfConnected && n.getActivationType() != Neuron::ActivationType::NOISY_RELU){
+                    std::stable_sort(std::begin(conns), std::end(conns), [](const Connection& lhs, const Connection& rhs){
+                        auto& a = lhs.getDest();
+                        auto& b = rhs.getDest();
+                        return a.layer < b.layer || (a.layer == b.layer && a.neuron < b.neuron);
+                    });
+                }
+            }
+        }
+        report.meanSpanAfter = meanSpan();
+        nn.setLayers(std::move(layers));
+        return report;
+    }
 }
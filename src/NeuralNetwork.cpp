@@ -1,4 +1,5 @@
 #include <EvoAI/NeuralNetwork.hpp>
+#include <EvoAI/CodeGeneration.hpp>
 #include <fstream>
 
 namespace EvoAI{
@@ -8,6 +9,13 @@ namespace EvoAI{
     , neurons()
     , connectionsCached(false)
     , neuronsCached(false)
+    , executionPlan()
+    , activationTable()
+    , threadPool()
+    , profiler()
+    , epochCallback()
+    , asyncTest(false)
+    , truncationWindow(0u)
     , globalStep(0ull)
     , lastAvgLoss(0.0){}
     NeuralNetwork::NeuralNetwork(std::size_t numInputs, std::size_t numHiddenLayers,
@@ -18,6 +26,13 @@ namespace EvoAI{
     , neurons()
     , connectionsCached(false)
     , neuronsCached(false)
+    , executionPlan()
+    , activationTable()
+    , threadPool()
+    , profiler()
+    , epochCallback()
+    , asyncTest(false)
+    , truncationWindow(0u)
     , globalStep(0ull)
     , lastAvgLoss(0.0){
         layers.reserve(numHiddenLayers + 2);
@@ -33,6 +48,13 @@ namespace EvoAI{
     , neurons()
     , connectionsCached(false)
     , neuronsCached(false)
+    , executionPlan()
+    , activationTable()
+    , threadPool()
+    , profiler()
+    , epochCallback()
+    , asyncTest(false)
+    , truncationWindow(0u)
     , globalStep(std::stoull(o["globalStep"].getString()))
     , lastAvgLoss(0.0){
         auto& lyrs = o["layers"].getArray();
@@ -47,6 +69,13 @@ namespace EvoAI{
     , neurons()
     , connectionsCached(false)
     , neuronsCached(false)
+    , executionPlan()
+    , activationTable()
+    , threadPool()
+    , profiler()
+    , epochCallback()
+    , asyncTest(false)
+    , truncationWindow(0u)
     , globalStep(0ull)
     , lastAvgLoss(0.0){
         JsonBox::Value v;
@@ -58,16 +87,65 @@ namespace EvoAI{
             layers.emplace_back(la.getObject());
         }
     }
+    NeuralNetwork::NeuralNetwork(const ModelFile& model)
+    : NeuralNetwork(){
+        if(!model.isValid()){
+            return;
+        }
+        auto& header = model.getHeader();
+        globalStep = header.globalStep;
+        auto lyrs = model.getLayers();
+        auto nrns = model.getNeurons();
+        auto rowPtr = model.getRowPtr();
+        auto conns = model.getConnections();
+        auto weights = model.getWeights();
+        auto biases = model.getBiases();
+        auto toLink = [&](std::uint32_t index){
+            auto layer = 0u;
+            while(index >= lyrs[layer].firstNeuron + lyrs[layer].numNeurons){
+                ++layer;
+            }
+            return Link(layer, index - lyrs[layer].firstNeuron);
+        };
+        // the constructors of Neuron draw a random bias, copying the same one keeps the load to a single draw.
+        Neuron prototype(Neuron::Type::HIDDEN);
+        layers.reserve(header.numLayers);
+        for(auto i=0u;i<header.numLayers;++i){
+            auto& record = lyrs[i];
+            NeuronLayer layer;
+            layer.setType(static_cast<Neuron::Type>(record.neuronType))
+                 .setActivationType(static_cast<Neuron::ActivationType>(record.activationType))
+                 .setCyclesLimit(record.cyclesLimit);
+            layer.setBias(record.bias);
+            for(auto j=0u;j<record.numNeurons;++j){
+                auto n = record.firstNeuron + j;
+                Neuron neuron(prototype);
+                neuron.setType(static_cast<Neuron::Type>(nrns[n].type))
+                      .setActivationType(static_cast<Neuron::ActivationType>(nrns[n].activationType))
+                      .setBiasWeight(biases[n]);
+                neuron.getBiasPtr()->setFrozen(nrns[n].flags & ModelFile::FrozenFlag);
+                for(auto c=rowPtr[n];c<rowPtr[n + 1u];++c){
+                    Connection conn(Link(i, j), toLink(conns[c].dest), weights[c]);
+                    conn.setFrozen(conns[c].flags & ModelFile::FrozenFlag);
+                    neuron.addConnection(conn);
+                }
+                layer.addNeuron(neuron);
+            }
+            layers.emplace_back(std::move(layer));
+        }
+    }
     NeuralNetwork& NeuralNetwork::addLayer(const NeuronLayer& l){
         layers.emplace_back(l);
         connectionsCached = false;
         neuronsCached = false;
+        executionPlan.reset();
         return *this;
     }
     bool NeuralNetwork::removeLayer(const NeuronLayer& l){
         auto lyrIndex = 0u;
         connectionsCached = false;
         neuronsCached = false;
+        executionPlan.reset();
         for(auto i=0u;i<layers.size();++i){
             if(l == layers[i]){
                 lyrIndex = i;
@@ -91,91 +169,77 @@ namespace EvoAI{
         return (lyrRemoved != std::end(layers));
     }
     std::vector<double> NeuralNetwork::run(){
-        for(auto& c:getConnections()){
-            auto w = c->getWeight();
-            auto& src = c->getSrc();
-            auto& dest = c->getDest();
-            auto& nrnSrc = layers[src.layer][src.neuron];
-            auto& nrnDest = layers[dest.layer][dest.neuron];
-            double output = 0.0;
-            switch(nrnSrc.getType()){
-                case Neuron::Type::INPUT:
-                        nrnSrc.setOutput(nrnSrc.getSum());
-                        nrnDest.addSum(nrnSrc.getSum() * w);
-                    break;
-                case Neuron::Type::CONTEXT:
-                case Neuron::Type::HIDDEN:
-                        if(nrnSrc.getType() != Neuron::Type::CONTEXT){
-                            nrnSrc.addSum(nrnSrc.getBiasWeight());
-                        }
-                        output = activate(nrnSrc.getActivationType(),nrnSrc);
-                        nrnSrc.setOutput(output);
-                        nrnDest.addSum(output * w);
-                        if(nrnDest.getType() == Neuron::Type::CONTEXT){
-                            if(c->getCycles() > layers[dest.layer].getCyclesLimit()){
-                                nrnDest.resetContext();
-                                c->setCycles(0);
-                            }
-                            nrnDest.setSum(nrnSrc.getSum());
-                            c->setCycles(c->getCycles()+1);
-                        }
-                    break;
-                case Neuron::Type::OUTPUT:{
-                        double oldSum = nrnSrc.getSum();
-                        nrnSrc.addSum(nrnSrc.getBiasWeight());
-                        if(c->getCycles() > layers[dest.layer].getCyclesLimit()){
-                            nrnDest.resetContext();
-                            c->setCycles(0);
-                        }
-                        // nrnDest should be a CONTEXT neuron and nrnSrc should be Output being recorded.
-                        nrnDest.setSum(nrnSrc.getSum());
-                        nrnSrc.setSum(oldSum);
-                        c->setCycles(c->getCycles()+1);
-                }
-                    break;
-                default:
-                    break;
-            }
-        }
+        process();
         auto& outputLayer = layers.back();
-        auto output = 0.0;
         std::vector<double> res;
         res.reserve(outputLayer.size());
-        if(outputLayer.getActivationType() == Neuron::ActivationType::SOFTMAX){
-            for(auto& n:outputLayer.getNeurons()){
-                n.addSum(n.getBiasWeight());
-                output = activate(n.getActivationType(),n);
-                n.setOutput(output);
-            }
-            Activations::softmax(outputLayer);
-            for(auto& n:outputLayer.getNeurons()){
-                res.emplace_back(n.getOutput());
-            }
-        }else{
-            for(auto& n:outputLayer.getNeurons()){
-                n.addSum(n.getBiasWeight());
-                output = activate(n.getActivationType(),n);
-                n.setOutput(output);
-                res.emplace_back(output);
-            }
+        for(auto& n:outputLayer.getNeurons()){
+            res.emplace_back(n.getOutput());
         }
         return res;
     }
     std::vector<double> NeuralNetwork::forward(const std::vector<double>& input) noexcept{
+        if(executionPlan){
+            return executionPlan->forward(input);
+        }
         setInputs(input);
         return run();
     }
     std::vector<double> NeuralNetwork::forward(std::vector<double>&& input) noexcept{
+        if(executionPlan){
+            return executionPlan->forward(input);
+        }
         setInputs(std::forward<std::vector<double>>(input));
         return run();
     }
-    std::vector<double> NeuralNetwork::backward(std::vector<double>&& gradientLoss) noexcept{
+    bool NeuralNetwork::forward(const double* inputs, std::size_t numInputs, double* outputs, std::size_t numOutputs) noexcept{
+        if(executionPlan){
+            return executionPlan->forward(inputs, numInputs, outputs, numOutputs);
+        }
+        if(numOutputs != layers.back().size() || !setInputs(inputs, numInputs)){
+            return false;
+        }
+        process();
+        for(auto& n:layers.back().getNeurons()){
+            *outputs++ = n.getOutput();
+        }
+        return true;
+    }
+    std::vector<double> NeuralNetwork::forward(const std::vector<double>& input, InferenceState& state) const noexcept{
+        if(!executionPlan){
+            return {};
+        }
+        return executionPlan->forward(input, state);
+    }
+    InferenceState NeuralNetwork::makeInferenceState(){
+        if(!executionPlan){
+            compile();
+        }
+        return executionPlan->makeState();
+    }
+    std::vector<double> NeuralNetwork::backward(std::vector<double>&& gradientLoss, bool gradientOfSums) noexcept{
+        backward(gradientLoss.data(), gradientLoss.size(), gradientOfSums);
+        return layers[0].backward();
+    }
+    bool NeuralNetwork::backward(const double* gradientLoss, std::size_t size, bool gradientOfSums) noexcept{
         auto& outLayer = layers.back();
-        if(outLayer.getActivationType() == Neuron::ActivationType::SOFTMAX){
-            Derivatives::softmax(outLayer);
+        if(size != outLayer.size()){
+            return false;
         }
-        for(auto j=0u;j<outLayer.size();++j){
-            outLayer[j].setGradient(derivate(outLayer[j].getActivationType(),outLayer[j]) * gradientLoss[j]);
+        if(executionPlan){
+            executionPlan->writeState(*this);
+        }
+        if(gradientOfSums){
+            for(auto j=0u;j<outLayer.size();++j){
+                outLayer[j].setGradient(gradientLoss[j]);
+            }
+        }else{
+            if(outLayer.getActivationType() == Neuron::ActivationType::SOFTMAX){
+                Derivatives::softmax(outLayer);
+            }
+            for(auto j=0u;j<outLayer.size();++j){
+                outLayer[j].setGradient(derivate(outLayer[j].getActivationType(),outLayer[j]) * gradientLoss[j]);
+            }
         }
         std::for_each(std::rbegin(getConnections()),std::rend(getConnections()),
             [&](Connection* c){
@@ -201,17 +265,94 @@ namespace EvoAI{
                         break;
                 }
         });
-        return layers[0].backward();
+        return true;
+    }
+    std::vector<double> NeuralNetwork::forwardBatch(const std::vector<double>& inputs, std::size_t batchSize) noexcept{
+        if(!executionPlan){
+            compile();
+        }
+        return executionPlan->forwardBatch(inputs, batchSize);
+    }
+    std::vector<double> NeuralNetwork::backwardBatch(const std::vector<double>& gradientLoss, bool gradientOfSums) noexcept{
+        if(!executionPlan){
+            return {};
+        }
+        auto gradients = executionPlan->backwardBatch(gradientLoss, gradientOfSums);
+        executionPlan->writeGradients(*this);
+        return gradients;
+    }
+    NeuralNetwork& NeuralNetwork::compile(ExecutionPlan::EvaluationMode mode){
+        executionPlan.emplace(*this, mode);
+        if(truncationWindow > 0u){
+            executionPlan->setTruncationWindow(truncationWindow);
+        }
+        return *this;
+    }
+    bool NeuralNetwork::setTruncationWindow(std::size_t window){
+        truncationWindow = window;
+        if(window > 0u && (!executionPlan || executionPlan->getEvaluationMode() != ExecutionPlan::EvaluationMode::NEURON_MAJOR)){
+            compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+        }else if(executionPlan){
+            executionPlan->setTruncationWindow(window);
+        }
+        if(window > 0u && executionPlan->getTruncationWindow() != window){
+            truncationWindow = 0u;
+            return false;
+        }
+        return true;
+    }
+    bool NeuralNetwork::backwardThroughTime(const std::vector<double>& gradientLoss) noexcept{
+        if(!executionPlan){
+            return false;
+        }
+        return executionPlan->backwardThroughTime(gradientLoss);
+    }
+    void NeuralNetwork::propagateThroughTime() noexcept{
+        if(executionPlan){
+            executionPlan->propagateThroughTime();
+            executionPlan->writeTimeGradients(*this);
+        }
+    }
+    void NeuralNetwork::decompile() noexcept{
+        executionPlan.reset();
+    }
+    NeuralNetwork& NeuralNetwork::setActivationTable(std::shared_ptr<const Activations::LookupTable> table) noexcept{
+        activationTable = std::move(table);
+        if(executionPlan){
+            executionPlan->setActivationTable(activationTable);
+        }
+        return *this;
+    }
+    NeuralNetwork& NeuralNetwork::setThreadPool(std::shared_ptr<ThreadPool> pool) noexcept{
+        threadPool = std::move(pool);
+        if(executionPlan){
+            executionPlan->setThreadPool(threadPool);
+        }
+        return *this;
+    }
+    NeuralNetwork& NeuralNetwork::setProfiler(std::shared_ptr<TrainingProfiler> prof) noexcept{
+        profiler = std::move(prof);
+        return *this;
+    }
+    NeuralNetwork& NeuralNetwork::setAsyncTest(bool async) noexcept{
+        asyncTest = async;
+        return *this;
+    }
+    NeuralNetwork& NeuralNetwork::setEpochCallback(EpochCallback callback) noexcept{
+        epochCallback = std::move(callback);
+        return *this;
     }
     NeuralNetwork& NeuralNetwork::setLayers(std::vector<NeuronLayer>&& lys){
         connectionsCached = false;
         neuronsCached = false;
+        executionPlan.reset();
         layers = std::move(lys);
         return *this;
     }
     NeuralNetwork& NeuralNetwork::addNeuron(const Neuron& n, std::size_t layerIndex){
         neuronsCached = false;
         connectionsCached = false;
+        executionPlan.reset();
         layers[layerIndex].addNeuron(n);
         return *this;
     }
@@ -239,6 +380,7 @@ namespace EvoAI{
         }
         connectionsCached = false;
         neuronsCached = false;
+        executionPlan.reset();
         return isRemoved;
     }
     Link NeuralNetwork::getIndex(Neuron* n) const{
@@ -255,18 +397,14 @@ namespace EvoAI{
         return Link(0,0);
     }
     bool NeuralNetwork::setInputs(std::vector<double>&& ins) noexcept{
-        auto numInputs = layers[0].size();
-        if(ins.size() != numInputs){
-            return false;
-        }
-        for(auto i=0u;i<numInputs;++i){
-            layers[0][i].setSum(ins[i]);
-        }
-        return true;
+        return setInputs(ins.data(), ins.size());
     }
     bool NeuralNetwork::setInputs(const std::vector<double>& ins) noexcept{
+        return setInputs(ins.data(), ins.size());
+    }
+    bool NeuralNetwork::setInputs(const double* ins, std::size_t size) noexcept{
         auto numInputs = layers[0].size();
-        if(ins.size() != numInputs){
+        if(size != numInputs){
             return false;
         }
         for(auto i=0u;i<numInputs;++i){
@@ -283,14 +421,17 @@ namespace EvoAI{
         }
         layers[c.getSrc().layer].addConnection(c);
         connectionsCached = false;
+        executionPlan.reset();
         return *this;
     }
     bool NeuralNetwork::removeConnection(Connection& c){
         connectionsCached = false;
+        executionPlan.reset();
         return layers[c.getSrc().layer].removeConnection(c);
     }
     void NeuralNetwork::removeConnectionsWithDest(const Link& dest){
         connectionsCached = false;
+        executionPlan.reset();
         for(auto& l:layers){
             for(auto& n:l.getNeurons()){
                 auto& conns = n.getConnections();
@@ -304,6 +445,7 @@ namespace EvoAI{
     }
     void NeuralNetwork::removeConnectionsWithSrc(const Link& src){
         connectionsCached = false;
+        executionPlan.reset();
         layers[src.layer][src.neuron].clearConnections();
     }
     std::vector<Connection*>& NeuralNetwork::getConnections(){
@@ -380,11 +522,27 @@ namespace EvoAI{
         for(auto& l:layers){
             l.reset();
         }
+        if(executionPlan){
+            executionPlan->reset();
+        }
     }
     void NeuralNetwork::resetContext(){
         for(auto& l:layers){
             l.resetContext();
         }
+        if(executionPlan){
+            executionPlan->resetContext();
+        }
+    }
+    void NeuralNetwork::reset(InferenceState& state) const noexcept{
+        if(executionPlan){
+            executionPlan->reset(state);
+        }
+    }
+    void NeuralNetwork::resetContext(InferenceState& state) const noexcept{
+        if(executionPlan){
+            executionPlan->resetContext(state);
+        }
     }
     void NeuralNetwork::resetConnections(){
         for(auto& c:getConnections()){
@@ -440,10 +598,21 @@ namespace EvoAI{
         out.close();
         return true;
     }
+    bool NeuralNetwork::exportCpp(const std::string& filename, const std::string& name){
+        // a new plan, the compiled one could be NEURON_MAJOR.
+        auto source = generateCpp(ExecutionPlan(*this, ExecutionPlan::EvaluationMode::EDGE_MAJOR), name);
+        if(source.empty()){
+            return false;
+        }
+        std::ofstream out(filename, std::ios_base::out);
+        out << source;
+        return static_cast<bool>(out);
+    }
     void NeuralNetwork::clear(){
         layers.clear();
         connections.clear();
         connectionsCached = false;
+        executionPlan.reset();
         lastAvgLoss = 0.0;
     }
     NeuronLayer& NeuralNetwork::operator[](std::size_t index){
@@ -458,106 +627,139 @@ namespace EvoAI{
         return std::equal(std::begin(layers),std::end(layers),std::begin(rhs.layers));
     }
 //private member functions
+    void NeuralNetwork::process(){
+        for(auto& c:getConnections()){
+            auto w = c->getWeight();
+            auto& src = c->getSrc();
+            auto& dest = c->getDest();
+            auto& nrnSrc = layers[src.layer][src.neuron];
+            auto& nrnDest = layers[dest.layer][dest.neuron];
+            double output = 0.0;
+            switch(nrnSrc.getType()){
+                case Neuron::Type::INPUT:
+                        nrnSrc.setOutput(nrnSrc.getSum());
+                        nrnDest.addSum(nrnSrc.getSum() * w);
+                    break;
+                case Neuron::Type::CONTEXT:
+                case Neuron::Type::HIDDEN:
+                        if(nrnSrc.getType() != Neuron::Type::CONTEXT){
+                            nrnSrc.addSum(nrnSrc.getBiasWeight());
+                        }
+                        output = activate(nrnSrc.getActivationType(),nrnSrc);
+                        nrnSrc.setOutput(output);
+                        nrnDest.addSum(output * w);
+                        if(nrnDest.getType() == Neuron::Type::CONTEXT){
+                            if(c->getCycles() > layers[dest.layer].getCyclesLimit()){
+                                nrnDest.resetContext();
+                                c->setCycles(0);
+                            }
+                            nrnDest.setSum(nrnSrc.getSum());
+                            c->setCycles(c->getCycles()+1);
+                        }
+                    break;
+                case Neuron::Type::OUTPUT:{
+                        double oldSum = nrnSrc.getSum();
+                        nrnSrc.addSum(nrnSrc.getBiasWeight());
+                        if(c->getCycles() > layers[dest.layer].getCyclesLimit()){
+                            nrnDest.resetContext();
+                            c->setCycles(0);
+                        }
+                        // nrnDest should be a CONTEXT neuron and nrnSrc should be Output being recorded.
+                        nrnDest.setSum(nrnSrc.getSum());
+                        nrnSrc.setSum(oldSum);
+                        c->setCycles(c->getCycles()+1);
+                }
+                    break;
+                default:
+                    break;
+            }
+        }
+        auto& outputLayer = layers.back();
+        auto output = 0.0;
+        if(outputLayer.getActivationType() == Neuron::ActivationType::SOFTMAX){
+            for(auto& n:outputLayer.getNeurons()){
+                n.addSum(n.getBiasWeight());
+                output = activate(n.getActivationType(),n);
+                n.setOutput(output);
+            }
+            Activations::softmax(outputLayer);
+        }else{
+            for(auto& n:outputLayer.getNeurons()){
+                n.addSum(n.getBiasWeight());
+                output = activate(n.getActivationType(),n);
+                n.setOutput(output);
+            }
+        }
+    }
     double NeuralNetwork::derivate(Neuron::ActivationType at,const Neuron& n){
-        switch(at){
-            case Neuron::ActivationType::IDENTITY:
-                return Derivatives::identity(n.getOutput());
-            case Neuron::ActivationType::MODULUS:
-                return Derivatives::modulus(n.getSum(), 2.0);
-            case Neuron::ActivationType::SIGMOID:
-                return Derivatives::sigmoid(n.getSum());
-            case Neuron::ActivationType::SINUSOID:
-                return Derivatives::sinusoid(n.getSum());
-            case Neuron::ActivationType::RELU:
-                return Derivatives::relu(n.getOutput());
-            case Neuron::ActivationType::NOISY_RELU:
-                return Derivatives::noisyRelu(n.getSum());
-            case Neuron::ActivationType::LEAKY_RELU:
-                return Derivatives::leakyRelu(n.getSum());
-            case Neuron::ActivationType::EXPONENTIAL:
-                return Derivatives::exponential(n.getSum());
-            case Neuron::ActivationType::SOFTMAX:
-                return n.getGradient();
-            case Neuron::ActivationType::TANH:
-                return Derivatives::tanh(n.getSum());
-            case Neuron::ActivationType::COSINE:
-                return Derivatives::cosine(n.getSum());
-            case Neuron::ActivationType::TAN:
-                return Derivatives::tan(n.getSum());
-            case Neuron::ActivationType::GAUSSIAN:
-                return Derivatives::gaussian(n.getOutput());
-            case Neuron::ActivationType::STEPPED_SIGMOID:
-                return Derivatives::steepenedSigmoid(n.getOutput());
-            case Neuron::ActivationType::SWISH:
-                return Derivatives::swish(n.getSum(), n.getBiasWeight());
-            case Neuron::ActivationType::SQUARE:
-                return Derivatives::square(n.getSum());
-            case Neuron::ActivationType::CUBE:
-                return Derivatives::cube(n.getSum());
-            case Neuron::ActivationType::SOFTPLUS:
-                return Derivatives::softplus(n.getSum());
-            case Neuron::ActivationType::CLAMP:
-                return Derivatives::clamp(n.getSum());
-            case Neuron::ActivationType::INV:
-                return Derivatives::inv(n.getSum());
-            case Neuron::ActivationType::LOG:
-                return Derivatives::log(n.getSum());
-            case Neuron::ActivationType::ABS:
-                return Derivatives::abs(n.getSum());
-            case Neuron::ActivationType::HAT:
-                return Derivatives::hat(n.getSum());
-        }
-        return Derivatives::sigmoid(n.getOutput());
+        return Derivatives::derivate(at, n.getSum(), n.getOutput(), n.getBiasWeight(), n.getGradient());
     }
     double NeuralNetwork::activate(Neuron::ActivationType at, const Neuron& n){
-        switch(at){
-            case Neuron::ActivationType::IDENTITY:
-                return Activations::identity(n.getSum());
-            case Neuron::ActivationType::MODULUS:
-                return Activations::modulus(n.getSum(), 2.0);
-            case Neuron::ActivationType::TANH:
-                return Activations::tanh(n.getSum());
-            case Neuron::ActivationType::SINUSOID:
-                return Activations::sinusoid(n.getSum());
-            case Neuron::ActivationType::COSINE:
-                return Activations::cosine(n.getSum());
-            case Neuron::ActivationType::TAN:
-                return Activations::tan(n.getSum());
-            case Neuron::ActivationType::SIGMOID:
-                return Activations::sigmoid(n.getSum());
-            case Neuron::ActivationType::RELU:
-                return Activations::relu(n.getSum());
-            case Neuron::ActivationType::NOISY_RELU:
-                return Activations::noisyRelu(n.getSum());
-            case Neuron::ActivationType::LEAKY_RELU:
-                return Activations::leakyRelu(n.getSum());
-            case Neuron::ActivationType::EXPONENTIAL:
-                return Activations::exponential(n.getSum());
-            case Neuron::ActivationType::SOFTMAX:
-                return Activations::identity(n.getSum());
-            case Neuron::ActivationType::GAUSSIAN:
-                return Activations::gaussian(n.getSum());
-            case Neuron::ActivationType::STEPPED_SIGMOID:
-                return Activations::steepenedSigmoid(n.getSum());
-            case Neuron::ActivationType::SWISH:
-                return Activations::swish(n.getSum(), n.getBiasWeight());
-            case Neuron::ActivationType::SQUARE:
-                return Activations::square(n.getSum());
-            case Neuron::ActivationType::CUBE:
-                return Activations::cube(n.getSum());
-            case Neuron::ActivationType::SOFTPLUS:
-                return Activations::softplus(n.getSum());
-            case Neuron::ActivationType::CLAMP:
-                return Activations::clamp(n.getSum());
-            case Neuron::ActivationType::INV:
-                return Activations::inv(n.getSum());
-            case Neuron::ActivationType::LOG:
-                return Activations::log(n.getSum());
-            case Neuron::ActivationType::ABS:
-                return Activations::abs(n.getSum());
-            case Neuron::ActivationType::HAT:
-                return Activations::hat(n.getSum());
-        }
-        return Activations::sigmoid(n.getSum());
+        if(activationTable){
+            return activationTable->activate(at, n.getSum(), n.getBiasWeight());
+        }
+        return Activations::activate(at, n.getSum(), n.getBiasWeight());
+    }
+    void NeuralNetwork::loadParameters(std::atomic<double>* parameters) noexcept{
+        auto& weights = executionPlan->getWeights();
+        for(auto i=0u;i<weights.size();++i){
+            parameters[i].store(weights[i], std::memory_order_relaxed);
+        }
+        auto& biases = executionPlan->getBiases();
+        for(auto i=0u;i<biases.size();++i){
+            parameters[weights.size() + i].store(biases[i], std::memory_order_relaxed);
+        }
+    }
+    void NeuralNetwork::storeParameters(const std::atomic<double>* parameters) noexcept{
+        auto& conns = getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            conns[i]->setWeight(parameters[i].load(std::memory_order_relaxed));
+        }
+        auto& nrns = getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            nrns[i]->setBiasWeight(parameters[conns.size() + i].load(std::memory_order_relaxed));
+        }
+        executionPlan->updateWeights(*this);
+    }
+    std::unique_ptr<NeuralNetwork> NeuralNetwork::makeSnapshot() const{
+        auto snapshot = std::make_unique<NeuralNetwork>(toJson().getObject());
+        snapshot->setActivationTable(activationTable);
+        snapshot->setThreadPool(threadPool);
+        if(executionPlan){
+            snapshot->compile(executionPlan->getEvaluationMode());
+        }
+        return snapshot;
+    }
+    void NeuralNetwork::copyParametersTo(NeuralNetwork& snapshot) noexcept{
+        auto& conns = getConnections();
+        auto& snapshotConns = snapshot.getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            snapshotConns[i]->setWeight(conns[i]->getWeight());
+        }
+        auto& nrns = getNeurons();
+        auto& snapshotNrns = snapshot.getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            snapshotNrns[i]->setBiasWeight(nrns[i]->getBiasWeight());
+        }
+        if(snapshot.executionPlan){
+            snapshot.executionPlan->updateWeights(snapshot);
+        }
+    }
+    std::vector<std::uint32_t> NeuralNetwork::trainableParameters() noexcept{
+        std::vector<std::uint32_t> trainable;
+        auto& conns = getConnections();
+        for(auto i=0u;i<conns.size();++i){
+            // like SGD, recurrent connections keep the context neurons with weight 1.0
+            if(!conns[i]->isFrozen() && !conns[i]->isRecurrent()){
+                trainable.emplace_back(i);
+            }
+        }
+        auto& nrns = getNeurons();
+        for(auto i=0u;i<nrns.size();++i){
+            if(!nrns[i]->getBiasPtr()->isFrozen()){
+                trainable.emplace_back(conns.size() + i);
+            }
+        }
+        return trainable;
     }
 }
@@ -54,32 +54,46 @@ namespace EvoAI{
     }
     void Adam::operator()(double lr, std::size_t batchSize) noexcept{
         ++m_t;
-        auto paramsSize = m_params.size();
-        for(auto i=0u;i<paramsSize;++i){
-            auto c = m_params[i];
-            if(!c->isRecurrent()){ // needed to keep context neurons with weight 1.0
-                if(!m_accumGradients){
-                    c->setGradient(c->getGradient() / batchSize);
-                }
+        auto trainable = m_params.trainable();
+        auto mWeight = m_mWeight.data();
+        auto vWeight = m_vWeight.data();
+        auto beta1 = m_beta1;
+        auto beta2 = m_beta2;
+        auto epsilon = m_epsilon;
+        // bias correction, the same for every parameter
+        auto mCorrection = 1.0 - std::pow(m_beta1, m_t);
+        auto vCorrection = 1.0 - std::pow(m_beta2, m_t);
+        auto rate = m_maximize ? lr:-lr;
+        auto divisor = m_accumGradients ? 1.0:static_cast<double>(batchSize);
+        // passed by reference, the captures don't fit in the small buffer of std::function.
+        auto kernel = [&](std::size_t begin, std::size_t end, double* weights, double* gradients){
+            auto size = end - begin;
+            auto t = trainable + begin;
+            auto mW = mWeight + begin;
+            auto vW = vWeight + begin;
+            // the recurrent connections are not updated, needed to keep context neurons with weight 1.0
+            for(auto i=0u;i<size;++i){
+                auto g = t[i] ? gradients[i] / divisor:gradients[i];
+                gradients[i] = g;
                 // m b1
-                m_mWeight[i] = m_beta1 * m_mWeight[i] + (1.0 - m_beta1) * c->getGradient();
+                auto m = beta1 * mW[i] + (1.0 - beta1) * g;
                 // rms b2
-                m_vWeight[i] = m_beta2 * m_vWeight[i] + (1.0 - m_beta2) * (c->getGradient() * c->getGradient());
-                // bias correction
-                auto mWcorrected = m_mWeight[i] / (1.0 - std::pow(m_beta1, m_t));
-                auto vWcorrected = m_vWeight[i] / (1.0 - std::pow(m_beta2, m_t));
+                auto v = beta2 * vW[i] + (1.0 - beta2) * (g * g);
+                auto mWcorrected = m / mCorrection;
+                auto vWcorrected = v / vCorrection;
                 // update weight
-                if(m_maximize){
-                    c->setWeight(c->getWeight() + lr * (mWcorrected / (std::sqrt(vWcorrected) + m_epsilon)));
-                }else{
-                    c->setWeight(c->getWeight() - lr * (mWcorrected / (std::sqrt(vWcorrected) + m_epsilon)));
-                }
+                auto w = weights[i] + rate * (mWcorrected / (std::sqrt(vWcorrected) + epsilon));
+                mW[i] = t[i] ? m:mW[i];
+                vW[i] = t[i] ? v:vW[i];
+                weights[i] = t[i] ? w:weights[i];
             }
-        }
+        };
+        m_params.update(std::cref(kernel));
     }
     void Adam::zeroGrad() noexcept{
-        for(auto c:m_params){
-            c->reset();
-        }
+        m_params.zeroGrad();
+    }
+    void Adam::setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minParameters) noexcept{
+        m_params.setThreadPool(std::move(pool), minParameters);
     }
 }
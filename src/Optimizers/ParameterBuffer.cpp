@@ -0,0 +1,98 @@
+#include <EvoAI/Optimizers/ParameterBuffer.hpp>
+#include <EvoAI/Connection.hpp>
+#include <EvoAI/ThreadPool.hpp>
+
+#include <algorithm>
+
+namespace EvoAI{
+    ParameterBuffer::ParameterBuffer(std::vector<Connection*>&& parameters)
+    : m_params(std::forward<std::vector<Connection*>>(parameters))
+    , m_weights(m_params.size(), 0.0)
+    , m_gradients(m_params.size(), 0.0)
+    , m_trainable(m_params.size(), 0u)
+    , m_segments()
+    , m_threadPool()
+    , m_minParameters(DefaultMinParameters){
+        for(auto i=0u;i<m_params.size();++i){
+            m_trainable[i] = m_params[i]->isRecurrent() ? 0u:1u;
+        }
+    }
+    void ParameterBuffer::update(const Chunk& kernel) noexcept{
+        auto size = m_params.size();
+        auto numTasks = m_threadPool ? std::min(m_threadPool->size(), size / m_minParameters):0u;
+        if(numTasks < 2u){
+            updateRange(kernel, 0u, size);
+            return;
+        }
+        auto task = [&](std::size_t t){
+            updateRange(kernel, size * t / numTasks, size * (t + 1u) / numTasks);
+        };
+        m_threadPool->run(numTasks, std::cref(task));
+    }
+    void ParameterBuffer::zeroGrad() noexcept{
+        if(isBound()){
+            for(auto& segment:m_segments){
+                std::fill_n(segment.gradients, segment.size, 0.0);
+            }
+            return;
+        }
+        for(auto c:m_params){
+            c->reset();
+        }
+    }
+    bool ParameterBuffer::bind(std::vector<Segment>&& segments) noexcept{
+        std::size_t next = 0u;
+        for(auto& segment:segments){
+            if(segment.begin != next || segment.size == 0u || !segment.weights || !segment.gradients){
+                return false;
+            }
+            next += segment.size;
+        }
+        if(next != m_params.size() || segments.empty()){
+            return false;
+        }
+        m_segments = std::move(segments);
+        return true;
+    }
+    void ParameterBuffer::unbind() noexcept{
+        m_segments.clear();
+    }
+    void ParameterBuffer::setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minParameters) noexcept{
+        m_threadPool = std::move(pool);
+        m_minParameters = std::max<std::size_t>(1u, minParameters);
+    }
+//private member functions
+    void ParameterBuffer::updateRange(const Chunk& kernel, std::size_t begin, std::size_t end) noexcept{
+        if(isBound()){
+            for(auto& segment:m_segments){
+                auto from = std::max(begin, segment.begin);
+                auto to = std::min(end, segment.begin + segment.size);
+                if(from < to){
+                    auto offset = from - segment.begin;
+                    kernel(from, to, segment.weights + offset, segment.gradients + offset);
+                }
+            }
+            return;
+        }
+        for(auto block=begin;block<end;block+=BlockSize){
+            auto blockEnd = std::min(end, block + BlockSize);
+            gather(block, blockEnd);
+            kernel(block, blockEnd, m_weights.data() + block, m_gradients.data() + block);
+            scatter(block, blockEnd);
+        }
+    }
+    void ParameterBuffer::gather(std::size_t begin, std::size_t end) noexcept{
+        for(auto i=begin;i<end;++i){
+            auto c = m_params[i];
+            m_weights[i] = c->getWeight();
+            m_gradients[i] = c->getGradient();
+        }
+    }
+    void ParameterBuffer::scatter(std::size_t begin, std::size_t end) noexcept{
+        for(auto i=begin;i<end;++i){
+            auto c = m_params[i];
+            c->setWeight(m_weights[i]);
+            c->setGradient(m_gradients[i]);
+        }
+    }
+}
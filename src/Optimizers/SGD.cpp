@@ -47,43 +47,46 @@ namespace EvoAI{
         return o;
     }
     void SGD::operator()(double lr, std::size_t batchSize) noexcept{
-        auto paramsSize = m_params.size();
-        for(auto i=0u;i<paramsSize;++i){
-            auto c = m_params[i];
-            if(!c->isRecurrent()){ // needed to keep context neurons with weight 1.0
-                if(!m_accumGradients){
-                    c->setGradient(c->getGradient() / batchSize);
-                }
-                if(m_momentumWeights[0] == 0.0){
-                    if(m_maximize){
-                        c->setWeight(c->getWeight() + lr * c->getGradient());
-                    }else{
-                        c->setWeight(c->getWeight() - lr * c->getGradient());
-                    }
+        if(m_params.size() == 0u){
+            return;
+        }
+        auto trainable = m_params.trainable();
+        auto momentum = m_momentumWeights.data();
+        auto velocity = m_velocityWeights.data();
+        // maximize only flips the sign of the step, -(lr * g) is exact so the updates don't change.
+        auto rate = m_maximize ? lr:-lr;
+        auto divisor = m_accumGradients ? 1.0:static_cast<double>(batchSize);
+        auto useMomentum = m_momentumWeights[0] != 0.0;
+        auto nesterov = m_nesterov;
+        // passed by reference, the captures don't fit in the small buffer of std::function.
+        auto kernel = [&](std::size_t begin, std::size_t end, double* weights, double* gradients){
+            auto size = end - begin;
+            auto t = trainable + begin;
+            auto m = momentum + begin;
+            auto v = velocity + begin;
+            // the recurrent connections are not updated, needed to keep context neurons with weight 1.0
+            for(auto i=0u;i<size;++i){
+                auto g = t[i] ? gradients[i] / divisor:gradients[i];
+                gradients[i] = g;
+                if(!useMomentum){
+                    weights[i] = t[i] ? weights[i] + rate * g:weights[i];
+                }else if(!nesterov){
+                    auto step = m[i] * v[i] + rate * g;
+                    v[i] = t[i] ? step:v[i];
+                    weights[i] = t[i] ? weights[i] + step:weights[i];
                 }else{
-                    if(!m_nesterov){
-                        if(m_maximize){
-                            m_velocityWeights[i] = m_momentumWeights[i] * m_velocityWeights[i] + lr * c->getGradient();
-                        }else{
-                            m_velocityWeights[i] = m_momentumWeights[i] * m_velocityWeights[i] - lr * c->getGradient();
-                        }
-                        c->setWeight(c->getWeight() + m_velocityWeights[i]);
-                    }else{
-                        if(m_maximize){
-                            m_velocityWeights[i] = m_momentumWeights[i] * m_velocityWeights[i] + lr * c->getGradient();
-                            c->setWeight(c->getWeight() + m_momentumWeights[i] * m_velocityWeights[i] + lr * c->getGradient());
-                        }else{
-                            m_velocityWeights[i] = m_momentumWeights[i] * m_velocityWeights[i] - lr * c->getGradient();
-                            c->setWeight(c->getWeight() + m_momentumWeights[i] * m_velocityWeights[i] - lr * c->getGradient());
-                        }
-                    }
+                    auto step = m[i] * v[i] + rate * g;
+                    v[i] = t[i] ? step:v[i];
+                    weights[i] = t[i] ? weights[i] + m[i] * step + rate * g:weights[i];
                 }
             }
-        }
+        };
+        m_params.update(std::cref(kernel));
     }
     void SGD::zeroGrad() noexcept{
-        for(auto c:m_params){
-            c->reset();
-        }
+        m_params.zeroGrad();
+    }
+    void SGD::setThreadPool(std::shared_ptr<ThreadPool> pool, std::size_t minParameters) noexcept{
+        m_params.setThreadPool(std::move(pool), minParameters);
     }
 }
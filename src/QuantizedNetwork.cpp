@@ -0,0 +1,239 @@
+#include <EvoAI/QuantizedNetwork.hpp>
+#include <EvoAI/NeuralNetwork.hpp>
+
+#include <cmath>
+
+namespace{
+    /**
+     * @brief quantizes v to [-127, 127], NaN goes to 0.
+     */
+    inline std::int32_t quantizeValue(double v, double invScale) noexcept{
+        auto q = v * invScale;
+        if(std::isnan(q)){
+            return 0;
+        }
+        return static_cast<std::int32_t>(std::lrint(std::clamp(q, -127.0, 127.0)));
+    }
+    /**
+     * @brief scale that maps [-maxValue, maxValue] to [-127, 127].
+     */
+    inline double scaleFor(double maxValue) noexcept{
+        if(!(maxValue > 0.0) || std::isinf(maxValue)){
+            return 1.0;
+        }
+        return maxValue / 127.0;
+    }
+}
+
+namespace EvoAI{
+    struct QuantizedNetwork::Calibration{
+        double sum(std::uint32_t n) const noexcept{
+            return sums[n];
+        }
+        void setSum(std::uint32_t n, double v) noexcept{
+            sums[n] = v;
+        }
+        void addSum(std::uint32_t n, double v) noexcept{
+            sums[n] += v;
+        }
+        double value(std::uint32_t n, double output) noexcept{
+            if(std::isfinite(output)){
+                maxOutputs[n] = std::max(maxOutputs[n], std::abs(output));
+            }
+            return output;
+        }
+        void send(double output, std::uint32_t c) noexcept{
+            sums[dest[c]] += output * weights[c];
+        }
+        const std::vector<std::uint32_t>& dest;
+        const std::vector<double>& weights;
+        std::vector<double> sums;
+        std::vector<double> maxOutputs;
+    };
+    struct QuantizedNetwork::Inference{
+        double sum(std::uint32_t n) const noexcept{
+            return qnn.sum(n);
+        }
+        void setSum(std::uint32_t n, double v) noexcept{
+            qnn.m_sums[n] = static_cast<float>(v);
+            qnn.m_accumulators[n] = 0;
+        }
+        void addSum(std::uint32_t n, double v) noexcept{
+            qnn.m_sums[n] += static_cast<float>(v);
+        }
+        std::int32_t value(std::uint32_t n, double output) const noexcept{
+            return quantizeValue(output, qnn.m_invOutputScales[n]);
+        }
+        void send(std::int32_t output, std::uint32_t c) noexcept{
+            qnn.m_accumulators[qnn.m_dest[c]] += output * qnn.m_weights[c];
+        }
+        QuantizedNetwork& qnn;
+    };
+    QuantizedNetwork::QuantizedNetwork()
+    : m_order()
+    , m_rowPtr()
+    , m_dest()
+    , m_types()
+    , m_activations()
+    , m_biases()
+    , m_weights()
+    , m_sumScales()
+    , m_outputScales()
+    , m_invOutputScales()
+    , m_accumulators()
+    , m_sums()
+    , m_numInputs(0u)
+    , m_outputBegin(0u)
+    , m_mode(PlanEvaluationMode::EDGE_MAJOR)
+    , m_softmax(false){}
+    QuantizedNetwork::QuantizedNetwork(NeuralNetwork& nn, const std::vector<std::vector<double>>& calibrationData, PlanEvaluationMode mode)
+    : QuantizedNetwork(){
+        ExecutionPlan plan(nn, mode);
+        m_mode = mode;
+        m_order = plan.getOrder();
+        m_rowPtr = plan.getRowPtr();
+        m_dest = plan.getDestinations();
+        m_types = plan.getTypes();
+        m_activations = plan.getActivationTypes();
+        m_biases.assign(std::begin(plan.getBiases()), std::end(plan.getBiases()));
+        m_numInputs = plan.numInputs();
+        m_outputBegin = plan.numNeurons() - plan.numOutputs();
+        m_softmax = plan.hasSoftmax();
+        auto size = plan.numNeurons();
+        auto& weights = plan.getWeights();
+        Calibration calibration{m_dest, weights, std::vector<double>(size, 0.0), std::vector<double>(size, 0.0)};
+        for(auto& inputs:calibrationData){
+            if(inputs.size() != m_numInputs){
+                continue;
+            }
+            // each sample starts like NeuralNetwork::forward after NeuralNetwork::reset.
+            for(auto n=0u;n<size;++n){
+                if(m_types[n] != Neuron::Type::CONTEXT){
+                    calibration.setSum(n, 0.0);
+                }
+            }
+            std::copy(std::begin(inputs), std::end(inputs), std::begin(calibration.sums));
+            run(calibration);
+        }
+        m_outputScales.resize(size);
+        m_invOutputScales.resize(size);
+        for(auto n=0u;n<size;++n){
+            m_outputScales[n] = static_cast<float>(scaleFor(calibration.maxOutputs[n]));
+            m_invOutputScales[n] = 1.0f / m_outputScales[n];
+        }
+        // one scale per destination for the weights multiplied by the scale of their source,
+        // Neuron::Type::OUTPUT neurons copy their sum so their weights are not used.
+        std::vector<double> maxWeights(size, 0.0);
+        for(auto n=0u;n<size;++n){
+            if(m_types[n] == Neuron::Type::OUTPUT){
+                continue;
+            }
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                auto& maxWeight = maxWeights[m_dest[c]];
+                maxWeight = std::max(maxWeight, std::abs(weights[c] * m_outputScales[n]));
+            }
+        }
+        m_sumScales.resize(size);
+        for(auto n=0u;n<size;++n){
+            m_sumScales[n] = static_cast<float>(scaleFor(maxWeights[n]));
+        }
+        m_weights.resize(weights.size());
+        for(auto n=0u;n<size;++n){
+            for(auto c=m_rowPtr[n];c<m_rowPtr[n + 1];++c){
+                auto q = quantizeValue(weights[c] * m_outputScales[n], 1.0 / m_sumScales[m_dest[c]]);
+                m_weights[c] = static_cast<std::int8_t>(q);
+            }
+        }
+        m_accumulators.assign(size, 0);
+        m_sums.assign(size, 0.0f);
+    }
+    std::vector<double> QuantizedNetwork::forward(const std::vector<double>& inputs) noexcept{
+        if(inputs.size() != m_numInputs){
+            return {};
+        }
+        Inference inference{*this};
+        for(auto i=0u;i<m_numInputs;++i){
+            inference.setSum(i, inputs[i]);
+        }
+        run(inference);
+        auto size = m_types.size();
+        std::vector<double> outputs;
+        outputs.reserve(size - m_outputBegin);
+        for(auto n=m_outputBegin;n<size;++n){
+            inference.addSum(n, m_biases[n]);
+            outputs.emplace_back(Activations::activate(m_activations[n], sum(n), m_biases[n]));
+        }
+        if(m_softmax){
+            Activations::softmax(outputs.data(), outputs.size());
+        }
+        return outputs;
+    }
+    void QuantizedNetwork::reset() noexcept{
+        auto size = m_types.size();
+        for(auto n=0u;n<size;++n){
+            if(m_types[n] != Neuron::Type::CONTEXT){
+                m_sums[n] = 0.0f;
+                m_accumulators[n] = 0;
+            }
+        }
+    }
+    void QuantizedNetwork::resetContext() noexcept{
+        std::fill(std::begin(m_sums), std::end(m_sums), 0.0f);
+        std::fill(std::begin(m_accumulators), std::end(m_accumulators), 0);
+    }
+    std::size_t QuantizedNetwork::memoryUsage() const noexcept{
+        return sizeof(QuantizedNetwork) +
+                (m_order.capacity() + m_rowPtr.capacity() + m_dest.capacity()) * sizeof(std::uint32_t) +
+                m_types.capacity() * sizeof(Neuron::Type) +
+                m_activations.capacity() * sizeof(Neuron::ActivationType) +
+                (m_biases.capacity() + m_sumScales.capacity() + m_outputScales.capacity() +
+                    m_invOutputScales.capacity() + m_sums.capacity()) * sizeof(float) +
+                m_weights.capacity() * sizeof(std::int8_t) +
+                m_accumulators.capacity() * sizeof(std::int32_t);
+    }
+//private member functions
+    template<typename Engine>
+    void QuantizedNetwork::run(Engine& engine) noexcept{
+        auto neuronMajor = m_mode == PlanEvaluationMode::NEURON_MAJOR;
+        for(auto n:m_order){
+            auto begin = m_rowPtr[n];
+            auto end = m_rowPtr[n + 1];
+            if(begin == end){
+                continue;
+            }
+            auto type = m_types[n];
+            if(type == Neuron::Type::OUTPUT){
+                // same as ExecutionPlan::storeOutput, a self connection leaves the sum unchanged.
+                for(auto c=begin;c<end;++c){
+                    if(m_dest[c] != n){
+                        engine.setSum(m_dest[c], engine.sum(n) + m_biases[n]);
+                    }
+                }
+                continue;
+            }
+            auto output = [&](){
+                if(type == Neuron::Type::INPUT){
+                    return engine.value(n, engine.sum(n));
+                }
+                if(type == Neuron::Type::HIDDEN){
+                    engine.addSum(n, m_biases[n]);
+                }
+                return engine.value(n, Activations::activate(m_activations[n], engine.sum(n), m_biases[n]));
+            };
+            auto value = output();
+            for(auto c=begin;c<end;++c){
+                if(!neuronMajor && c != begin){
+                    value = output();
+                }
+                engine.send(value, c);
+                auto dest = m_dest[c];
+                if(m_types[dest] == Neuron::Type::CONTEXT && type != Neuron::Type::INPUT){
+                    engine.setSum(dest, engine.sum(n));
+                }
+            }
+        }
+    }
+    QuantizedNetwork quantize(NeuralNetwork& nn, const std::vector<std::vector<double>>& calibrationData, PlanEvaluationMode mode){
+        return QuantizedNetwork(nn, calibrationData, mode);
+    }
+}
@@ -0,0 +1,43 @@
+#include <EvoAI/RecurrentSession.hpp>
+
+namespace EvoAI{
+    RecurrentSession::RecurrentSession(NeuralNetwork& nn, std::size_t numSequences)
+    : m_nn(&nn)
+    , m_state(){
+        if(!nn.isCompiled()){
+            nn.compile();
+        }
+        m_state = nn.getExecutionPlan().makeBatchState(numSequences);
+    }
+    std::vector<double> RecurrentSession::step(const std::vector<double>& inputs){
+        if(!m_nn->isCompiled()){
+            return {};
+        }
+        std::vector<double> outputs(m_state.batchSize * m_nn->getExecutionPlan().numOutputs());
+        if(!step(inputs.data(), inputs.size(), outputs.data(), outputs.size())){
+            return {};
+        }
+        return outputs;
+    }
+    bool RecurrentSession::step(const double* inputs, std::size_t inputSize, double* outputs, std::size_t outputSize) noexcept{
+        if(!m_nn->isCompiled()){
+            return false;
+        }
+        auto& plan = m_nn->getExecutionPlan();
+        if(!plan.forwardBatch(inputs, inputSize, outputs, outputSize, m_state)){
+            return false;
+        }
+        plan.reset(m_state);
+        return true;
+    }
+    void RecurrentSession::resetSequence(std::size_t sequence) noexcept{
+        if(m_nn->isCompiled()){
+            m_nn->getExecutionPlan().resetContext(m_state, sequence);
+        }
+    }
+    void RecurrentSession::resetContext() noexcept{
+        for(auto s=0u;s<m_state.batchSize;++s){
+            resetSequence(s);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include <EvoAI/ThreadPool.hpp>
+
+namespace{
+    /**
+     * @brief pool of the current thread, used to run nested tasks in place.
+     */
+    thread_local const EvoAI::ThreadPool* currentPool = nullptr;
+}
+
+namespace EvoAI{
+    ThreadPool::ThreadPool(std::size_t numThreads)
+    : m_threads()
+    , m_runMutex()
+    , m_mutex()
+    , m_start()
+    , m_done()
+    , m_task(nullptr)
+    , m_numTasks(0u)
+    , m_next(0u)
+    , m_working(0u)
+    , m_generation(0u)
+    , m_stop(false){
+        if(numThreads == 0u){
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_threads.reserve(numThreads - 1u);
+        for(auto i=1u;i<numThreads;++i){
+            m_threads.emplace_back(&ThreadPool::loop, this);
+        }
+    }
+    void ThreadPool::run(std::size_t numTasks, const Task& task) noexcept{
+        std::unique_lock runLock(m_runMutex, std::defer_lock);
+        if(numTasks == 0u){
+            return;
+        }
+        if(numTasks == 1u || m_threads.empty() || currentPool == this || !runLock.try_lock()){
+            for(auto i=0u;i<numTasks;++i){
+                task(i);
+            }
+            return;
+        }
+        {
+            std::lock_guard lg(m_mutex);
+            m_task = &task;
+            m_numTasks = numTasks;
+            m_next = 0u;
+            m_working = m_threads.size();
+            ++m_generation;
+        }
+        m_start.notify_all();
+        auto previous = currentPool;
+        currentPool = this;
+        work();
+        currentPool = previous;
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this](){ return m_working == 0u; });
+        m_task = nullptr;
+    }
+    ThreadPool::~ThreadPool(){
+        {
+            std::lock_guard lg(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for(auto& t:m_threads){
+            t.join();
+        }
+    }
+//private member functions
+    void ThreadPool::work() noexcept{
+        for(auto i=m_next++;i<m_numTasks;i=m_next++){
+            (*m_task)(i);
+        }
+    }
+    void ThreadPool::loop() noexcept{
+        currentPool = this;
+        std::uint64_t generation = 0u;
+        while(true){
+            {
+                std::unique_lock lock(m_mutex);
+                m_start.wait(lock, [&](){ return m_stop || m_generation != generation; });
+                if(m_stop){
+                    return;
+                }
+                generation = m_generation;
+            }
+            work();
+            {
+                std::lock_guard lg(m_mutex);
+                --m_working;
+            }
+            m_done.notify_one();
+        }
+    }
+}
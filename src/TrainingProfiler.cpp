@@ -0,0 +1,103 @@
+#include <EvoAI/TrainingProfiler.hpp>
+
+#include <sstream>
+#include <limits>
+
+namespace EvoAI{
+    double TrainingProfiler::EpochStats::samplesPerSecond() const noexcept{
+        if(seconds <= 0.0){
+            return 0.0;
+        }
+        return samples / seconds;
+    }
+    JsonBox::Value TrainingProfiler::EpochStats::toJson() const noexcept{
+        JsonBox::Object o;
+        o["epoch"] = std::to_string(epoch);
+        o["samples"] = std::to_string(samples);
+        o["seconds"] = seconds;
+        o["samplesPerSecond"] = samplesPerSecond();
+        JsonBox::Object phases;
+        for(auto i=0u;i<NumPhases;++i){
+            JsonBox::Object phase;
+            phase["seconds"] = phaseSeconds[i];
+            phase["calls"] = std::to_string(phaseCalls[i]);
+            phases[phaseName(static_cast<Phase>(i))] = phase;
+        }
+        o["phases"] = phases;
+        return o;
+    }
+    std::string TrainingProfiler::EpochStats::toCSV() const noexcept{
+        std::ostringstream row;
+        row.precision(std::numeric_limits<double>::max_digits10);
+        row << epoch << "," << samples << "," << seconds << "," << samplesPerSecond();
+        for(auto i=0u;i<NumPhases;++i){
+            row << "," << phaseSeconds[i] << "," << phaseCalls[i];
+        }
+        return row.str();
+    }
+    TrainingProfiler::TrainingProfiler() noexcept
+    : m_out(nullptr)
+    , m_format(Format::JSON)
+    , m_current()
+    , m_epochStart()
+    , m_epochs(){}
+    TrainingProfiler::TrainingProfiler(std::ostream& out, Format format)
+    : m_out(&out)
+    , m_format(format)
+    , m_current()
+    , m_epochStart()
+    , m_epochs(){
+        if(m_format == Format::CSV){
+            *m_out << csvHeader() << std::endl;
+        }
+    }
+    void TrainingProfiler::beginEpoch(std::uint64_t epoch) noexcept{
+        m_current = EpochStats{};
+        m_current.epoch = epoch;
+        m_epochStart = Clock::now();
+    }
+    void TrainingProfiler::record(Phase phase, Clock::duration elapsed, std::uint64_t calls) noexcept{
+        auto index = static_cast<std::size_t>(phase);
+        m_current.phaseSeconds[index] += std::chrono::duration<double>(elapsed).count();
+        m_current.phaseCalls[index] += calls;
+    }
+    const TrainingProfiler::EpochStats& TrainingProfiler::endEpoch(std::size_t samples) noexcept{
+        m_current.samples = samples;
+        m_current.seconds = std::chrono::duration<double>(Clock::now() - m_epochStart).count();
+        m_epochs.emplace_back(m_current);
+        if(m_out){
+            if(m_format == Format::CSV){
+                *m_out << m_current.toCSV() << std::endl;
+            }else{
+                m_current.toJson().writeToStream(*m_out, false);
+                *m_out << std::endl;
+            }
+        }
+        return m_epochs.back();
+    }
+    const std::vector<TrainingProfiler::EpochStats>& TrainingProfiler::getEpochs() const noexcept{
+        return m_epochs;
+    }
+    void TrainingProfiler::clear() noexcept{
+        m_epochs.clear();
+    }
+    const char* TrainingProfiler::phaseName(Phase phase) noexcept{
+        switch(phase){
+            case Phase::DATA_LOADING:   return "dataLoading";
+            case Phase::FORWARD:        return "forward";
+            case Phase::LOSS:           return "loss";
+            case Phase::BACKWARD:       return "backward";
+            case Phase::OPTIMIZER:      return "optimizer";
+            case Phase::TEST:           return "test";
+        }
+        return "";
+    }
+    std::string TrainingProfiler::csvHeader() noexcept{
+        std::string header = "epoch,samples,seconds,samplesPerSecond";
+        for(auto i=0u;i<NumPhases;++i){
+            std::string name = phaseName(static_cast<Phase>(i));
+            header += "," + name + "Seconds," + name + "Calls";
+        }
+        return header;
+    }
+}
@@ -162,6 +162,162 @@ namespace EvoAI{
             std::cout << "[ " << result.first << " == " << result.second << "]" << std::endl;
             EXPECT_NEAR(result.first, result.second, 1e-2);
         }
+        TEST(ActivationsTests, Arrays){
+            std::vector<double> values;
+            for(auto i=-2000;i<=2000;++i){
+                values.emplace_back(i * 0.0137);
+            }
+            values.insert(std::end(values), {0.0, 1e-300, 1e8, -1e8, 800.0, -800.0});
+            std::vector<double> positives;
+            for(auto v:values){
+                positives.emplace_back(std::abs(v) + 1e-3);
+            }
+            std::vector<double> gradients(values.size(), 0.5);
+            auto near = [](double expected, double value){
+                return expected == value || (std::isnan(expected) && std::isnan(value))
+                        || std::abs(expected - value) <= 1e-12 * std::max(1.0, std::abs(expected));
+            };
+            // the float arrays are evaluated in single precision.
+            auto nearFloat = [](float expected, float value){
+                return expected == value || (std::isnan(expected) && std::isnan(value))
+                        || std::abs(expected - value) <= 1e-5f * std::max(1.0f, std::abs(expected));
+            };
+            auto supported = Activations::Array::getSupportedSimdLevel();
+            for(auto level:{Activations::Array::SimdLevel::SCALAR, Activations::Array::SimdLevel::SSE2, Activations::Array::SimdLevel::AVX2}){
+                if(level > supported){
+                    continue;
+                }
+                Activations::Array::setSimdLevel(level);
+                EXPECT_EQ(level, Activations::Array::getSimdLevel());
+                for(auto i=0;i<static_cast<int>(Neuron::ActivationType::LAST_CPPN_ACTIVATION_TYPE);++i){
+                    auto at = static_cast<Neuron::ActivationType>(i);
+                    if(at == Neuron::ActivationType::NOISY_RELU){
+                        continue;
+                    }
+                    auto& in = (at == Neuron::ActivationType::LOG ? positives:values);
+                    std::vector<double> outputs(in.size());
+                    std::vector<double> derivatives(in.size());
+                    Activations::Array::activate(at, in.data(), outputs.data(), in.size(), 0.7);
+                    Derivatives::Array::derivate(at, in.data(), in.data(), gradients.data(), derivatives.data(), in.size(), 0.7);
+                    for(auto j=0u;j<in.size();++j){
+                        auto expected = Activations::activate(at, in[j], 0.7);
+                        auto expectedDerivative = Derivatives::derivate(at, in[j], in[j], 0.7, 0.5);
+                        EXPECT_TRUE(near(expected, outputs[j])) << Neuron::activationTypeToString(at) << "(" << in[j] << ")";
+                        EXPECT_TRUE(near(expectedDerivative, derivatives[j])) << Neuron::activationTypeToString(at) << "'(" << in[j] << ")";
+                    }
+                    std::vector<float> floatIn(std::begin(in), std::end(in));
+                    std::vector<float> floatGradients(std::begin(gradients), std::end(gradients));
+                    std::vector<float> floatOutputs(in.size());
+                    std::vector<float> floatDerivatives(in.size());
+                    Activations::Array::activate(at, floatIn.data(), floatOutputs.data(), in.size(), 0.7);
+                    Derivatives::Array::derivate(at, floatIn.data(), floatIn.data(), floatGradients.data(), floatDerivatives.data(), in.size(), 0.7);
+                    for(auto j=0u;j<in.size();++j){
+                        auto expected = static_cast<float>(Activations::activate(at, floatIn[j], 0.7));
+                        auto expectedDerivative = static_cast<float>(Derivatives::derivate(at, floatIn[j], floatIn[j], 0.7, 0.5));
+                        EXPECT_TRUE(nearFloat(expected, floatOutputs[j])) << Neuron::activationTypeToString(at) << "(" << floatIn[j] << ")f";
+                        EXPECT_TRUE(nearFloat(expectedDerivative, floatDerivatives[j])) << Neuron::activationTypeToString(at) << "'(" << floatIn[j] << ")f";
+                    }
+                }
+            }
+            Activations::Array::setSimdLevel(supported);
+            EXPECT_EQ(supported, Activations::Array::getSimdLevel());
+        }
+        TEST(ActivationsTests, LookupTable){
+            using at = Neuron::ActivationType;
+            for(auto maxError:{1e-2, 1e-4, 1e-6}){
+                Activations::LookupTable table(maxError);
+                EXPECT_EQ(maxError, table.getMaxError());
+                for(auto type:{at::SIGMOID, at::TANH, at::GAUSSIAN, at::SINUSOID, at::COSINE}){
+                    EXPECT_TRUE(Activations::LookupTable::isApproximated(type));
+                    auto worst = 0.0;
+                    for(auto v=-60.0;v<=60.0;v+=0.0037){
+                        worst = std::max(worst, std::abs(table.activate(type, v, 1.0) - Activations::activate(type, v, 1.0)));
+                    }
+                    EXPECT_LE(worst, maxError) << Neuron::activationTypeToString(type);
+                    EXPECT_TRUE(std::isnan(table.activate(type, std::numeric_limits<double>::quiet_NaN(), 1.0)));
+                    constexpr auto inf = std::numeric_limits<double>::infinity();
+                    std::vector<double> values{-3.0, -0.5, 0.0, 0.25, 7.0, -inf, inf, std::numeric_limits<double>::quiet_NaN(),
+                                                1e20, -1e20, 2.0 * EvoAI::PI, -2.0 * EvoAI::PI, 1e-300};
+                    for(auto v=-40.0;v<=40.0;v+=0.0371){
+                        values.emplace_back(v);
+                    }
+                    std::vector<double> outputs(values.size());
+                    std::vector<float> floatValues(values.begin(), values.end());
+                    std::vector<float> floatOutputs(values.size());
+                    auto supported = Activations::Array::getSupportedSimdLevel();
+                    for(auto level:{Activations::Array::SimdLevel::SCALAR, Activations::Array::SimdLevel::SSE2, Activations::Array::SimdLevel::AVX2}){
+                        Activations::Array::setSimdLevel(level);
+                        table.activate(type, values.data(), outputs.data(), values.size(), 1.0);
+                        table.activate(type, floatValues.data(), floatOutputs.data(), values.size(), 1.0);
+                        auto inPlace = values;
+                        table.activate(type, inPlace.data(), inPlace.data(), inPlace.size(), 1.0);
+                        for(auto i=0u;i<values.size();++i){
+                            auto expected = table.activate(type, values[i], 1.0);
+                            auto expectedFloat = static_cast<float>(table.activate(type, floatValues[i], 1.0));
+                            if(std::isnan(expected)){
+                                EXPECT_TRUE(std::isnan(outputs[i])) << Neuron::activationTypeToString(type) << "(" << values[i] << ")";
+                                EXPECT_TRUE(std::isnan(inPlace[i])) << Neuron::activationTypeToString(type) << "(" << values[i] << ")";
+                                EXPECT_TRUE(std::isnan(floatOutputs[i])) << Neuron::activationTypeToString(type) << "(" << values[i] << ")";
+                            }else{
+                                EXPECT_EQ(expected, outputs[i]) << Neuron::activationTypeToString(type) << "(" << values[i] << ")";
+                                EXPECT_EQ(expected, inPlace[i]) << Neuron::activationTypeToString(type) << "(" << values[i] << ")";
+                                EXPECT_EQ(expectedFloat, floatOutputs[i]) << Neuron::activationTypeToString(type) << "(" << values[i] << ")";
+                            }
+                        }
+                    }
+                    Activations::Array::setSimdLevel(supported);
+                }
+            }
+            Activations::LookupTable table(1e-3);
+            EXPECT_FALSE(Activations::LookupTable::isApproximated(at::RELU));
+            EXPECT_EQ(Activations::activate(at::SWISH, 0.3, 0.7), table.activate(at::SWISH, 0.3, 0.7));
+            EXPECT_LT(table.memoryUsage(), 64u * 1024u);
+            EXPECT_EQ(1e-9, Activations::LookupTable(0.0).getMaxError());
+        }
+        TEST(ActivationsTests, LookupTableNetwork){
+            auto cppn = createCPPN(3,2,{4,4},2,1.0);
+            for(auto n:cppn->getNeurons()){
+                if(n->getActivationType() == Neuron::ActivationType::NOISY_RELU){
+                    n->setActivationType(Neuron::ActivationType::RELU);
+                }
+            }
+            auto approximated = NeuralNetwork(cppn->toJson().getObject());
+            approximated.setActivationTable(std::make_shared<Activations::LookupTable>(1e-5));
+            auto compiled = NeuralNetwork(cppn->toJson().getObject());
+            compiled.compile();
+            compiled.setActivationTable(approximated.getActivationTable());
+            EXPECT_EQ(approximated.getActivationTable(), compiled.getExecutionPlan().getActivationTable());
+            for(auto i=0;i<20;++i){
+                std::vector<double> inputs{randomGen().random(-1.0, 1.0), randomGen().random(-1.0, 1.0), randomGen().random(-1.0, 1.0)};
+                auto out = approximated.forward(inputs);
+                auto compiledOut = compiled.forward(inputs);
+                approximated.reset();
+                compiled.reset();
+                EXPECT_TRUE(sameOutputs(out, compiledOut));
+            }
+            // a random CPPN can amplify any error with its discontinuous activations,
+            // with smooth ones the error of the outputs stays close to the error of the table.
+            auto nn = createFeedForwardNN(3,3,{5,5,5},2,1.0);
+            (*nn)[1].setActivationType(Neuron::ActivationType::SIGMOID);
+            (*nn)[2].setActivationType(Neuron::ActivationType::TANH);
+            (*nn)[3].setActivationType(Neuron::ActivationType::SINUSOID);
+            (*nn)[4].setActivationType(Neuron::ActivationType::GAUSSIAN);
+            auto smooth = NeuralNetwork(nn->toJson().getObject());
+            smooth.setActivationTable(approximated.getActivationTable());
+            for(auto i=0;i<20;++i){
+                std::vector<double> inputs{randomGen().random(-1.0, 1.0), randomGen().random(-1.0, 1.0), randomGen().random(-1.0, 1.0)};
+                auto expected = nn->forward(inputs);
+                auto out = smooth.forward(inputs);
+                nn->reset();
+                smooth.reset();
+                ASSERT_EQ(expected.size(), out.size());
+                for(auto j=0u;j<out.size();++j){
+                    EXPECT_NEAR(expected[j], out[j], 1e-3);
+                }
+            }
+            approximated.setActivationTable(nullptr);
+            EXPECT_FALSE(approximated.getActivationTable());
+        }
     }
 }
 #endif // EVOAI_UTILS_TEST_HPP
@@ -0,0 +1,31 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace{
+    std::atomic<std::size_t> allocations{0u};
+}
+
+void* operator new(std::size_t size){
+    ++allocations;
+    if(auto p = std::malloc(size == 0u ? 1u : size)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept{
+    std::free(p);
+}
+
+namespace EvoAI{
+    namespace Test{
+        std::size_t numAllocations() noexcept{
+            return allocations.load();
+        }
+    }
+}
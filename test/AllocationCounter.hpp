@@ -0,0 +1,18 @@
+#ifndef EVOAI_ALLOCATION_COUNTER_HPP
+#define EVOAI_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace EvoAI{
+    namespace Test{
+        /**
+         * @brief number of calls to the global operator new made by the test program, the library included.
+         * @details AllocationCounter.cpp replaces the global operator new and delete to count them,
+         * the tests check that it doesn't change over a code path that must not allocate.
+         * @return std::size_t
+         */
+        std::size_t numAllocations() noexcept;
+    }
+}
+
+#endif // EVOAI_ALLOCATION_COUNTER_HPP
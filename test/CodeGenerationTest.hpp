@@ -0,0 +1,135 @@
+#ifndef EVOAI_CODE_GENERATION_TEST_HPP
+#define EVOAI_CODE_GENERATION_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+namespace EvoAI{
+    namespace Test{
+        /**
+         * @brief exports each network, compiles a program with the generated headers that runs the inputs
+         * in order and returns its outputs, empty if the program could not be compiled.
+         */
+        std::vector<std::vector<double>> runGeneratedCpp(std::vector<std::pair<std::string, NeuralNetwork*>>& networks,
+                                                            const std::vector<std::vector<std::vector<double>>>& inputs){
+            #ifdef EvoAI_TEST_CXX_COMPILER
+                std::ofstream harness("testsData/generatedHarness.cpp");
+                harness << "#include <cstdio>\n#include <array>\n";
+                for(auto& [name, nn]:networks){
+                    if(!nn->exportCpp("testsData/" + name + ".hpp", name)){
+                        return {};
+                    }
+                    harness << "#include \"" << name << ".hpp\"\n";
+                }
+                // the inputs are read at run time, constants could be folded with a different rounding than libm.
+                std::ofstream values("testsData/generatedHarness.in");
+                values << std::hexfloat;
+                harness << "int main(){\n";
+                for(auto i=0u;i<networks.size();++i){
+                    auto& name = networks[i].first;
+                    harness << "    {\n        std::array<double, " << name << "::contextSize> context{};\n"
+                            << "        double inputs[" << name << "::numInputs];\n"
+                            << "        double outputs[" << name << "::numOutputs];\n"
+                            << "        for(auto i=0;i<" << inputs[i].size() << ";++i){\n"
+                            << "            for(auto& v:inputs){ if(std::scanf(\"%la\", &v) != 1){ return 1; } }\n"
+                            << "            " << name << "::forward(inputs, outputs, context.data());\n"
+                            << "            for(auto v:outputs){ std::printf(\"%a\\n\", v); }\n"
+                            << "        }\n    }\n";
+                    for(auto& in:inputs[i]){
+                        for(auto v:in){
+                            values << v << "\n";
+                        }
+                    }
+                }
+                values.close();
+                harness << "}\n";
+                harness.close();
+                auto command = std::string(EvoAI_TEST_CXX_COMPILER) + " -std=c++17 -O2 testsData/generatedHarness.cpp"
+                                " -o testsData/generatedHarness && ./testsData/generatedHarness < testsData/generatedHarness.in > testsData/generatedHarness.txt";
+                if(std::system(command.c_str()) != 0){
+                    return {};
+                }
+                std::ifstream results("testsData/generatedHarness.txt");
+                std::vector<std::vector<double>> outputs;
+                for(auto i=0u;i<networks.size();++i){
+                    for(auto j=0u;j<inputs[i].size();++j){
+                        std::vector<double> out;
+                        for(auto k=0u;k<(*networks[i].second)[networks[i].second->size() - 1].size();++k){
+                            std::string line;
+                            std::getline(results, line);
+                            out.emplace_back(std::strtod(line.c_str(), nullptr));
+                        }
+                        outputs.emplace_back(std::move(out));
+                    }
+                }
+                return outputs;
+            #else
+                (void)networks;
+                (void)inputs;
+                return {};
+            #endif
+        }
+        TEST(CodeGenerationTest, Source){
+            auto nn = createFeedForwardNN(2,1,{3},1,1.0);
+            (*nn)[1].setActivationType(Neuron::ActivationType::GAUSSIAN);
+            nn->compile();
+            auto source = generateCpp(nn->getExecutionPlan(), "net");
+            EXPECT_NE(std::string::npos, source.find("namespace net{"));
+            EXPECT_NE(std::string::npos, source.find("constexpr double weights[9]"));
+            EXPECT_NE(std::string::npos, source.find("inline double gaussian("));
+            EXPECT_EQ(std::string::npos, source.find("inline double tanh("));
+            EXPECT_EQ(std::string::npos, source.find("switch"));
+            EXPECT_TRUE(generateCpp(nn->getExecutionPlan(), "1net").empty());
+            EXPECT_TRUE(generateCpp(nn->getExecutionPlan(), "my net").empty());
+            EXPECT_FALSE(nn->exportCpp("testsData/invalid.hpp", "net-1"));
+        }
+        TEST(CodeGenerationTest, Harness){
+            auto feedForward = createFeedForwardNN(3,2,{5,4},2,1.0);
+            auto cppn = createCPPN(3,2,{6,6},3,1.0);
+            makeDeterministic(*cppn);
+            auto softmax = createFeedForwardNN(4,1,{6},3,1.0);
+            (*softmax)[2].setActivationType(Neuron::ActivationType::SOFTMAX);
+            auto elman = createElmanNeuralNetwork(2,2,{3,3},2,1.0);
+            Genome g(3,2,true,true);
+            for(auto i=0;i<30;++i){
+                g.mutate();
+            }
+            auto phenotype = Genome::makePhenotype(g);
+            makeDeterministic(phenotype);
+            std::vector<std::pair<std::string, NeuralNetwork*>> networks = {
+                {"feedForward", feedForward.get()}, {"cppn", cppn.get()}, {"softmax", softmax.get()},
+                {"elman", elman.get()}, {"phenotype", &phenotype}
+            };
+            std::vector<std::vector<std::vector<double>>> inputs;
+            for(auto& [name, nn]:networks){
+                std::vector<std::vector<double>> steps;
+                for(auto i=0;i<12;++i){
+                    steps.emplace_back(randomInputs((*nn)[0].size()));
+                }
+                inputs.emplace_back(std::move(steps));
+            }
+            #ifndef EvoAI_TEST_CXX_COMPILER
+                GTEST_SKIP() << "there is no compiler for the generated code.";
+            #endif
+            auto generated = runGeneratedCpp(networks, inputs);
+            ASSERT_FALSE(generated.empty());
+            auto k = 0u;
+            for(auto i=0u;i<networks.size();++i){
+                auto& nn = *networks[i].second;
+                nn.resetContext();
+                for(auto& in:inputs[i]){
+                    auto expected = nn.forward(in);
+                    nn.reset();
+                    // the compiler of the generated code could contract or reorder the operations.
+                    EXPECT_TRUE(nearOutputs(expected, generated[k++])) << networks[i].first;
+                }
+            }
+        }
+    }
+}
+
+#endif // EVOAI_CODE_GENERATION_TEST_HPP
@@ -0,0 +1,554 @@
+#ifndef EVOAI_EXECUTION_PLAN_TEST_HPP
+#define EVOAI_EXECUTION_PLAN_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <cmath>
+#include <thread>
+
+namespace EvoAI{
+    namespace Test{
+        /**
+         * @brief copies a NeuralNetwork through its json.
+         */
+        NeuralNetwork cloneNN(const NeuralNetwork& nn) noexcept{
+            return NeuralNetwork(nn.toJson().getObject());
+        }
+        /**
+         * @brief replaces the activations that use random numbers.
+         */
+        void makeDeterministic(NeuralNetwork& nn) noexcept{
+            for(auto n:nn.getNeurons()){
+                if(n->getActivationType() == Neuron::ActivationType::NOISY_RELU){
+                    n->setActivationType(Neuron::ActivationType::RELU);
+                }
+            }
+        }
+        std::vector<double> randomInputs(std::size_t size) noexcept{
+            std::vector<double> inputs;
+            inputs.reserve(size);
+            for(auto i=0u;i<size;++i){
+                inputs.emplace_back(randomGen().random(-1.0, 1.0));
+            }
+            return inputs;
+        }
+        bool sameOutputs(const std::vector<double>& lhs, const std::vector<double>& rhs) noexcept{
+            if(lhs.size() != rhs.size()){
+                return false;
+            }
+            for(auto i=0u;i<lhs.size();++i){
+                auto bothNan = std::isnan(lhs[i]) && std::isnan(rhs[i]);
+                if(!bothNan && lhs[i] != rhs[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+        /**
+         * @brief compares outputs that went through Activations::Array, they can differ in a few ulps.
+         */
+        bool nearOutputs(const std::vector<double>& lhs, const std::vector<double>& rhs) noexcept{
+            if(lhs.size() != rhs.size()){
+                return false;
+            }
+            for(auto i=0u;i<lhs.size();++i){
+                auto bothNan = std::isnan(lhs[i]) && std::isnan(rhs[i]);
+                if(!bothNan && lhs[i] != rhs[i] && !(std::abs(lhs[i] - rhs[i]) <= 1e-9 * std::max(1.0, std::abs(lhs[i])))){
+                    return false;
+                }
+            }
+            return true;
+        }
+        TEST(ExecutionPlanTest, Layout){
+            auto nn = createFeedForwardNN(2,1,{3},2,1.0);
+            nn->compile();
+            EXPECT_TRUE(nn->isCompiled());
+            auto& plan = nn->getExecutionPlan();
+            EXPECT_EQ(7u, plan.numNeurons());
+            EXPECT_EQ(12u, plan.numConnections());
+            EXPECT_EQ(2u, plan.numInputs());
+            EXPECT_EQ(2u, plan.numOutputs());
+            EXPECT_EQ(8u, plan.getRowPtr().size());
+            EXPECT_EQ(3u, plan.getRowPtr()[1]);
+            EXPECT_EQ(2u, plan.getDestinations()[3]);
+            EXPECT_EQ((*nn)[0][1][0].getWeight(), plan.getWeights()[3]);
+            EXPECT_EQ((*nn)[1][2].getBiasWeight(), plan.getBiases()[4]);
+        }
+        TEST(ExecutionPlanTest, FeedForward){
+            auto nn = createFeedForwardNN(3,2,{5,4},2,1.0);
+            auto compiled = cloneNN(*nn);
+            compiled.compile();
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(3);
+                auto expected = nn->forward(inputs);
+                auto out = compiled.forward(inputs);
+                nn->reset();
+                compiled.reset();
+                EXPECT_TRUE(sameOutputs(expected, out));
+            }
+        }
+        TEST(ExecutionPlanTest, Softmax){
+            auto nn = createFeedForwardNN(4,1,{6},3,1.0);
+            (*nn)[2].setActivationType(Neuron::ActivationType::SOFTMAX);
+            auto compiled = cloneNN(*nn);
+            compiled.compile();
+            auto expected = nn->forward({0.1, 0.2, 0.3, 0.4});
+            auto out = compiled.forward({0.1, 0.2, 0.3, 0.4});
+            EXPECT_TRUE(sameOutputs(expected, out));
+        }
+        TEST(ExecutionPlanTest, Elman){
+            auto nn = createElmanNeuralNetwork(2,2,{3,3},2,1.0);
+            auto compiled = cloneNN(*nn);
+            compiled.compile();
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = nn->forward(inputs);
+                auto out = compiled.forward(inputs);
+                nn->reset();
+                compiled.reset();
+                EXPECT_TRUE(sameOutputs(expected, out));
+            }
+            nn->resetContext();
+            compiled.resetContext();
+            EXPECT_TRUE(sameOutputs(nn->forward({1.0, 0.5}), compiled.forward({1.0, 0.5})));
+        }
+        TEST(ExecutionPlanTest, Phenotype){
+            Genome g(3,2,true,true);
+            for(auto i=0;i<20;++i){
+                g.mutate();
+            }
+            auto nn = Genome::makePhenotype(g);
+            makeDeterministic(nn);
+            auto compiled = cloneNN(nn);
+            compiled.compile();
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(3);
+                auto expected = nn.forward(inputs);
+                auto out = compiled.forward(inputs);
+                nn.reset();
+                compiled.reset();
+                EXPECT_TRUE(sameOutputs(expected, out));
+            }
+        }
+        TEST(ExecutionPlanTest, NeuronMajor){
+            // with zero biases activating a neuron once per connection gives the same outputs.
+            auto nn = createFeedForwardNN(3,2,{5,4},2,1.0);
+            for(auto n:nn->getNeurons()){
+                n->setBiasWeight(0.0);
+            }
+            auto edgeMajor = cloneNN(*nn);
+            auto neuronMajor = cloneNN(*nn);
+            edgeMajor.compile(ExecutionPlan::EvaluationMode::EDGE_MAJOR);
+            neuronMajor.compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            EXPECT_EQ(ExecutionPlan::EvaluationMode::NEURON_MAJOR, neuronMajor.getExecutionPlan().getEvaluationMode());
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(3);
+                auto expected = nn->forward(inputs);
+                auto edgeOut = edgeMajor.forward(inputs);
+                auto neuronOut = neuronMajor.forward(inputs);
+                nn->reset();
+                edgeMajor.reset();
+                neuronMajor.reset();
+                EXPECT_TRUE(sameOutputs(expected, edgeOut));
+                EXPECT_TRUE(sameOutputs(expected, neuronOut));
+                // 5*4 + 4*2 hidden connections + 2 outputs
+                EXPECT_EQ(30u, edgeMajor.getExecutionPlan().getActivationCount());
+                // 5 + 4 hidden neurons + 2 outputs
+                EXPECT_EQ(11u, neuronMajor.getExecutionPlan().getActivationCount());
+            }
+            // one connection per hidden neuron gives the same outputs with biases.
+            auto single = createFeedForwardNN(2,1,{3},1,1.0);
+            auto singleNeuronMajor = cloneNN(*single);
+            singleNeuronMajor.compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            auto expected = single->forward({0.5, -0.5});
+            EXPECT_TRUE(sameOutputs(expected, singleNeuronMajor.forward({0.5, -0.5})));
+            EXPECT_EQ(4u, singleNeuronMajor.getExecutionPlan().getActivationCount());
+        }
+        TEST(ExecutionPlanTest, NeuronMajorElman){
+            auto nn = createElmanNeuralNetwork(2,1,{3},1,1.0);
+            for(auto n:nn->getNeurons()){
+                n->setBiasWeight(0.0);
+            }
+            auto compiled = cloneNN(*nn);
+            compiled.compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = nn->forward(inputs);
+                auto out = compiled.forward(inputs);
+                nn->reset();
+                compiled.reset();
+                EXPECT_TRUE(sameOutputs(expected, out));
+            }
+        }
+        TEST(ExecutionPlanTest, DenseBlocks){
+            auto nn = createFeedForwardNN(3,2,{5,4},2,1.0);
+            ExecutionPlan edgeMajor(*nn);
+            ExecutionPlan neuronMajor(*nn, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            auto& blocks = neuronMajor.getDenseBlocks();
+            ASSERT_EQ(3u, blocks.size());
+            EXPECT_EQ(0u, blocks[0].srcBegin);
+            EXPECT_EQ(3u, blocks[0].srcEnd);
+            EXPECT_EQ(3u, blocks[0].destBegin);
+            EXPECT_EQ(8u, blocks[0].destEnd);
+            EXPECT_TRUE(blocks[0].inputsOnly);
+            EXPECT_FALSE(blocks[1].inputsOnly);
+            EXPECT_EQ(12u, blocks[2].destBegin);
+            EXPECT_EQ(14u, blocks[2].destEnd);
+            EXPECT_EQ(3u, edgeMajor.getDenseBlocks().size());
+            // the context layer and the hidden layer, its first connection saves it into the context layer.
+            auto elman = createElmanNeuralNetwork(2,1,{4},2,1.0);
+            ExecutionPlan elmanPlan(*elman, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            ASSERT_EQ(3u, elmanPlan.getDenseBlocks().size());
+            EXPECT_EQ(1u, elmanPlan.getDenseBlocks()[2].offset);
+            // a connection back into the layer runs connection by connection.
+            nn->addConnection(Connection(Link(1,0),Link(1,1),0.5));
+            ExecutionPlan lateral(*nn, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            EXPECT_EQ(2u, lateral.getDenseBlocks().size());
+            // many lanes split the dest neurons in tiles.
+            auto wide = createFeedForwardNN(8,1,{64},3,1.0);
+            ExecutionPlan plan(*wide, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            std::vector<double> inputs;
+            for(auto i=0;i<256;++i){
+                auto in = randomInputs(8);
+                inputs.insert(std::end(inputs), std::begin(in), std::end(in));
+            }
+            auto outputs = plan.forwardBatch(inputs, 256);
+            ASSERT_EQ(256u * 3u, outputs.size());
+            for(auto b=0u;b<256u;++b){
+                auto expected = plan.forward(std::vector<double>(std::begin(inputs) + b * 8, std::begin(inputs) + (b + 1) * 8));
+                plan.reset();
+                EXPECT_TRUE(nearOutputs(expected, std::vector<double>(std::begin(outputs) + b * 3, std::begin(outputs) + (b + 1) * 3)));
+            }
+        }
+        TEST(ExecutionPlanTest, Backward){
+            auto nn = createFeedForwardNN(2,1,{3},1,1.0);
+            auto compiled = cloneNN(*nn);
+            compiled.compile();
+            nn->forward({0.5, -0.5});
+            compiled.forward({0.5, -0.5});
+            nn->backward({1.0});
+            compiled.backward({1.0});
+            auto params = nn->getParameters();
+            auto compiledParams = compiled.getParameters();
+            ASSERT_EQ(params.size(), compiledParams.size());
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_EQ(params[i]->getGradient(), compiledParams[i]->getGradient());
+            }
+        }
+        TEST(ExecutionPlanTest, ForwardBatch){
+            auto check = [](NeuralNetwork& nn, std::size_t numInputs){
+                auto batched = cloneNN(nn);
+                const std::size_t batchSize = 5;
+                std::vector<double> batchInputs;
+                std::vector<double> expected;
+                for(auto b=0u;b<batchSize;++b){
+                    auto inputs = randomInputs(numInputs);
+                    batchInputs.insert(std::end(batchInputs), std::begin(inputs), std::end(inputs));
+                    auto out = cloneNN(nn).forward(inputs);
+                    expected.insert(std::end(expected), std::begin(out), std::end(out));
+                }
+                EXPECT_TRUE(nearOutputs(expected, batched.forwardBatch(batchInputs, batchSize)));
+                EXPECT_TRUE(batched.isCompiled());
+                EXPECT_EQ(batchSize, batched.getExecutionPlan().getBatchSize());
+                EXPECT_TRUE(batched.forwardBatch(batchInputs, batchSize + 1).empty());
+            };
+            auto ff = createFeedForwardNN(3,2,{5,4},2,1.0);
+            check(*ff, 3);
+            auto elman = createElmanNeuralNetwork(2,2,{3,3},2,1.0);
+            check(*elman, 2);
+            auto softmax = createFeedForwardNN(4,1,{6},3,1.0);
+            (*softmax)[2].setActivationType(Neuron::ActivationType::SOFTMAX);
+            check(*softmax, 4);
+            Genome g(3,2,true,true);
+            for(auto i=0;i<20;++i){
+                g.mutate();
+            }
+            auto phenotype = Genome::makePhenotype(g);
+            makeDeterministic(phenotype);
+            check(phenotype, 3);
+        }
+        TEST(ExecutionPlanTest, BackwardBatch){
+            auto nn = createFeedForwardNN(3,2,{5,4},2,1.0);
+            auto batched = cloneNN(*nn);
+            const std::size_t batchSize = 4;
+            std::vector<double> batchInputs;
+            std::vector<double> batchGradients;
+            std::vector<double> expectedInputGradients;
+            for(auto b=0u;b<batchSize;++b){
+                auto inputs = randomInputs(3);
+                auto gradients = randomInputs(2);
+                batchInputs.insert(std::end(batchInputs), std::begin(inputs), std::end(inputs));
+                batchGradients.insert(std::end(batchGradients), std::begin(gradients), std::end(gradients));
+                nn->forward(inputs);
+                auto inputGradients = nn->backward(std::move(gradients));
+                expectedInputGradients.insert(std::end(expectedInputGradients), std::begin(inputGradients), std::end(inputGradients));
+                nn->reset();
+            }
+            EXPECT_TRUE(batched.backwardBatch(batchGradients).empty());
+            batched.forwardBatch(batchInputs, batchSize);
+            auto inputGradients = batched.backwardBatch(batchGradients);
+            EXPECT_TRUE(nearOutputs(expectedInputGradients, inputGradients));
+            auto params = nn->getParameters();
+            auto batchedParams = batched.getParameters();
+            ASSERT_EQ(params.size(), batchedParams.size());
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_NEAR(params[i]->getGradient(), batchedParams[i]->getGradient(), 1e-9);
+            }
+        }
+        TEST(ExecutionPlanTest, BackwardBatchGradientOfSums){
+            auto nn = createFeedForwardNN(3,1,{5},3,1.0);
+            (*nn)[2].setActivationType(Neuron::ActivationType::SOFTMAX);
+            auto batched = cloneNN(*nn);
+            const std::size_t batchSize = 3;
+            std::vector<double> batchInputs;
+            std::vector<double> batchGradients;
+            std::vector<double> expectedInputGradients;
+            for(auto b=0u;b<batchSize;++b){
+                auto inputs = randomInputs(3);
+                auto gradients = randomInputs(3);
+                batchInputs.insert(std::end(batchInputs), std::begin(inputs), std::end(inputs));
+                batchGradients.insert(std::end(batchGradients), std::begin(gradients), std::end(gradients));
+                nn->forward(inputs);
+                auto inputGradients = nn->backward(std::move(gradients), true);
+                expectedInputGradients.insert(std::end(expectedInputGradients), std::begin(inputGradients), std::end(inputGradients));
+                nn->reset();
+            }
+            batched.forwardBatch(batchInputs, batchSize);
+            auto inputGradients = batched.backwardBatch(batchGradients, true);
+            EXPECT_TRUE(nearOutputs(expectedInputGradients, inputGradients));
+            auto params = nn->getParameters();
+            auto batchedParams = batched.getParameters();
+            ASSERT_EQ(params.size(), batchedParams.size());
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_NEAR(params[i]->getGradient(), batchedParams[i]->getGradient(), 1e-9);
+            }
+        }
+        TEST(ExecutionPlanTest, TrainBatched){
+            NeuralNetwork nn(1,1,{1},1,1.0);
+            nn.addConnection(Connection(Link(0,0),Link(1,0),1.0));
+            nn.addConnection(Connection(Link(1,0),Link(2,0),1.0));
+            nn.compile();
+            auto batchSize = 10u;
+            DataLoader<Dataset> trainDataset(Dataset({{1},{2},{3},{4},{5},{6},{7},{8},{9},{10}}, 
+                                                     {{0},{0},{0},{0},{0},{0},{0},{0},{0},{0}}, batchSize));
+            DataLoader<Dataset> testDataset(Dataset({{1}}, {{0}}, 1));
+            auto testFn = [](NeuralNetwork&, auto&){
+                return std::make_pair(0.0, 0.0);
+            };
+            EvoAI::Optimizer optim(0.1, batchSize, SGD(nn.getParameters(), 0.8), EvoAI::Scheduler(ConstantLR()));
+            auto data = nn.train(trainDataset, testDataset, optim, 50, Loss::MeanSquaredError{}, testFn);
+            EXPECT_LT(data[0].back(), data[0].front());
+            EXPECT_EQ(batchSize, nn.getExecutionPlan().getBatchSize());
+            for(auto i=1;i<=10;++i){
+                auto out = nn.forward({static_cast<double>(i)});
+                nn.reset();
+                EXPECT_EQ(0,out[0] > 0.5 ? 1:0);
+            }
+        }
+        TEST(ExecutionPlanTest, FloatPlan){
+            auto nn = createFeedForwardNN(3,2,{5,4},2,1.0);
+            auto batchSize = 32u;
+            auto report = compareFloatPlan(*nn, randomInputs(3 * batchSize), batchSize);
+            EXPECT_LT(report.maxAbsError, 1e-5);
+            EXPECT_LT(report.meanAbsError, 1e-6);
+            EXPECT_GT(report.maxAbsError, 0.0);
+            auto elman = createElmanNeuralNetwork(2,1,{4},2,1.0);
+            ExecutionPlan reference(*elman);
+            ExecutionPlanF plan(*elman);
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = reference.forward(inputs);
+                reference.reset();
+                auto out = plan.forward(std::vector<float>(std::begin(inputs), std::end(inputs)));
+                plan.reset();
+                EXPECT_LT(compareOutputs(expected, out, 2).maxAbsError, 1e-5);
+            }
+            auto mismatch = compareOutputs(std::vector<double>{1.0, 2.0}, std::vector<float>{1.0f}, 1);
+            EXPECT_TRUE(std::isinf(mismatch.maxAbsError));
+            EXPECT_EQ(0.0, mismatch.argmaxAgreement);
+        }
+        TEST(ExecutionPlanTest, FloatTraining){
+            NeuralNetwork nn(1,1,{1},1,1.0);
+            nn.addConnection(Connection(Link(0,0),Link(1,0),1.0));
+            nn.addConnection(Connection(Link(1,0),Link(2,0),1.0));
+            ExecutionPlanF plan(nn);
+            auto batchSize = 10u;
+            std::vector<float> inputs{1,2,3,4,5,6,7,8,9,10};
+            std::vector<double> expected(batchSize, 0.0);
+            EvoAI::Optimizer optim(0.1, batchSize, SGD(nn.getParameters(), 0.8), EvoAI::Scheduler(ConstantLR()));
+            Loss::MeanSquaredError mse;
+            auto firstLoss = 0.0;
+            auto lastLoss = 0.0;
+            for(auto e=0u;e<50u;++e){
+                auto out = plan.forwardBatch(inputs, batchSize);
+                std::vector<double> outputs(std::begin(out), std::end(out));
+                lastLoss = mse(expected, outputs);
+                if(e == 0u){
+                    firstLoss = lastLoss;
+                }
+                auto gradients = mse.backward(expected, outputs);
+                plan.backwardBatch(std::vector<float>(std::begin(gradients), std::end(gradients)));
+                plan.writeGradients(nn);
+                optim.step(e);
+                optim.zeroGrad();
+                plan.updateWeights(nn);
+            }
+            EXPECT_LT(lastLoss, firstLoss);
+            EXPECT_EQ(static_cast<float>(nn[0][0][0].getWeight()), plan.getWeights()[0]);
+        }
+        TEST(ExecutionPlanTest, InferenceState){
+            auto elman = createElmanNeuralNetwork(2,1,{4},2,1.0);
+            auto shared = cloneNN(*elman);
+            auto state = shared.makeInferenceState();
+            EXPECT_TRUE(shared.isCompiled());
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = elman->forward(inputs);
+                elman->reset();
+                auto out = shared.forward(inputs, state);
+                shared.reset(state);
+                EXPECT_TRUE(sameOutputs(expected, out));
+            }
+            // the plan state is not modified.
+            auto& plan = shared.getExecutionPlan();
+            EXPECT_TRUE(std::all_of(std::begin(plan.getSums()), std::end(plan.getSums()), [](auto sum){ return sum == 0.0; }));
+            shared.resetContext(state);
+            EXPECT_TRUE(std::all_of(std::begin(state.sums), std::end(state.sums), [](auto sum){ return sum == 0.0; }));
+            EXPECT_TRUE(shared.forward({1.0}, state).empty());
+            InferenceState empty;
+            EXPECT_TRUE(shared.forward({1.0, 1.0}, empty).empty());
+        }
+        TEST(ExecutionPlanTest, SharedThreads){
+            auto elman = createElmanNeuralNetwork(3,1,{8},2,1.0);
+            std::vector<std::vector<double>> inputs;
+            std::vector<std::vector<double>> expected;
+            for(auto i=0;i<50;++i){
+                inputs.emplace_back(randomInputs(3));
+                expected.emplace_back(elman->forward(inputs.back()));
+                elman->reset();
+            }
+            elman->resetContext();
+            elman->compile();
+            const auto& shared = *elman;
+            std::vector<int> matches(4, 0);
+            std::vector<std::thread> workers;
+            for(auto t=0u;t<matches.size();++t){
+                workers.emplace_back([&, t](){
+                    auto state = shared.getExecutionPlan().makeState();
+                    for(auto i=0u;i<inputs.size();++i){
+                        auto out = shared.forward(inputs[i], state);
+                        shared.reset(state);
+                        matches[t] += sameOutputs(expected[i], out) ? 1 : 0;
+                    }
+                });
+            }
+            for(auto& w:workers){
+                w.join();
+            }
+            for(auto m:matches){
+                EXPECT_EQ(50, m);
+            }
+        }
+        TEST(ExecutionPlanTest, Invalidation){
+            NeuralNetwork nn(1,1,{1},1,1.0);
+            nn.compile();
+            EXPECT_TRUE(nn.isCompiled());
+            nn.addConnection(Connection(Link(0,0),Link(1,0),1.0));
+            EXPECT_FALSE(nn.isCompiled());
+            nn.compile();
+            nn[0][0][0].setWeight(2.0);
+            nn.getExecutionPlan().updateWeights(nn);
+            EXPECT_EQ(2.0, nn.getExecutionPlan().getWeights()[0]);
+            nn.decompile();
+            EXPECT_FALSE(nn.isCompiled());
+        }
+        TEST(ExecutionPlanTest, LevelParallel){
+            auto pool = std::make_shared<ThreadPool>(4);
+            auto check = [&](NeuralNetwork& nn, std::size_t numInputs){
+                ExecutionPlan sequential(nn, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+                ExecutionPlan parallel(nn, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+                parallel.setThreadPool(pool, 1u);
+                std::vector<double> batch;
+                for(auto i=0;i<10;++i){
+                    auto inputs = randomInputs(numInputs);
+                    batch.insert(std::end(batch), std::begin(inputs), std::end(inputs));
+                    EXPECT_TRUE(sameOutputs(sequential.forward(inputs), parallel.forward(inputs)));
+                    EXPECT_EQ(sequential.getActivationCount(), parallel.getActivationCount());
+                    sequential.reset();
+                    parallel.reset();
+                }
+                EXPECT_TRUE(sameOutputs(sequential.forwardBatch(batch, 10), parallel.forwardBatch(batch, 10)));
+                return parallel.getLevelOffsets().size();
+            };
+            auto nn = createFeedForwardNN(16,2,{64,32},4,1.0);
+            EXPECT_EQ(5u, check(*nn, 16));
+            Genome g(4,3,false,false);
+            for(auto i=0;i<40;++i){
+                g.mutateAddNode();
+            }
+            auto phenotype = Genome::makeLayeredPhenotype(g);
+            EXPECT_EQ(phenotype.size() + 1u, check(phenotype, 4));
+            // the context neurons need the sequential run.
+            auto elman = createElmanNeuralNetwork(3,1,{8},2,1.0);
+            EXPECT_EQ(0u, check(*elman, 3));
+            // a small network is not split with the default minimum.
+            nn->setThreadPool(pool);
+            nn->compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            EXPECT_EQ(pool, nn->getExecutionPlan().getThreadPool());
+            auto inputs = randomInputs(16);
+            auto expected = ExecutionPlan(*nn, ExecutionPlan::EvaluationMode::NEURON_MAJOR).forward(inputs);
+            EXPECT_TRUE(sameOutputs(expected, nn->forward(inputs)));
+        }
+        TEST(ExecutionPlanTest, DataParallelBatch){
+            auto pool = std::make_shared<ThreadPool>(3u);
+            auto nn = createFeedForwardNN(6,2,{16,8},3,1.0);
+            auto sharded = cloneNN(*nn);
+            auto repeated = cloneNN(*nn);
+            nn->compile();
+            for(auto* net:{&sharded, &repeated}){
+                net->compile();
+                net->getExecutionPlan().setThreadPool(pool, 1u);
+            }
+            const std::size_t batchSize = 10;
+            auto batchInputs = randomInputs(batchSize * 6u);
+            auto batchGradients = randomInputs(batchSize * 3u);
+            EXPECT_TRUE(nearOutputs(nn->forwardBatch(batchInputs, batchSize), sharded.forwardBatch(batchInputs, batchSize)));
+            EXPECT_EQ(nn->getExecutionPlan().getActivationCount(), sharded.getExecutionPlan().getActivationCount());
+            EXPECT_TRUE(nearOutputs(nn->backwardBatch(batchGradients), sharded.backwardBatch(batchGradients)));
+            repeated.forwardBatch(batchInputs, batchSize);
+            repeated.backwardBatch(batchGradients);
+            auto params = nn->getParameters();
+            auto shardedParams = sharded.getParameters();
+            auto repeatedParams = repeated.getParameters();
+            ASSERT_EQ(params.size(), shardedParams.size());
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_NEAR(params[i]->getGradient(), shardedParams[i]->getGradient(), 1e-9);
+                // the same number of threads always reduces the shards in the same order.
+                EXPECT_EQ(shardedParams[i]->getGradient(), repeatedParams[i]->getGradient());
+            }
+            auto train = [&](NeuralNetwork& net){
+                std::vector<std::vector<double>> inputs;
+                std::vector<std::vector<double>> targets;
+                for(auto i=0u;i<20u;++i){
+                    inputs.emplace_back(std::begin(batchInputs) + (i % batchSize) * 6u, std::begin(batchInputs) + (i % batchSize + 1u) * 6u);
+                    targets.push_back({0.0, 1.0, 0.5});
+                }
+                DataLoader<Dataset> trainDataset(Dataset(std::move(inputs), std::move(targets), 10), false);
+                DataLoader<Dataset> testDataset(Dataset(10), false);
+                EvoAI::Optimizer optim(0.1, 10, SGD(net.getParameters(), 0.0), EvoAI::Scheduler(ConstantLR()));
+                optim.zeroGrad();
+                net.train(trainDataset, testDataset, optim, 3, Loss::MeanSquaredError{}, [](NeuralNetwork&, auto&){
+                    return std::make_pair(0.0, 0.0);
+                });
+                std::vector<double> weights;
+                for(auto p:net.getParameters()){
+                    weights.emplace_back(p->getWeight());
+                }
+                return weights;
+            };
+            EXPECT_EQ(train(sharded), train(repeated));
+        }
+    }
+}
+
+#endif // EVOAI_EXECUTION_PLAN_TEST_HPP
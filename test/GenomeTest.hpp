@@ -195,6 +195,58 @@ namespace EvoAI{
             auto speciesThreshold = 10.0;
             EXPECT_TRUE(Genome::distance(g1,g2) < speciesThreshold);
         }
+        TEST(GenomeTest, LayeredPhenotype){
+            // h1 feeds h0, the flat phenotype runs h0 before h1 gives it anything.
+            Genome reversed(2,1,false,false);
+            reversed.addGene(NodeGene(1,0));
+            reversed.addGene(NodeGene(1,1));
+            reversed.addGene(ConnectionGene(Link(0,0),Link(1,1),0.5));
+            reversed.addGene(ConnectionGene(Link(1,1),Link(1,0),-0.7));
+            reversed.addGene(ConnectionGene(Link(1,0),Link(2,0),0.9));
+            auto layered = Genome::makeLayeredPhenotype(reversed);
+            ASSERT_EQ(4u, layered.size());
+            EXPECT_EQ(1u, layered[1].size());
+            EXPECT_EQ(1u, layered[2].size());
+            EXPECT_TRUE(layered.hasConnection({0,0},{1,0}));
+            EXPECT_TRUE(layered.hasConnection({1,0},{2,0}));
+            EXPECT_TRUE(layered.hasConnection({2,0},{3,0}));
+            // the same network with the ids in order gives the outputs in one pass with makePhenotype.
+            Genome ordered(2,1,false,false);
+            for(auto& cg:ordered.getConnectionChromosomes()){
+                auto& original = *std::find_if(std::begin(reversed.getConnectionChromosomes()), std::end(reversed.getConnectionChromosomes()), [&](auto& rcg){
+                    return rcg.getSrc() == cg.getSrc() && rcg.getDest() == cg.getDest();
+                });
+                cg.setWeight(original.getWeight());
+            }
+            ordered.addGene(NodeGene(1,0));
+            ordered.addGene(NodeGene(1,1));
+            ordered.addGene(ConnectionGene(Link(0,0),Link(1,0),0.5));
+            ordered.addGene(ConnectionGene(Link(1,0),Link(1,1),-0.7));
+            ordered.addGene(ConnectionGene(Link(1,1),Link(2,0),0.9));
+            auto flat = Genome::makePhenotype(ordered);
+            for(auto i=0;i<5;++i){
+                auto inputs = randomInputs(2);
+                auto expected = flat.forward(inputs);
+                flat.reset();
+                EXPECT_TRUE(sameOutputs(expected, layered.forward(inputs)));
+                layered.reset();
+            }
+            for(auto i=0;i<10;++i){
+                Genome g(3,2,false,false);
+                for(auto j=0;j<30;++j){
+                    g.mutateAddNode();
+                }
+                auto nn = Genome::makeLayeredPhenotype(g);
+                EXPECT_EQ(Genome::makePhenotype(g).getConnections().size(), nn.getConnections().size());
+                for(auto& c:nn.getConnections()){
+                    EXPECT_LT(c->getSrc().layer, c->getDest().layer);
+                }
+                g.mutateAddConnection();
+                g.mutateAddConnection();
+                nn = Genome::makeLayeredPhenotype(g);
+                EXPECT_EQ(g.getNodeChromosomes().size(), nn.getNeurons().size());
+            }
+        }
     }
 }
 #endif // EVOAI_GENOME_TEST_HPP
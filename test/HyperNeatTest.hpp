@@ -6,6 +6,8 @@
 #include <array>
 #include <vector>
 
+#include "AllocationCounter.hpp"
+
 namespace EvoAI{
     namespace Test{
         TEST(HyperNeatTest, Constructor){
@@ -31,6 +33,55 @@ namespace EvoAI{
             hn.setInputs({2.3,2.5});
             auto out = hn.run();
         }
+        TEST(HyperNeatTest,ForwardWithoutAllocations){
+            HyperNeat hn(SubstrateInfo(3,2,{4,4},2),HyperNeat::SubstrateConfiguration::GRID);
+            std::array<double, 3> in{0.25, 0.5, 1.0};
+            std::array<double, 2> out{};
+            ASSERT_TRUE(hn.forward(in.data(), in.size(), out.data(), out.size()));
+            hn.reset();
+            auto before = numAllocations();
+            for(auto i=0u;i<50u;++i){
+                EXPECT_TRUE(hn.forward(in.data(), in.size(), out.data(), out.size()));
+                hn.reset();
+            }
+            EXPECT_EQ(before, numAllocations());
+            EXPECT_FALSE(hn.forward(in.data(), 2u, out.data(), out.size()));
+        }
+        TEST(HyperNeatTest,BatchedSubstrate){
+            Genome g(3,2,false,true);
+            for(auto i=0u;i<30u;++i){
+                g.mutate();
+            }
+            // the weights are not clamped so they are compared bit by bit.
+            SubstrateInfo info(3,2,{6,6},2,0.5,1e300);
+            HyperNeat hn(info, g, HyperNeat::SubstrateConfiguration::GRID);
+            // the same substrate made querying the cppn one sample at a time through NeuralNetwork::run.
+            NeuralNetwork perSample(info.numInputs, info.numHiddenLayers, info.numHiddenNeurons, info.numOutputs, 1.0);
+            auto cppn = Genome::makePhenotype(hn.getGenome());
+            auto& neurons = perSample.getNeurons();
+            auto size = neurons.size();
+            for(auto i=0u;i<size;++i){
+                for(auto j=0u;j<size;++j){
+                    auto d = distanceCenter<double>(static_cast<double>(i), static_cast<double>(j), static_cast<double>(size), static_cast<double>(size));
+                    auto out = cppn.forward({static_cast<double>(i), static_cast<double>(j), d});
+                    cppn.reset();
+                    if(out[1] >= info.leo){
+                        auto c = Connection(perSample.getIndex(neurons[i]), perSample.getIndex(neurons[j]), out[0]);
+                        if(!c.isRecurrent()){
+                            perSample.addConnection(c);
+                        }
+                    }
+                }
+            }
+            auto& expected = perSample.getConnections();
+            auto& batched = hn.getSubstrate().getConnections();
+            ASSERT_EQ(expected.size(), batched.size());
+            for(auto i=0u;i<expected.size();++i){
+                EXPECT_TRUE(expected[i]->getSrc() == batched[i]->getSrc());
+                EXPECT_TRUE(expected[i]->getDest() == batched[i]->getDest());
+                EXPECT_EQ(expected[i]->getWeight(), batched[i]->getWeight());
+            }
+        }
         TEST(HyperNeatTest,Saving){
             HyperNeat hn(SubstrateInfo(2,3,{2,2,2},2),HyperNeat::SubstrateConfiguration::SANDWICH);
             hn.makeSubstrate();
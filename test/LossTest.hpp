@@ -17,6 +17,15 @@ namespace EvoAI{
         auto d2 = fn.backward({expectedOutput}, {output});
         return std::make_pair(d1, d2[0]);
     }
+    template<typename Fn>
+    bool lossAndGradChecking() noexcept{
+        std::vector<double> expectedOutputs{0.0, 1.0, 0.0, 0.25};
+        std::vector<double> outputs{0.2, 0.6, 0.1, 0.4};
+        std::vector<double> gradients(outputs.size());
+        Loss::Loss<Fn> fn{Fn{}};
+        auto loss = fn.lossAndGrad(expectedOutputs.data(), outputs.data(), gradients.data(), outputs.size());
+        return loss == fn(expectedOutputs, outputs) && gradients == fn.backward(expectedOutputs, outputs);
+    }
     namespace Test{
         TEST(LossTest, TypeCheck){
             // uncomment to test, should not compile.
@@ -48,6 +57,26 @@ namespace EvoAI{
             std::cout << "[ " << result.first << " == " << result.second << "]" << std::endl;
             EXPECT_NEAR(result.first, result.second, 1e-2);
         }
+        TEST(LossTest, LossAndGrad){
+            EXPECT_TRUE(lossAndGradChecking<Loss::MeanError>());
+            EXPECT_TRUE(lossAndGradChecking<Loss::MeanSquaredError>());
+            EXPECT_TRUE(lossAndGradChecking<Loss::MeanAbsoluteError>());
+            EXPECT_TRUE(lossAndGradChecking<Loss::BinaryCrossEntropy>());
+            EXPECT_TRUE(lossAndGradChecking<Loss::MultiClassCrossEntropy>());
+            EXPECT_FALSE(Loss::Loss<Loss::MeanSquaredError>::FusesSoftmax);
+            EXPECT_TRUE(Loss::Loss<Loss::MultiClassCrossEntropy>::FusesSoftmax);
+        }
+        TEST(LossTest, SoftmaxLossAndGrad){
+            std::vector<double> expectedOutputs{0.0, 1.0, 0.0};
+            std::vector<double> outputs{0.2, 0.7, 0.1};
+            std::vector<double> gradients(outputs.size());
+            Loss::Loss<Loss::MultiClassCrossEntropy> fn{Loss::MultiClassCrossEntropy{}};
+            auto loss = fn.softmaxLossAndGrad(expectedOutputs.data(), outputs.data(), gradients.data(), outputs.size());
+            EXPECT_DOUBLE_EQ(fn(expectedOutputs, outputs), loss);
+            for(auto i=0u;i<outputs.size();++i){
+                EXPECT_DOUBLE_EQ(outputs[i] - expectedOutputs[i], gradients[i]);
+            }
+        }
     }
 }
 
@@ -0,0 +1,133 @@
+#ifndef EVOAI_MODEL_FILE_TEST_HPP
+#define EVOAI_MODEL_FILE_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <cstring>
+
+namespace EvoAI{
+    namespace Test{
+        /**
+         * @brief a network with context neurons, a softmax output layer and frozen weights.
+         */
+        std::unique_ptr<NeuralNetwork> modelFileNN() noexcept{
+            auto nn = createElmanNeuralNetwork(3, 1, {4}, 3, 1.0);
+            (*nn)[nn->size() - 1].setActivationType(Neuron::ActivationType::SOFTMAX);
+            (*nn)[1][2].setActivationType(Neuron::ActivationType::TANH);
+            (*nn)[1][0].getBiasPtr()->setFrozen(true);
+            nn->getConnections()[3]->setFrozen(true);
+            auto o = nn->toJson().getObject();
+            o["globalStep"] = std::string("7");
+            return std::make_unique<NeuralNetwork>(o);
+        }
+        TEST(ModelFileTest, RoundTrip){
+            auto nn = modelFileNN();
+            ASSERT_TRUE(ModelFile::write(*nn, "testsData/model.evoai"));
+            ModelFile model("testsData/model.evoai");
+            ASSERT_TRUE(model.isValid());
+            auto& header = model.getHeader();
+            EXPECT_EQ(ModelFile::Version, header.version);
+            EXPECT_EQ(7u, header.globalStep);
+            EXPECT_EQ(nn->size(), header.numLayers);
+            EXPECT_EQ(nn->getNeurons().size(), header.numNeurons);
+            EXPECT_EQ(nn->getConnections().size(), header.numConnections);
+            EXPECT_EQ(header.fileSize, model.size());
+            EXPECT_EQ(nn->getConnections()[5]->getWeight(), model.getWeights()[5]);
+            NeuralNetwork loaded(model);
+            EXPECT_EQ(nn->toJson(), loaded.toJson());
+            EXPECT_EQ(7u, loaded.getGlobalStep());
+            EXPECT_TRUE(loaded.getConnections()[3]->isFrozen());
+            EXPECT_TRUE(loaded[1][0].getBiasPtr()->isFrozen());
+            for(auto i=0;i<5;++i){
+                auto inputs = randomInputs(3);
+                EXPECT_TRUE(sameOutputs(nn->forward(inputs), loaded.forward(inputs)));
+            }
+        }
+        TEST(ModelFileTest, ExecutionPlan){
+            auto check = [](NeuralNetwork& nn, std::size_t numInputs, ExecutionPlan::EvaluationMode mode){
+                ASSERT_TRUE(ModelFile::write(nn, "testsData/modelPlan.evoai"));
+                ModelFile model("testsData/modelPlan.evoai");
+                ASSERT_TRUE(model.isValid());
+                ExecutionPlan fromModel(model, mode);
+                ExecutionPlan fromNN(nn, mode);
+                EXPECT_EQ(fromNN.numNeurons(), fromModel.numNeurons());
+                EXPECT_EQ(fromNN.numConnections(), fromModel.numConnections());
+                EXPECT_EQ(fromNN.getDenseBlocks().size(), fromModel.getDenseBlocks().size());
+                for(auto i=0;i<5;++i){
+                    auto inputs = randomInputs(numInputs);
+                    EXPECT_TRUE(sameOutputs(fromNN.forward(inputs), fromModel.forward(inputs)));
+                    fromNN.reset();
+                    fromModel.reset();
+                }
+            };
+            auto nn = modelFileNN();
+            check(*nn, 3, ExecutionPlan::EvaluationMode::EDGE_MAJOR);
+            auto ff = createFeedForwardNN(4, 2, {6, 5}, 2, 1.0);
+            check(*ff, 4, ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            Genome g(3, 2, true, true);
+            for(auto i=0;i<20;++i){
+                g.mutate();
+            }
+            auto phenotype = Genome::makePhenotype(g);
+            makeDeterministic(phenotype);
+            check(phenotype, 3, ExecutionPlan::EvaluationMode::EDGE_MAJOR);
+        }
+        TEST(ModelFileTest, Json){
+            auto nn = modelFileNN();
+            nn->writeToFile("testsData/model.json");
+            ASSERT_TRUE(ModelFile::jsonToBinary("testsData/model.json", "testsData/modelJson.evoai"));
+            ASSERT_TRUE(ModelFile::binaryToJson("testsData/modelJson.evoai", "testsData/modelBinary.json"));
+            NeuralNetwork json("testsData/model.json");
+            NeuralNetwork binary("testsData/modelBinary.json");
+            EXPECT_EQ(json.toJson(), binary.toJson());
+            EXPECT_FALSE(ModelFile::binaryToJson("testsData/missing.evoai", "testsData/missing.json"));
+        }
+        TEST(ModelFileTest, Invalid){
+            ModelFile missing("testsData/missing.evoai");
+            EXPECT_FALSE(missing.isValid());
+            EXPECT_EQ(0u, NeuralNetwork(missing).size());
+            EXPECT_EQ(0u, ExecutionPlan(missing).numNeurons());
+            auto nn = modelFileNN();
+            ASSERT_TRUE(ModelFile::write(*nn, "testsData/modelInvalid.evoai"));
+            std::vector<char> bytes;
+            {
+                std::ifstream in("testsData/modelInvalid.evoai", std::ios_base::binary);
+                bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+            auto writeBytes = [](const std::vector<char>& data){
+                std::ofstream out("testsData/modelInvalid.evoai", std::ios_base::binary);
+                out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            };
+            // truncated
+            writeBytes(std::vector<char>(std::begin(bytes), std::end(bytes) - 8));
+            EXPECT_FALSE(ModelFile("testsData/modelInvalid.evoai").isValid());
+            // wrong magic
+            auto corrupted = bytes;
+            corrupted[0] = 'X';
+            writeBytes(corrupted);
+            EXPECT_FALSE(ModelFile("testsData/modelInvalid.evoai").isValid());
+            // a connection to a neuron that doesn't exist
+            corrupted = bytes;
+            ModelFile::Header header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            std::uint32_t dest = header.numNeurons;
+            std::memcpy(corrupted.data() + header.connectionsOffset, &dest, sizeof(dest));
+            writeBytes(corrupted);
+            EXPECT_FALSE(ModelFile("testsData/modelInvalid.evoai").isValid());
+            writeBytes(bytes);
+            ModelFile model("testsData/modelInvalid.evoai");
+            EXPECT_TRUE(model.isValid());
+            ModelFile moved(std::move(model));
+            EXPECT_TRUE(moved.isValid());
+            EXPECT_FALSE(model.isValid());
+            model = std::move(moved);
+            EXPECT_TRUE(model.isValid());
+            EXPECT_EQ(nn->getConnections().size(), model.getHeader().numConnections);
+        }
+    }
+}
+
+#endif // EVOAI_MODEL_FILE_TEST_HPP
@@ -3,6 +3,9 @@
 
 #include <gtest/gtest.h>
 #include <EvoAI.hpp>
+#include <array>
+
+#include "AllocationCounter.hpp"
 
 namespace EvoAI{
     namespace Test{
@@ -163,6 +166,288 @@ namespace EvoAI{
             nn->writeDotFile("testsData/NNCheckGradients.dot");
             nn->writeToFile("testsData/NNCheckGradients.json");
         }
+        TEST_F(NeuralNetworkTest, ForwardWithoutAllocations){
+            auto nn = createElmanNeuralNetwork(3, 2, {6, 4}, 2, 1.0);
+            (*nn)[nn->size() - 1].setActivationType(Neuron::ActivationType::SOFTMAX);
+            std::array<double, 3> in{0.5, -0.25, 1.0};
+            std::array<double, 2> out{};
+            EXPECT_FALSE(nn->forward(in.data(), 2u, out.data(), out.size()));
+            EXPECT_FALSE(nn->forward(in.data(), in.size(), out.data(), 3u));
+            auto checkNoAllocations = [&](){
+                // the first pass caches the connections.
+                ASSERT_TRUE(nn->forward(in.data(), in.size(), out.data(), out.size()));
+                nn->resetContext();
+                auto expected = nn->forward(std::vector<double>(std::begin(in), std::end(in)));
+                nn->resetContext();
+                auto before = numAllocations();
+                for(auto i=0u;i<50u;++i){
+                    nn->forward(in.data(), in.size(), out.data(), out.size());
+                    nn->reset();
+                }
+                EXPECT_EQ(before, numAllocations());
+                nn->resetContext();
+                nn->forward(in.data(), in.size(), out.data(), out.size());
+                nn->resetContext();
+                EXPECT_EQ(expected[0], out[0]);
+                EXPECT_EQ(expected[1], out[1]);
+            };
+            checkNoAllocations();
+            nn->compile();
+            checkNoAllocations();
+            nn->compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            checkNoAllocations();
+            // the levels split on the ThreadPool.
+            nn->getExecutionPlan().setThreadPool(std::make_shared<ThreadPool>(2u), 1u);
+            checkNoAllocations();
+        }
+        TEST_F(NeuralNetworkTest, TrainWithoutAllocationsPerSample){
+            auto makeDataset = [](std::size_t samples, std::size_t batchSize){
+                std::vector<std::vector<double>> inputs;
+                std::vector<std::vector<double>> outputs;
+                for(auto i=0u;i<samples;++i){
+                    inputs.push_back({(i % 2) * 1.0, (i % 3) * 0.5});
+                    outputs.push_back({(i % 2) * 1.0});
+                }
+                return Dataset(std::move(inputs), std::move(outputs), batchSize);
+            };
+            // one batch each, so only the samples change between the epochs.
+            DataLoader<Dataset> small(makeDataset(4u, 4u), false);
+            DataLoader<Dataset> large(makeDataset(16u, 16u), false);
+            // the same batch size, so only the number of batches changes between the epochs.
+            DataLoader<Dataset> oneBatch(makeDataset(4u, 4u), false);
+            DataLoader<Dataset> manyBatches(makeDataset(16u, 4u), false);
+            auto testFn = [](NeuralNetwork&, auto&){
+                return std::make_pair(0.0, 0.0);
+            };
+            auto check = [&](NeuralNetwork& nn, DataLoader<Dataset>& few, DataLoader<Dataset>& many){
+                EvoAI::Optimizer optim(0.01, 4, SGD(nn.getParameters(), 0.0), EvoAI::Scheduler(ConstantLR()));
+                auto epochAllocations = [&](DataLoader<Dataset>& dataset){
+                    auto before = numAllocations();
+                    nn.train(dataset, dataset, optim, 1, Loss::MeanSquaredError{}, testFn);
+                    return numAllocations() - before;
+                };
+                // the first epoch caches the connections.
+                epochAllocations(many);
+                EXPECT_EQ(epochAllocations(few), epochAllocations(many));
+            };
+            auto ff = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+            check(*ff, small, large);
+            // a compiled network with context neurons runs a sample at a time too.
+            auto elman = createElmanNeuralNetwork(2, 1, {4}, 1, 1.0);
+            elman->compile();
+            check(*elman, small, large);
+            // a compiled feed forward network trains in batches.
+            auto batched = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+            batched->compile();
+            check(*batched, oneBatch, manyBatches);
+        }
+        TEST_F(NeuralNetworkTest, TruncatedBPTTGradients){
+            auto nn = createElmanNeuralNetwork(2, 2, {4, 3}, 1, 1.0);
+            const std::vector<std::vector<double>> inputs{{0.5, -1.0}, {0.25, 0.75}, {-0.5, 0.1}, {1.0, 0.3}, {-0.2, -0.8}, {0.6, 0.4}};
+            const std::vector<double> targets{0.2, 0.9, 0.4, 0.1, 0.7, 0.3};
+            ASSERT_TRUE(nn->setTruncationWindow(8u));
+            EXPECT_EQ(ExecutionPlan::EvaluationMode::NEURON_MAJOR, nn->getExecutionPlan().getEvaluationMode());
+            // the sequence is shorter than the window so the gradients are the exact ones.
+            auto sequenceLoss = [&](bool backward){
+                nn->resetContext();
+                auto loss = 0.0;
+                for(auto t=0u;t<inputs.size();++t){
+                    auto out = nn->forward(inputs[t]);
+                    loss += 0.5 * (out[0] - targets[t]) * (out[0] - targets[t]);
+                    if(backward){
+                        EXPECT_TRUE(nn->backwardThroughTime({out[0] - targets[t]}));
+                    }
+                    nn->reset();
+                }
+                return loss;
+            };
+            sequenceLoss(true);
+            nn->propagateThroughTime();
+            auto numerical = [&](Connection* param){
+                const auto eps = 1e-6;
+                auto w = param->getWeight();
+                param->setWeight(w + eps);
+                nn->getExecutionPlan().updateWeights(*nn);
+                auto plus = sequenceLoss(false);
+                param->setWeight(w - eps);
+                nn->getExecutionPlan().updateWeights(*nn);
+                auto minus = sequenceLoss(false);
+                param->setWeight(w);
+                nn->getExecutionPlan().updateWeights(*nn);
+                return (plus - minus) / (2.0 * eps);
+            };
+            for(auto c:nn->getConnections()){
+                EXPECT_NEAR(numerical(c), c->getGradient(), 1e-6);
+            }
+            for(auto n:nn->getNeurons()){
+                if(n->getType() != Neuron::Type::INPUT){
+                    EXPECT_NEAR(numerical(n->getBiasPtr()), n->getBiasPtr()->getGradient(), 1e-6);
+                }
+            }
+        }
+        TEST_F(NeuralNetworkTest, TruncatedBPTTTrain){
+            NeuralNetwork unsupported;
+            unsupported.addLayer(NeuronLayer(1, Neuron::Type::INPUT, 1.0));
+            unsupported.addLayer(NeuronLayer(1, Neuron::Type::CONTEXT, 1.0));
+            unsupported.addLayer(NeuronLayer(1, Neuron::Type::OUTPUT, 1.0));
+            unsupported.addConnection(Connection(Link(0, 0), Link(1, 0), 1.0));
+            unsupported.addConnection(Connection(Link(1, 0), Link(2, 0), 1.0));
+            EXPECT_FALSE(unsupported.setTruncationWindow(4u));
+            EXPECT_EQ(0u, unsupported.getTruncationWindow());
+            // the output is the input of the previous step, only the context neurons remember it.
+            std::vector<std::vector<double>> inputs;
+            std::vector<std::vector<double>> outputs;
+            auto previous = 0.0;
+            for(auto i=0u;i<40u;++i){
+                auto value = (i * 7u) % 3u == 0u ? 1.0:0.0;
+                inputs.push_back({value});
+                outputs.push_back({previous});
+                previous = value;
+            }
+            auto batchSize = 8u;
+            DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), batchSize), false);
+            DataLoader<Dataset> testDataset(Dataset(std::move(inputs), std::move(outputs), batchSize), false);
+            auto testFn = [](NeuralNetwork&, auto&){
+                return std::make_pair(0.0, 0.0);
+            };
+            auto nn = createElmanNeuralNetwork(1, 1, {6}, 1, 1.0);
+            ASSERT_TRUE(nn->setTruncationWindow(4u));
+            EvoAI::Optimizer optim(0.5, batchSize, SGD(nn->getParameters(), 0.9), EvoAI::Scheduler(ConstantLR()));
+            auto data = nn->train(trainDataset, testDataset, optim, 60, Loss::MeanSquaredError{}, testFn);
+            EXPECT_EQ(4u, nn->getExecutionPlan().getTruncationWindow());
+            EXPECT_LT(data[0].back(), data[0].front());
+        }
+        TEST_F(NeuralNetworkTest, HogwildOneThread){
+            // with one thread Hogwild is plain SGD applied after each batch.
+            auto nn = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+            NeuralNetwork hogwild(nn->toJson().getObject());
+            nn->compile();
+            std::vector<std::vector<double>> inputs = {{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}};
+            std::vector<std::vector<double>> outputs = {{0.0}, {1.0}, {1.0}, {0.0}};
+            auto testFn = [](NeuralNetwork&, auto&){
+                return std::make_pair(0.0, 0.0);
+            };
+            DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+            DataLoader<Dataset> hogwildDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+            DataLoader<Dataset> testDataset(Dataset(std::move(inputs), std::move(outputs), 2), false);
+            EvoAI::Optimizer optim(0.5, 2, SGD(nn->getParameters(), 0.0), EvoAI::Scheduler(ConstantLR()));
+            auto data = nn->train(trainDataset, testDataset, optim, 5, Loss::MeanSquaredError{}, testFn);
+            auto hogwildData = hogwild.trainHogwild(hogwildDataset, testDataset, 0.5, 5, Loss::MeanSquaredError{}, testFn);
+            ASSERT_EQ(3u, hogwildData.size());
+            for(auto e=0u;e<5u;++e){
+                EXPECT_NEAR(data[0][e], hogwildData[0][e], 1e-9);
+            }
+            auto params = nn->getParameters();
+            auto hogwildParams = hogwild.getParameters();
+            ASSERT_EQ(params.size(), hogwildParams.size());
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_NEAR(params[i]->getWeight(), hogwildParams[i]->getWeight(), 1e-9);
+            }
+            EXPECT_NEAR(nn->forward({1.0, 0.0})[0], hogwild.forward({1.0, 0.0})[0], 1e-9);
+            auto elman = createElmanNeuralNetwork(2, 1, {4}, 1, 1.0);
+            EXPECT_TRUE(elman->trainHogwild(hogwildDataset, testDataset, 0.5, 1, Loss::MeanSquaredError{}, testFn).empty());
+        }
+        TEST_F(NeuralNetworkTest, HogwildXOR){
+            randomGen().setSeed(42);
+            auto nn = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+            UniformInit(*nn);
+            nn->setThreadPool(std::make_shared<ThreadPool>(3u));
+            std::vector<std::vector<double>> inputs = {{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}};
+            std::vector<std::vector<double>> outputs = {{0.0}, {1.0}, {1.0}, {0.0}};
+            DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 1));
+            DataLoader<Dataset> testDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 1), false);
+            auto testFn = [](NeuralNetwork&, auto&){
+                return std::make_pair(0.0, 0.0);
+            };
+            auto data = nn->trainHogwild(trainDataset, testDataset, 0.5, 3000, Loss::MeanSquaredError{}, testFn);
+            EXPECT_LT(data[0].back(), data[0].front());
+            for(auto i=0u;i<inputs.size();++i){
+                auto out = nn->forward(inputs[i]);
+                nn->reset();
+                EXPECT_NEAR(outputs[i][0], out[0], 0.25);
+            }
+        }
+        TEST_F(NeuralNetworkTest, AsyncTest){
+            std::vector<std::vector<double>> inputs = {{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}};
+            std::vector<std::vector<double>> outputs = {{0.0}, {1.0}, {1.0}, {0.0}};
+            auto testFn = [](NeuralNetwork& n, DataLoader<Dataset>& ds){
+                auto loss = 0.0;
+                for(auto i=0u;i<ds.size();++i){
+                    auto [in, out] = ds();
+                    loss += std::abs(out[0] - n.forward(in)[0]);
+                    n.reset();
+                }
+                return std::make_pair(loss, 0.0);
+            };
+            auto run = [&](NeuralNetwork& n){
+                DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+                DataLoader<Dataset> testDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 1), false);
+                EvoAI::Optimizer optim(0.5, 2, SGD(n.getParameters(), 0.0), EvoAI::Scheduler(ConstantLR()));
+                return n.train(trainDataset, testDataset, optim, 6, Loss::MeanSquaredError{}, testFn);
+            };
+            auto nn = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+            NeuralNetwork async(nn->toJson().getObject());
+            NeuralNetwork compiledAsync(nn->toJson().getObject());
+            compiledAsync.compile();
+            async.setAsyncTest(true);
+            compiledAsync.setAsyncTest(true);
+            EXPECT_TRUE(async.isAsyncTest());
+            auto data = run(*nn);
+            auto asyncData = run(async);
+            auto compiledData = run(compiledAsync);
+            ASSERT_EQ(data.size(), asyncData.size());
+            for(auto row=0u;row<data.size();++row){
+                ASSERT_EQ(data[row].size(), asyncData[row].size());
+                ASSERT_EQ(data[row].size(), compiledData[row].size());
+                for(auto e=0u;e<data[row].size();++e){
+                    EXPECT_NEAR(data[row][e], asyncData[row][e], 1e-9);
+                    EXPECT_NEAR(data[row][e], compiledData[row][e], 1e-9);
+                }
+            }
+            EXPECT_NEAR(nn->forward({1.0, 0.0})[0], async.forward({1.0, 0.0})[0], 1e-9);
+        }
+        TEST_F(NeuralNetworkTest, EpochCallback){
+            std::vector<std::vector<double>> inputs = {{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}};
+            std::vector<std::vector<double>> outputs = {{0.0}, {1.0}, {1.0}, {0.0}};
+            for(auto async:{false, true}){
+                DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+                DataLoader<Dataset> testDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+                // the tests run in the order of the epochs, so the results tell which epoch they belong to.
+                auto numTests = 0u;
+                auto testFn = [&numTests](NeuralNetwork&, auto&){
+                    auto test = static_cast<double>(numTests++);
+                    return std::make_pair(test, 2.0 * test);
+                };
+                auto nn = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+                nn->setAsyncTest(async);
+                std::vector<std::size_t> epochs;
+                nn->setEpochCallback([&](std::size_t epoch, double avgLoss, double testAvgLoss, double accuracy){
+                    epochs.emplace_back(epoch);
+                    EXPECT_GT(avgLoss, 0.0);
+                    EXPECT_EQ(static_cast<double>(epoch), testAvgLoss);
+                    EXPECT_EQ(2.0 * epoch, accuracy);
+                    return epoch < 1u;
+                });
+                EvoAI::Optimizer optim(0.1, 2, SGD(nn->getParameters(), 0.0), EvoAI::Scheduler(ConstantLR()));
+                auto data = nn->train(trainDataset, testDataset, optim, 10, Loss::MeanSquaredError{}, testFn);
+                // the asynchronous test of an epoch finishes while the next one trains.
+                auto trained = async ? 3u : 2u;
+                ASSERT_EQ(3u, data.size());
+                for(auto& row:data){
+                    EXPECT_EQ(trained, row.size());
+                }
+                EXPECT_EQ(trained, numTests);
+                for(auto e=0u;e<trained;++e){
+                    EXPECT_EQ(static_cast<double>(e), data[1][e]);
+                    EXPECT_EQ(2.0 * e, data[2][e]);
+                }
+                // no callback after the one that stopped.
+                ASSERT_EQ(2u, epochs.size());
+                EXPECT_EQ(0u, epochs[0]);
+                EXPECT_EQ(1u, epochs[1]);
+                EXPECT_EQ(trained, nn->getGlobalStep());
+            }
+        }
     }
 }
 
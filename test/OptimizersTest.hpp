@@ -2,6 +2,8 @@
 #define EVOAI_OPTIMIZERS_TEST_HPP
 
 #include <limits>
+#include <cmath>
+#include <algorithm>
 
 #include <gtest/gtest.h>
 #include <EvoAI.hpp>
@@ -63,6 +65,153 @@ namespace EvoAI{
             Optimizer<Adam, MultiStepLR> op2(optim.toJson().getObject(), nn->getParameters());
             EXPECT_EQ(op2.toJson(), optim.toJson());
         }
+        TEST(OptimizersTest, ParameterBuffer){
+            auto nn = createElmanNeuralNetwork(3, 1, {5}, 2, 1.0);
+            ParameterBuffer params(nn->getParameters());
+            ASSERT_EQ(nn->getParameters().size(), params.size());
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_EQ(params.getParameters()[i]->isRecurrent() ? 0u:1u, params.trainable()[i]);
+                params.getParameters()[i]->setGradient(i);
+            }
+            params.update([&](std::size_t begin, std::size_t end, double* weights, double* gradients){
+                for(auto i=0u;i<end - begin;++i){
+                    weights[i] = gradients[i] * 2.0;
+                }
+            });
+            for(auto i=0u;i<params.size();++i){
+                EXPECT_EQ(i * 2.0, params.getParameters()[i]->getWeight());
+            }
+            params.zeroGrad();
+            EXPECT_EQ(0.0, params.getParameters().back()->getGradient());
+        }
+        TEST(OptimizersTest, ParameterBufferBound){
+            auto nn = createFeedForwardNN(3, 2, {6, 4}, 2, 1.0);
+            nn->getConnections()[4]->setFrozen(true);
+            (*nn)[1][2].getBiasPtr()->setFrozen(true);
+            nn->compile();
+            auto& plan = nn->getExecutionPlan();
+            std::vector<double> weights;
+            for(auto c:nn->getConnections()){
+                weights.emplace_back(c->getWeight());
+            }
+            // the frozen parameters split the plan arrays in more than one segment.
+            ParameterBuffer params(nn->getParameters());
+            ASSERT_TRUE(plan.bindParameters(*nn, params));
+            EXPECT_TRUE(params.isBound());
+            params.update([&](std::size_t begin, std::size_t end, double* w, double* gradients){
+                for(auto i=0u;i<end - begin;++i){
+                    w[i] = static_cast<double>(begin + i);
+                    gradients[i] = 1.0;
+                }
+            });
+            params.zeroGrad();
+            auto& conns = nn->getConnections();
+            auto& parameters = params.getParameters();
+            auto p = 0u;
+            for(auto i=0u;i<conns.size();++i){
+                // the connections are not written while it's bound.
+                EXPECT_EQ(weights[i], conns[i]->getWeight());
+                EXPECT_EQ(conns[i]->isFrozen() ? weights[i]:static_cast<double>(p++), plan.getWeights()[i]);
+            }
+            plan.writeWeights(*nn);
+            params.unbind();
+            EXPECT_FALSE(params.isBound());
+            for(auto i=0u;i<parameters.size();++i){
+                EXPECT_EQ(static_cast<double>(i), parameters[i]->getWeight());
+                EXPECT_EQ(0.0, parameters[i]->getGradient());
+            }
+            EXPECT_EQ(weights[4], conns[4]->getWeight());
+            // the parameters need to be in the order of the plan and a float plan has no double arrays to bind.
+            auto reversed = nn->getParameters();
+            std::reverse(std::begin(reversed), std::end(reversed));
+            ParameterBuffer unordered(std::move(reversed));
+            EXPECT_FALSE(plan.bindParameters(*nn, unordered));
+            EXPECT_FALSE(unordered.isBound());
+            ExecutionPlanF planF(*nn);
+            EXPECT_FALSE(planF.bindParameters(*nn, params));
+        }
+        TEST(OptimizersTest, TrainBoundToExecutionPlan){
+            static_assert(meta::has_parameter_buffer_v<Optimizer<SGD, ConstantLR>> && meta::has_parameter_buffer_v<Optimizer<Adam, ConstantLR>>,
+                          "train binds SGD and Adam to the ExecutionPlan");
+            auto base = createFeedForwardNN(2, 1, {5}, 1, 1.0);
+            base->getConnections()[2]->setFrozen(true);
+            auto testFn = [](NeuralNetwork&, auto&){
+                return std::make_pair(0.0, 0.0);
+            };
+            // the optimizers update each parameter on its own, so reversing them doesn't change the updates
+            // but they can't be bound and the connections are updated instead.
+            auto run = [&](auto makeAlgo, bool reversed){
+                NeuralNetwork nn(base->toJson().getObject());
+                nn.compile();
+                std::vector<std::vector<double>> inputs = {{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}};
+                std::vector<std::vector<double>> outputs = {{0.0}, {1.0}, {1.0}, {0.0}};
+                DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+                DataLoader<Dataset> testDataset(Dataset(std::move(inputs), std::move(outputs), 2), false);
+                auto parameters = nn.getParameters();
+                if(reversed){
+                    std::reverse(std::begin(parameters), std::end(parameters));
+                }
+                EvoAI::Optimizer optim(0.1, 2, makeAlgo(std::move(parameters)), EvoAI::Scheduler(ConstantLR()));
+                nn.setEpochCallback([&nn](std::size_t, double, double, double){
+                    // the weights are back in the connections when the epoch ends.
+                    auto& conns = nn.getConnections();
+                    for(auto i=0u;i<conns.size();++i){
+                        EXPECT_EQ(nn.getExecutionPlan().getWeights()[i], conns[i]->getWeight());
+                    }
+                    return true;
+                });
+                nn.train(trainDataset, testDataset, optim, 3, Loss::MeanSquaredError{}, testFn);
+                EXPECT_FALSE(optim.getAlgo().getParameterBuffer().isBound());
+                std::vector<double> weights;
+                for(auto p:nn.getParameters()){
+                    weights.emplace_back(p->getWeight());
+                    EXPECT_EQ(0.0, p->getGradient());
+                }
+                return weights;
+            };
+            auto makeSGD = [](std::vector<Connection*>&& parameters){
+                return SGD(std::move(parameters), 0.9, true);
+            };
+            auto makeAdam = [](std::vector<Connection*>&& parameters){
+                return Adam(std::move(parameters));
+            };
+            EXPECT_EQ(run(makeSGD, false), run(makeSGD, true));
+            EXPECT_EQ(run(makeAdam, false), run(makeAdam, true));
+        }
+        TEST(OptimizersTest, OptimizersWithThreadPool){
+            auto nn = createElmanNeuralNetwork(3, 1, {40}, 2, 1.0);
+            auto pool = std::make_shared<ThreadPool>(3u);
+            auto run = [&](auto makeAlgo, bool threaded){
+                NeuralNetwork net(nn->toJson().getObject());
+                auto algo = makeAlgo(net);
+                if(threaded){
+                    algo.setThreadPool(pool, 64u);
+                }
+                for(auto s=0u;s<3u;++s){
+                    auto i = 0u;
+                    for(auto p:net.getParameters()){
+                        p->setGradient(std::sin(i++ + s));
+                    }
+                    algo(0.1, 2);
+                }
+                std::vector<double> weights;
+                for(auto p:net.getParameters()){
+                    weights.emplace_back(p->getWeight());
+                    if(p->isRecurrent()){
+                        EXPECT_EQ(1.0, p->getWeight());
+                    }
+                }
+                return weights;
+            };
+            auto makeSGD = [](NeuralNetwork& net){
+                return SGD(net.getParameters(), 0.9, true);
+            };
+            auto makeAdam = [](NeuralNetwork& net){
+                return Adam(net.getParameters());
+            };
+            EXPECT_EQ(run(makeSGD, false), run(makeSGD, true));
+            EXPECT_EQ(run(makeAdam, false), run(makeAdam, true));
+        }
     }
 }
 #endif // EVOAI_OPTIMIZERS_TEST_HPP
@@ -0,0 +1,93 @@
+#ifndef EVOAI_QUANTIZED_NETWORK_TEST_HPP
+#define EVOAI_QUANTIZED_NETWORK_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+
+namespace EvoAI{
+    namespace Test{
+        std::vector<std::vector<double>> calibrationInputs(std::size_t samples, std::size_t size) noexcept{
+            std::vector<std::vector<double>> data;
+            for(auto i=0u;i<samples;++i){
+                data.emplace_back(randomInputs(size));
+            }
+            return data;
+        }
+        TEST(QuantizedNetworkTest, FeedForward){
+            auto nn = createFeedForwardNN(4,2,{16,8},3,1.0);
+            auto qnn = quantize(*nn, calibrationInputs(64, 4));
+            EXPECT_EQ(4u, qnn.numInputs());
+            EXPECT_EQ(3u, qnn.numOutputs());
+            EXPECT_EQ(4u * 16u + 16u * 8u + 8u * 3u, qnn.numConnections());
+            std::vector<double> expected;
+            std::vector<double> outputs;
+            for(auto i=0;i<32;++i){
+                auto inputs = randomInputs(4);
+                auto out = nn->forward(inputs);
+                nn->reset();
+                expected.insert(std::end(expected), std::begin(out), std::end(out));
+                out = qnn.forward(inputs);
+                qnn.reset();
+                outputs.insert(std::end(outputs), std::begin(out), std::end(out));
+            }
+            auto report = compareOutputs(expected, outputs, 3);
+            EXPECT_LT(report.maxAbsError, 0.05);
+            EXPECT_GT(report.maxAbsError, 0.0);
+            EXPECT_TRUE(qnn.forward({1.0}).empty());
+        }
+        TEST(QuantizedNetworkTest, NeuronMajor){
+            auto nn = createFeedForwardNN(4,1,{16},2,1.0);
+            ExecutionPlan plan(*nn, PlanEvaluationMode::NEURON_MAJOR);
+            auto qnn = quantize(*nn, calibrationInputs(64, 4), PlanEvaluationMode::NEURON_MAJOR);
+            EXPECT_EQ(PlanEvaluationMode::NEURON_MAJOR, qnn.getEvaluationMode());
+            for(auto i=0;i<32;++i){
+                auto inputs = randomInputs(4);
+                auto expected = plan.forward(inputs);
+                plan.reset();
+                auto out = qnn.forward(inputs);
+                qnn.reset();
+                EXPECT_LT(compareOutputs(expected, out, 2).maxAbsError, 0.05);
+            }
+        }
+        TEST(QuantizedNetworkTest, Phenotype){
+            for(auto i=0;i<5;++i){
+                Genome g(3,2,true,false);
+                for(auto j=0;j<20;++j){
+                    g.mutate();
+                }
+                auto nn = Genome::makePhenotype(g);
+                makeDeterministic(nn);
+                // inputs outside of the calibration range are clipped, so calibrate with the inputs used.
+                auto data = calibrationInputs(32, 3);
+                auto qnn = quantize(nn, data);
+                for(auto& inputs:data){
+                    auto expected = nn.forward(inputs);
+                    nn.reset();
+                    auto out = qnn.forward(inputs);
+                    qnn.reset();
+                    EXPECT_LT(compareOutputs(expected, out, 2).maxAbsError, 0.05);
+                }
+            }
+        }
+        TEST(QuantizedNetworkTest, Footprint){
+            auto nn = createFeedForwardNN(16,2,{32,32},4,1.0);
+            auto qnn = quantize(*nn, calibrationInputs(16, 16));
+            auto connectionBytes = nn->getConnections().size() * sizeof(Connection);
+            EXPECT_LT(qnn.memoryUsage() * 4u, connectionBytes);
+        }
+        TEST(QuantizedNetworkTest, Context){
+            auto elman = createElmanNeuralNetwork(2,1,{4},2,1.0);
+            auto qnn = quantize(*elman, calibrationInputs(16, 2));
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = elman->forward(inputs);
+                elman->reset();
+                auto out = qnn.forward(inputs);
+                qnn.reset();
+                EXPECT_LT(compareOutputs(expected, out, 2).maxAbsError, 0.05);
+            }
+        }
+    }
+}
+
+#endif // EVOAI_QUANTIZED_NETWORK_TEST_HPP
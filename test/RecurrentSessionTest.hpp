@@ -0,0 +1,59 @@
+#ifndef EVOAI_RECURRENT_SESSION_TEST_HPP
+#define EVOAI_RECURRENT_SESSION_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <vector>
+
+namespace EvoAI{
+    namespace Test{
+        TEST(RecurrentSessionTest, SameAsNetworkCopies){
+            const std::size_t numSequences = 5u;
+            const std::size_t steps = 12u;
+            for(auto mode:{ExecutionPlan::EvaluationMode::EDGE_MAJOR, ExecutionPlan::EvaluationMode::NEURON_MAJOR}){
+                auto nn = createElmanNeuralNetwork(3, 2, {6, 4}, 2, 1.0);
+                nn->compile(mode);
+                std::vector<NeuralNetwork> copies(numSequences, *nn);
+                RecurrentSession session(*nn, numSequences);
+                EXPECT_EQ(numSequences, session.numSequences());
+                for(auto t=0u;t<steps;++t){
+                    auto inputs = randomInputs(numSequences * 3u);
+                    auto outputs = session.step(inputs);
+                    ASSERT_EQ(numSequences * 2u, outputs.size());
+                    for(auto s=0u;s<numSequences;++s){
+                        auto expected = copies[s].forward(std::vector<double>(std::begin(inputs) + s * 3u, std::begin(inputs) + (s + 1u) * 3u));
+                        copies[s].reset();
+                        EXPECT_TRUE(nearOutputs(expected, std::vector<double>(std::begin(outputs) + s * 2u, std::begin(outputs) + (s + 1u) * 2u)));
+                    }
+                }
+            }
+        }
+        TEST(RecurrentSessionTest, ResetSequence){
+            auto nn = createElmanNeuralNetwork(2, 1, {5}, 1, 1.0);
+            RecurrentSession session(*nn, 3u);
+            EXPECT_TRUE(nn->isCompiled());
+            std::vector<std::vector<double>> inputs;
+            std::vector<std::vector<double>> outputs;
+            for(auto t=0u;t<6u;++t){
+                inputs.emplace_back(randomInputs(6u));
+                outputs.emplace_back(session.step(inputs.back()));
+            }
+            // sequence 1 starts again and gives the same outputs, the others keep their memory.
+            session.resetSequence(1u);
+            auto changed = false;
+            for(auto t=0u;t<6u;++t){
+                auto out = session.step(inputs[t]);
+                EXPECT_TRUE(nearOutputs({outputs[t][1]}, {out[1]}));
+                changed = changed || out[0] != outputs[t][0];
+            }
+            EXPECT_TRUE(changed);
+            std::vector<double> out(3u);
+            EXPECT_FALSE(session.step(inputs[0].data(), 5u, out.data(), out.size()));
+            EXPECT_TRUE(session.step(std::vector<double>(4u)).empty());
+            session.resetContext();
+            EXPECT_TRUE(nearOutputs(outputs[0], session.step(inputs[0])));
+        }
+    }
+}
+
+#endif // EVOAI_RECURRENT_SESSION_TEST_HPP
@@ -5,6 +5,11 @@
 #include "NeuronTest.hpp"
 #include "NeuronLayerTest.hpp"
 #include "NeuralNetworkTest.hpp"
+#include "ExecutionPlanTest.hpp"
+#include "ModelFileTest.hpp"
+#include "QuantizedNetworkTest.hpp"
+#include "CodeGenerationTest.hpp"
+#include "StaticNetworkTest.hpp"
 #include "ConnectionTest.hpp"
 #include "GenomeTest.hpp"
 #include "NodeGeneTest.hpp"
@@ -18,6 +23,9 @@
 #include "SchedulersTest.hpp"
 #include "OptimizersTest.hpp"
 #include "EvoVectorTest.hpp"
+#include "ThreadPoolTest.hpp"
+#include "RecurrentSessionTest.hpp"
+#include "TrainingProfilerTest.hpp"
 
 #include <filesystem>
 
@@ -0,0 +1,102 @@
+#ifndef EVOAI_STATIC_NETWORK_TEST_HPP
+#define EVOAI_STATIC_NETWORK_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <stdexcept>
+
+namespace EvoAI{
+    namespace Test{
+        TEST(StaticNetworkTest, Dimensions){
+            using Brain = StaticNetwork<Neuron::ActivationType::SIGMOID, 8, 16, 12, 4>;
+            static_assert(Brain::numInputs == 8u);
+            static_assert(Brain::numOutputs == 4u);
+            static_assert(Brain::numLayers == 4u);
+            static_assert(Brain::numConnections() == 8u * 16u + 16u * 12u + 12u * 4u);
+            static_assert(Brain::numBiases() == 16u + 12u + 4u);
+            static_assert(std::is_trivially_copyable_v<Brain>);
+            Brain brain;
+            auto out = brain.forward(Brain::Inputs{});
+            for(auto v:out){
+                EXPECT_EQ(0.5, v);
+            }
+        }
+        TEST(StaticNetworkTest, SameAsNeuralNetwork){
+            auto nn = createFeedForwardNN(8,2,{16,12},4,1.0);
+            for(auto i=1u;i<nn->size();++i){
+                (*nn)[i].setActivationType(Neuron::ActivationType::TANH);
+            }
+            StaticNetwork<Neuron::ActivationType::TANH, 8, 16, 12, 4> brain(*nn);
+            StaticNetworkNM<Neuron::ActivationType::TANH, 8, 16, 12, 4> neuronMajorBrain(*nn);
+            auto neuronMajor = *nn;
+            neuronMajor.compile(ExecutionPlan::EvaluationMode::NEURON_MAJOR);
+            for(auto i=0;i<20;++i){
+                auto inputs = randomInputs(8);
+                auto expected = nn->forward(inputs);
+                nn->reset();
+                std::vector<double> outputs(4);
+                brain.forward(inputs.data(), outputs.data());
+                EXPECT_TRUE(sameOutputs(expected, outputs));
+                auto expectedNM = neuronMajor.forward(inputs);
+                neuronMajor.reset();
+                neuronMajorBrain.forward(inputs.data(), outputs.data());
+                EXPECT_TRUE(sameOutputs(expectedNM, outputs));
+            }
+        }
+        TEST(StaticNetworkTest, Softmax){
+            auto nn = createFeedForwardNN(3,0,{},5,1.0);
+            (*nn)[1].setActivationType(Neuron::ActivationType::SOFTMAX);
+            StaticNetwork<Neuron::ActivationType::SOFTMAX, 3, 5> brain(*nn);
+            auto inputs = randomInputs(3);
+            auto expected = nn->forward(inputs);
+            auto out = brain.forward({inputs[0], inputs[1], inputs[2]});
+            EXPECT_TRUE(sameOutputs(expected, std::vector<double>(std::begin(out), std::end(out))));
+        }
+        TEST(StaticNetworkTest, RoundTrip){
+            auto nn = createFeedForwardNN(4,1,{6},2,1.0);
+            for(auto i=1u;i<nn->size();++i){
+                (*nn)[i].setActivationType(Neuron::ActivationType::RELU);
+            }
+            using Brain = StaticNetwork<Neuron::ActivationType::RELU, 4, 6, 2>;
+            Brain brain(*nn);
+            auto exported = brain.toNeuralNetwork();
+            Brain fromJson(brain.toJson().getObject());
+            brain.writeToFile("testsData/staticNetwork.json");
+            Brain fromFile("testsData/staticNetwork.json");
+            EXPECT_EQ(brain.getWeights(), fromJson.getWeights());
+            EXPECT_EQ(brain.getBiases(), fromJson.getBiases());
+            EXPECT_EQ(brain.getWeights(), fromFile.getWeights());
+            EXPECT_EQ(brain.getBiases(), fromFile.getBiases());
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(4);
+                auto expected = nn->forward(inputs);
+                nn->reset();
+                EXPECT_TRUE(sameOutputs(expected, exported.forward(inputs)));
+                exported.reset();
+            }
+        }
+        TEST(StaticNetworkTest, InvalidTopology){
+            using Brain = StaticNetwork<Neuron::ActivationType::SIGMOID, 3, 4, 2>;
+            auto wrongSize = createFeedForwardNN(3,1,{5},2,1.0);
+            EXPECT_THROW(Brain{*wrongSize}, std::invalid_argument);
+            auto wrongLayers = createFeedForwardNN(3,2,{4,4},2,1.0);
+            EXPECT_THROW(Brain{*wrongLayers}, std::invalid_argument);
+            auto wrongActivation = createFeedForwardNN(3,1,{4},2,1.0);
+            for(auto i=1u;i<wrongActivation->size();++i){
+                (*wrongActivation)[i].setActivationType(Neuron::ActivationType::SIGMOID);
+            }
+            (*wrongActivation)[1][2].setActivationType(Neuron::ActivationType::TANH);
+            EXPECT_THROW(Brain{*wrongActivation}, std::invalid_argument);
+            auto recurrent = createFeedForwardNN(3,1,{4},2,1.0);
+            for(auto i=1u;i<recurrent->size();++i){
+                (*recurrent)[i].setActivationType(Neuron::ActivationType::SIGMOID);
+            }
+            recurrent->addConnection(Connection({2,0},{1,0},0.5));
+            EXPECT_THROW(Brain{*recurrent}, std::invalid_argument);
+            auto elman = createElmanNeuralNetwork(3,1,{4},2,1.0);
+            EXPECT_THROW(Brain{*elman}, std::invalid_argument);
+        }
+    }
+}
+
+#endif // EVOAI_STATIC_NETWORK_TEST_HPP
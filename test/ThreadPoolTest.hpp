@@ -0,0 +1,39 @@
+#ifndef EVOAI_THREAD_POOL_TEST_HPP
+#define EVOAI_THREAD_POOL_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <vector>
+#include <atomic>
+
+namespace EvoAI{
+    namespace Test{
+        TEST(ThreadPoolTest, Run){
+            ThreadPool pool(4);
+            EXPECT_EQ(4u, pool.size());
+            std::vector<int> done(1000, 0);
+            for(auto i=0;i<10;++i){
+                pool.run(done.size(), [&](std::size_t task){
+                    ++done[task];
+                });
+            }
+            for(auto d:done){
+                EXPECT_EQ(10, d);
+            }
+            // a task that runs the same pool runs the nested tasks on its thread.
+            std::atomic<std::size_t> nested = 0u;
+            pool.run(8, [&](std::size_t){
+                pool.run(8, [&](std::size_t){
+                    ++nested;
+                });
+            });
+            EXPECT_EQ(64u, nested.load());
+            ThreadPool single(1);
+            auto count = 0u;
+            single.run(5, [&](std::size_t){ ++count; });
+            EXPECT_EQ(5u, count);
+        }
+    }
+}
+
+#endif // EVOAI_THREAD_POOL_TEST_HPP
@@ -0,0 +1,102 @@
+#ifndef EVOAI_TRAINING_PROFILER_TEST_HPP
+#define EVOAI_TRAINING_PROFILER_TEST_HPP
+
+#include <gtest/gtest.h>
+#include <EvoAI.hpp>
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+namespace EvoAI{
+    namespace Test{
+        TEST(TrainingProfilerTest, Record){
+            TrainingProfiler profiler;
+            profiler.beginEpoch(7u);
+            profiler.record(TrainingProfiler::Phase::FORWARD, std::chrono::milliseconds(250), 2u);
+            profiler.record(TrainingProfiler::Phase::FORWARD, std::chrono::milliseconds(250));
+            profiler.record(TrainingProfiler::Phase::TEST, std::chrono::seconds(1));
+            auto& stats = profiler.endEpoch(10u);
+            EXPECT_EQ(7u, stats.epoch);
+            EXPECT_EQ(10u, stats.samples);
+            EXPECT_DOUBLE_EQ(0.5, stats.getSeconds(TrainingProfiler::Phase::FORWARD));
+            EXPECT_EQ(3u, stats.getCalls(TrainingProfiler::Phase::FORWARD));
+            EXPECT_DOUBLE_EQ(1.0, stats.getSeconds(TrainingProfiler::Phase::TEST));
+            EXPECT_EQ(0u, stats.getCalls(TrainingProfiler::Phase::BACKWARD));
+            ASSERT_EQ(1u, profiler.getEpochs().size());
+            profiler.beginEpoch(8u);
+            EXPECT_EQ(0u, profiler.endEpoch(0u).getCalls(TrainingProfiler::Phase::FORWARD));
+            EXPECT_EQ(2u, profiler.getEpochs().size());
+            profiler.clear();
+            EXPECT_TRUE(profiler.getEpochs().empty());
+        }
+        TEST(TrainingProfilerTest, Output){
+            std::ostringstream csv;
+            TrainingProfiler csvProfiler(csv, TrainingProfiler::Format::CSV);
+            csvProfiler.beginEpoch(3u);
+            csvProfiler.record(TrainingProfiler::Phase::LOSS, std::chrono::milliseconds(1));
+            csvProfiler.endEpoch(4u);
+            std::istringstream lines(csv.str());
+            std::string header, row;
+            std::getline(lines, header);
+            std::getline(lines, row);
+            EXPECT_EQ(TrainingProfiler::csvHeader(), header);
+            EXPECT_EQ(std::count(std::begin(header), std::end(header), ','), std::count(std::begin(row), std::end(row), ','));
+            EXPECT_EQ(0u, row.find("3,4,"));
+            std::ostringstream json;
+            TrainingProfiler jsonProfiler(json, TrainingProfiler::Format::JSON);
+            jsonProfiler.beginEpoch(3u);
+            jsonProfiler.endEpoch(4u);
+            auto line = json.str();
+            JsonBox::Value v;
+            v.loadFromString(line);
+            EXPECT_EQ("3", v["epoch"].getString());
+            EXPECT_EQ("4", v["samples"].getString());
+            EXPECT_EQ("0", v["phases"]["loss"]["calls"].getString());
+            EXPECT_EQ(1u, std::count(std::begin(line), std::end(line), '\n'));
+        }
+        TEST(TrainingProfilerTest, Train){
+            auto check = [](NeuralNetwork& nn, std::uint64_t forwardCalls, std::uint64_t backwardCalls){
+                std::vector<std::vector<double>> inputs = {{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}};
+                std::vector<std::vector<double>> outputs = {{0.0}, {1.0}, {1.0}, {0.0}};
+                DataLoader<Dataset> trainDataset(Dataset(std::vector<std::vector<double>>(inputs), std::vector<std::vector<double>>(outputs), 2), false);
+                DataLoader<Dataset> testDataset(Dataset(std::move(inputs), std::move(outputs), 2), false);
+                auto testFn = [](NeuralNetwork&, auto&){
+                    return std::make_pair(0.0, 0.0);
+                };
+                auto profiler = std::make_shared<TrainingProfiler>();
+                nn.setProfiler(profiler);
+                EvoAI::Optimizer optim(0.1, 2, SGD(nn.getParameters(), 0.0), EvoAI::Scheduler(ConstantLR()));
+                auto globalStep = nn.getGlobalStep();
+                auto data = nn.train(trainDataset, testDataset, optim, 3, Loss::MeanSquaredError{}, testFn);
+                ASSERT_EQ(4u + TrainingProfiler::NumPhases, data.size());
+                ASSERT_EQ(3u, profiler->getEpochs().size());
+                for(auto e=0u;e<3u;++e){
+                    auto& stats = profiler->getEpochs()[e];
+                    EXPECT_EQ(globalStep + e, stats.epoch);
+                    EXPECT_EQ(4u, stats.samples);
+                    EXPECT_EQ(4u, stats.getCalls(TrainingProfiler::Phase::DATA_LOADING));
+                    EXPECT_EQ(forwardCalls, stats.getCalls(TrainingProfiler::Phase::FORWARD));
+                    EXPECT_EQ(4u, stats.getCalls(TrainingProfiler::Phase::LOSS));
+                    EXPECT_EQ(backwardCalls, stats.getCalls(TrainingProfiler::Phase::BACKWARD));
+                    EXPECT_EQ(2u, stats.getCalls(TrainingProfiler::Phase::OPTIMIZER));
+                    EXPECT_EQ(1u, stats.getCalls(TrainingProfiler::Phase::TEST));
+                    EXPECT_DOUBLE_EQ(stats.samplesPerSecond(), data[3][e]);
+                    auto phases = 0.0;
+                    for(auto p=0u;p<TrainingProfiler::NumPhases;++p){
+                        EXPECT_DOUBLE_EQ(stats.phaseSeconds[p], data[4u + p][e]);
+                        phases += stats.phaseSeconds[p];
+                    }
+                    EXPECT_LE(phases, stats.seconds);
+                }
+                nn.setProfiler(nullptr);
+                EXPECT_EQ(3u, nn.train(trainDataset, testDataset, optim, 1, Loss::MeanSquaredError{}, testFn).size());
+            };
+            auto nn = createFeedForwardNN(2, 1, {4}, 1, 1.0);
+            check(*nn, 4u, 4u);
+            nn->compile();
+            check(*nn, 2u, 2u);
+        }
+    }
+}
+
+#endif // EVOAI_TRAINING_PROFILER_TEST_HPP
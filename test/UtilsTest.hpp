@@ -169,6 +169,127 @@ namespace EvoAI{
             v = {2.0,2.0,2.0};
             EXPECT_EQ(0u,Argmax(v));
         }
+        TEST(UtilsTest, OptimizePhenotype){
+            NeuralNetwork nn(2,1,{4},1,0.0);
+            nn[1].setActivationType(Neuron::ActivationType::SIGMOID);
+            nn[2].setActivationType(Neuron::ActivationType::SIGMOID);
+            nn[1][0].setBiasWeight(0.5);
+            nn[1][2].setBiasWeight(0.25);
+            nn[2][0].setBiasWeight(0.1);
+            nn.addConnection(Connection({0,0},{1,0},0.7));
+            nn.addConnection(Connection({0,0},{2,0},0.0));
+            nn.addConnection(Connection({0,1},{1,1},0.3));
+            nn.addConnection(Connection({0,1},{1,3},0.6));
+            // {1,1} cannot reach the output but the bias of {1,0} is added before its connection to the output.
+            nn.addConnection(Connection({1,0},{1,1},0.8));
+            nn.addConnection(Connection({1,0},{2,0},0.9));
+            // {1,2} has no inputs and {1,3} has a bias of 0.0 and two connections to the output.
+            nn.addConnection(Connection({1,2},{2,0},0.4));
+            nn.addConnection(Connection({1,3},{2,0},0.2));
+            nn.addConnection(Connection({1,3},{2,0},0.3));
+            auto exact = nn;
+            auto report = optimizePhenotype(exact, false);
+            EXPECT_EQ(0u, report.removedNeurons);
+            EXPECT_EQ(2u, report.removedConnections);
+            EXPECT_EQ(0u, report.mergedConnections);
+            EXPECT_EQ(0u, report.foldedConnections);
+            EXPECT_EQ(7u, exact.getConnections().size());
+            auto folded = nn;
+            report = optimizePhenotype(folded);
+            EXPECT_EQ(1u, report.removedNeurons);
+            EXPECT_EQ(4u, report.removedConnections);
+            EXPECT_EQ(1u, report.mergedConnections);
+            EXPECT_EQ(1u, report.foldedConnections);
+            EXPECT_EQ(3u, folded[1].size());
+            EXPECT_EQ(5u, folded.getConnections().size());
+            // {1,3} is {1,2} after removing the constant neuron.
+            ASSERT_TRUE(folded.hasConnection({1,2},{2,0}));
+            EXPECT_DOUBLE_EQ(0.5, folded.findConnection({1,2},{2,0})->getWeight());
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = nn.forward(inputs);
+                nn.reset();
+                EXPECT_TRUE(sameOutputs(expected, exact.forward(inputs)));
+                exact.reset();
+                EXPECT_TRUE(nearOutputs(expected, folded.forward(inputs)));
+                folded.reset();
+            }
+            // recurrent phenotypes keep the same outputs, the folded ones are only compared without recurrences
+            // because the rounding differences can grow through the context neurons.
+            for(auto canBeRecursive:{true, false}){
+                for(auto i=0;i<10;++i){
+                    Genome g(3,2,canBeRecursive,true);
+                    for(auto j=0;j<60;++j){
+                        g.mutate();
+                    }
+                    auto phenotype = Genome::makePhenotype(g);
+                    makeDeterministic(phenotype);
+                    auto optimized = phenotype;
+                    report = optimizePhenotype(optimized, !canBeRecursive);
+                    EXPECT_EQ(phenotype.getConnections().size() - report.removedConnections, optimized.getConnections().size());
+                    EXPECT_EQ(phenotype.getNeurons().size() - report.removedNeurons, optimized.getNeurons().size());
+                    optimized.compile();
+                    for(auto k=0;k<5;++k){
+                        auto inputs = randomInputs(3);
+                        auto expected = phenotype.forward(inputs);
+                        phenotype.reset();
+                        auto outputs = optimized.forward(inputs);
+                        optimized.reset();
+                        if(canBeRecursive){
+                            EXPECT_TRUE(sameOutputs(expected, outputs));
+                        }else{
+                            EXPECT_TRUE(nearOutputs(expected, outputs));
+                        }
+                    }
+                }
+            }
+        }
+        TEST(UtilsTest, ReorderForLocality){
+            NeuralNetwork nn(2,1,{5},1,0.5);
+            nn.addConnection(Connection({0,0},{2,0},0.3));
+            nn.addConnection(Connection({0,0},{1,0},0.7));
+            nn.addConnection(Connection({0,1},{2,0},-0.4));
+            nn.addConnection(Connection({1,0},{1,2},0.9));
+            nn.addConnection(Connection({1,0},{1,4},0.6));
+            nn.addConnection(Connection({1,4},{2,0},0.2));
+            auto reordered = nn;
+            auto report = reorderForLocality(reordered);
+            EXPECT_EQ(4u, report.movedNeurons);
+            EXPECT_LT(report.meanSpanAfter, report.meanSpanBefore);
+            EXPECT_TRUE(reordered.hasConnection({1,0},{1,1}));
+            EXPECT_TRUE(reordered.hasConnection({1,0},{1,2}));
+            EXPECT_TRUE(reordered.hasConnection({1,2},{2,0}));
+            EXPECT_EQ(Link(1,0), reordered[0][0].getConnections()[0].getDest());
+            for(auto i=0;i<10;++i){
+                auto inputs = randomInputs(2);
+                auto expected = nn.forward(inputs);
+                nn.reset();
+                EXPECT_TRUE(sameOutputs(expected, reordered.forward(inputs)));
+                reordered.reset();
+            }
+            for(auto canBeRecursive:{true, false}){
+                for(auto i=0;i<10;++i){
+                    Genome g(3,2,canBeRecursive,true);
+                    for(auto j=0;j<80;++j){
+                        g.mutate();
+                    }
+                    auto phenotype = Genome::makePhenotype(g);
+                    makeDeterministic(phenotype);
+                    auto optimized = phenotype;
+                    report = reorderForLocality(optimized);
+                    EXPECT_LE(report.meanSpanAfter, report.meanSpanBefore);
+                    EXPECT_EQ(phenotype.getConnections().size(), optimized.getConnections().size());
+                    optimized.compile();
+                    for(auto k=0;k<5;++k){
+                        auto inputs = randomInputs(3);
+                        auto expected = phenotype.forward(inputs);
+                        phenotype.reset();
+                        EXPECT_TRUE(sameOutputs(expected, optimized.forward(inputs)));
+                        optimized.reset();
+                    }
+                }
+            }
+        }
     }
 }
 #endif // EVOAI_UTILS_TEST_HPP
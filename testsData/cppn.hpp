@@ -0,0 +1,127 @@
+// Generated by EvoAI, 3 inputs, 3 outputs, 18 neurons and 24 connections.
+#ifndef EVOAI_GENERATED_CPPN_HPP
+#define EVOAI_GENERATED_CPPN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace cppn{
+    constexpr std::size_t numInputs = 3;
+    constexpr std::size_t numOutputs = 3;
+    constexpr std::size_t contextSize = 0;
+    namespace detail{
+        constexpr double weights[24] = {
+            0.71207004298708831, 0.30791123702868073, -0.71493986182904967, 0.78908828066208603, -0.06396936712968404, 0.26032451662732492, -0.51882709168645647, 0.62025572405928764,
+            -0.31790061345979748, 0.27881668589636632, 0.73617961709634305, -0.17106394526789592, -0.34227359679212932, -0.078414295058399031, -0.041275897694357577, 0.35969097301216557,
+            -0.43735679516012199, -0.62172092114756516, -0.77338417999096465, -0.27630486382110775, -0.3773963056979831, 0.39161833087160369, -0.25468373127306432, 0.0063288307104222286
+        };
+        constexpr double biases[18] = {
+            1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1
+        };
+        inline double abs([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::abs(v);
+        }
+        inline double cosine([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::cos(v);
+        }
+        inline double exponential([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::exp(v);
+        }
+        inline double inv([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return -v;
+        }
+        inline double log([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::log(v);
+        }
+        inline double square([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return (v * v);
+        }
+        inline double steepenedSigmoid([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return (1.0 / (1.0 + std::exp(-(4.9 * v))));
+        }
+        inline double tan([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::tan(v);
+        }
+    }
+    /**
+     * @brief same as NeuralNetwork::forward followed by NeuralNetwork::reset.
+     * @param inputs const double* numInputs values
+     * @param outputs double* numOutputs values
+     * @param context double* contextSize values zeroed before the first call, can be nullptr if contextSize is 0.
+     */
+    inline void forward(const double* inputs, double* outputs, [[maybe_unused]] double* context) noexcept{
+        double s0 = inputs[0];
+        double s1 = inputs[1];
+        double s2 = inputs[2];
+        double s4 = 0.0;
+        double s5 = 0.0;
+        double s6 = 0.0;
+        double s7 = 0.0;
+        double s9 = 0.0;
+        double s11 = 0.0;
+        double s13 = 0.0;
+        double s14 = 0.0;
+        double s15 = 0.0;
+        double s16 = 0.0;
+        double s17 = 0.0;
+        // neuron 0 input
+        s7 += s0 * detail::weights[0];
+        // neuron 1 input
+        s4 += s1 * detail::weights[1];
+        s11 += s1 * detail::weights[2];
+        // neuron 2 input
+        s13 += s2 * detail::weights[4];
+        s6 += s2 * detail::weights[5];
+        s7 += s2 * detail::weights[6];
+        s5 += s2 * detail::weights[7];
+        // neuron 4 hidden
+        s4 += detail::biases[4];
+        s17 += detail::square(s4, detail::biases[4]) * detail::weights[8];
+        s4 += detail::biases[4];
+        s11 += detail::square(s4, detail::biases[4]) * detail::weights[9];
+        s4 += detail::biases[4];
+        // neuron 5 hidden
+        s5 += detail::biases[5];
+        s5 += detail::biases[5];
+        s9 += detail::tan(s5, detail::biases[5]) * detail::weights[12];
+        // neuron 6 hidden
+        s6 += detail::biases[6];
+        s9 += detail::inv(s6, detail::biases[6]) * detail::weights[13];
+        // neuron 7 hidden
+        s7 += detail::biases[7];
+        s5 += detail::square(s7, detail::biases[7]) * detail::weights[14];
+        s7 += detail::biases[7];
+        s7 += detail::square(s7, detail::biases[7]) * detail::weights[15];
+        s7 += detail::biases[7];
+        s17 += detail::square(s7, detail::biases[7]) * detail::weights[16];
+        s7 += detail::biases[7];
+        s7 += detail::biases[7];
+        s17 += detail::square(s7, detail::biases[7]) * detail::weights[18];
+        // neuron 9 hidden
+        s9 += detail::biases[9];
+        s17 += detail::log(s9, detail::biases[9]) * detail::weights[19];
+        // neuron 11 hidden
+        s11 += detail::biases[11];
+        s17 += detail::exponential(s11, detail::biases[11]) * detail::weights[20];
+        s11 += detail::biases[11];
+        s17 += detail::exponential(s11, detail::biases[11]) * detail::weights[21];
+        // neuron 13 hidden
+        s13 += detail::biases[13];
+        s15 += detail::square(s13, detail::biases[13]) * detail::weights[22];
+        // neuron 14 hidden
+        s14 += detail::biases[14];
+        s16 += detail::abs(s14, detail::biases[14]) * detail::weights[23];
+        s15 += detail::biases[15];
+        outputs[0] = detail::tan(s15, detail::biases[15]);
+        s16 += detail::biases[16];
+        outputs[1] = detail::steepenedSigmoid(s16, detail::biases[16]);
+        s17 += detail::biases[17];
+        outputs[2] = detail::cosine(s17, detail::biases[17]);
+    }
+}
+
+#endif // EVOAI_GENERATED_CPPN_HPP
@@ -0,0 +1,185 @@
+// Generated by EvoAI, 2 inputs, 2 outputs, 16 neurons and 63 connections.
+#ifndef EVOAI_GENERATED_ELMAN_HPP
+#define EVOAI_GENERATED_ELMAN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace elman{
+    constexpr std::size_t numInputs = 2;
+    constexpr std::size_t numOutputs = 2;
+    constexpr std::size_t contextSize = 6;
+    namespace detail{
+        constexpr double weights[63] = {
+            -0.47939259707669746, -0.19343589998147348, -0.2273245325862896, -0.81126128470575343, 0.23480054874020073, 0.95921249201135916, 0.22368532414353037, -0.43216992207628935,
+            -0.49487864593870046, 0.039225464533422905, 0.17426461158499018, 0.73936890269501321, -0.71724286310971053, 0.46584638614645391, 0.74239254328686988, 1,
+            -2.2856315330997202e-10, 1.4684128750743519e-10, -1.2424642114722221e-10, 3.476216927209773e-10, -2.1758852828319505e-11, 1.4712894416960625e-10, 1.7824764699579071e-10, 4.8246537438089405e-10,
+            -1.2009889127218103e-10, 1, -7.3132109533099067e-11, -2.037503963697566e-10, -2.310534472340956e-10, -2.0795399539656528e-10, 3.5243675676508079e-10, -3.5026768179656172e-10,
+            2.4567562311186562e-10, -2.6648486605417671e-10, -3.7158337990247958e-10, 1, 3.9196380224100654e-10, -2.8705429215130718e-11, -1.1126222541323997e-11, -4.0569443931957705e-10,
+            -2.6812172810044327e-10, 3.9801130033644409e-10, 2.2625770122710454e-10, 5.3655388122267313e-10, 2.639029116388024e-10, 0.86216078937922647, -0.85255088853697791, -0.60371969243775858,
+            -0.76870223871439436, -0.81054554010826185, 0.066927450152478363, 0.14271592922158338, 0.035837929487498421, 0.68716759992265586, 1, 0.84466199751912274,
+            -0.93435027575698826, 1, 1.0571016745419666, -0.16148689253403281, 1, -0.67767235620140243, -0.11069613534601341
+        };
+        constexpr double biases[16] = {
+            -0.03092801428921188, 0.50746349390333578, 0.69407163118061055, 0.74807391830240788, -0.12996815077441204, -0.043687906145828403, -0.54973669103425216, -0.12626445056680935,
+            0.037716815060459652, -0.32095762334145717, -0.064013084747850613, -0.17930590349381914, -0.88916817121188729, -0.023962011677841843, -0.93279728646351334, 1.2711264887969889
+        };
+        inline double sigmoid([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return (1.0 / (1.0 + std::exp(-v)));
+        }
+    }
+    /**
+     * @brief same as NeuralNetwork::forward followed by NeuralNetwork::reset.
+     * @param inputs const double* numInputs values
+     * @param outputs double* numOutputs values
+     * @param context double* contextSize values zeroed before the first call, can be nullptr if contextSize is 0.
+     */
+    inline void forward(const double* inputs, double* outputs, [[maybe_unused]] double* context) noexcept{
+        double s0 = inputs[0];
+        double s1 = inputs[1];
+        double s2 = context[0];
+        double s3 = context[1];
+        double s4 = context[2];
+        double s5 = 0.0;
+        double s6 = 0.0;
+        double s7 = 0.0;
+        double s8 = context[3];
+        double s9 = context[4];
+        double s10 = context[5];
+        double s11 = 0.0;
+        double s12 = 0.0;
+        double s13 = 0.0;
+        double s14 = 0.0;
+        double s15 = 0.0;
+        // neuron 0 input
+        s5 += s0 * detail::weights[0];
+        s6 += s0 * detail::weights[1];
+        s7 += s0 * detail::weights[2];
+        // neuron 1 input
+        s5 += s1 * detail::weights[3];
+        s6 += s1 * detail::weights[4];
+        s7 += s1 * detail::weights[5];
+        // neuron 2 context
+        s5 += detail::sigmoid(s2, detail::biases[2]) * detail::weights[6];
+        s6 += detail::sigmoid(s2, detail::biases[2]) * detail::weights[7];
+        s7 += detail::sigmoid(s2, detail::biases[2]) * detail::weights[8];
+        // neuron 3 context
+        s5 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[9];
+        s6 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[10];
+        s7 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[11];
+        // neuron 4 context
+        s5 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[12];
+        s6 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[13];
+        s7 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[14];
+        // neuron 5 hidden
+        s5 += detail::biases[5];
+        s2 = s5;
+        s5 += detail::biases[5];
+        s11 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[16];
+        s5 += detail::biases[5];
+        s12 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[17];
+        s5 += detail::biases[5];
+        s13 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[18];
+        s5 += detail::biases[5];
+        s11 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[19];
+        s5 += detail::biases[5];
+        s12 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[20];
+        s5 += detail::biases[5];
+        s13 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[21];
+        s5 += detail::biases[5];
+        s11 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[22];
+        s5 += detail::biases[5];
+        s12 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[23];
+        s5 += detail::biases[5];
+        s13 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[24];
+        // neuron 6 hidden
+        s6 += detail::biases[6];
+        s3 = s6;
+        s6 += detail::biases[6];
+        s11 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[26];
+        s6 += detail::biases[6];
+        s12 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[27];
+        s6 += detail::biases[6];
+        s13 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[28];
+        s6 += detail::biases[6];
+        s11 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[29];
+        s6 += detail::biases[6];
+        s12 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[30];
+        s6 += detail::biases[6];
+        s13 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[31];
+        s6 += detail::biases[6];
+        s11 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[32];
+        s6 += detail::biases[6];
+        s12 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[33];
+        s6 += detail::biases[6];
+        s13 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[34];
+        // neuron 7 hidden
+        s7 += detail::biases[7];
+        s4 = s7;
+        s7 += detail::biases[7];
+        s11 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[36];
+        s7 += detail::biases[7];
+        s12 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[37];
+        s7 += detail::biases[7];
+        s13 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[38];
+        s7 += detail::biases[7];
+        s11 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[39];
+        s7 += detail::biases[7];
+        s12 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[40];
+        s7 += detail::biases[7];
+        s13 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[41];
+        s7 += detail::biases[7];
+        s11 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[42];
+        s7 += detail::biases[7];
+        s12 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[43];
+        s7 += detail::biases[7];
+        s13 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[44];
+        // neuron 8 context
+        s11 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[45];
+        s12 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[46];
+        s13 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[47];
+        // neuron 9 context
+        s11 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[48];
+        s12 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[49];
+        s13 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[50];
+        // neuron 10 context
+        s11 += detail::sigmoid(s10, detail::biases[10]) * detail::weights[51];
+        s12 += detail::sigmoid(s10, detail::biases[10]) * detail::weights[52];
+        s13 += detail::sigmoid(s10, detail::biases[10]) * detail::weights[53];
+        // neuron 11 hidden
+        s11 += detail::biases[11];
+        s8 = s11;
+        s11 += detail::biases[11];
+        s14 += detail::sigmoid(s11, detail::biases[11]) * detail::weights[55];
+        s11 += detail::biases[11];
+        s15 += detail::sigmoid(s11, detail::biases[11]) * detail::weights[56];
+        // neuron 12 hidden
+        s12 += detail::biases[12];
+        s9 = s12;
+        s12 += detail::biases[12];
+        s14 += detail::sigmoid(s12, detail::biases[12]) * detail::weights[58];
+        s12 += detail::biases[12];
+        s15 += detail::sigmoid(s12, detail::biases[12]) * detail::weights[59];
+        // neuron 13 hidden
+        s13 += detail::biases[13];
+        s10 = s13;
+        s13 += detail::biases[13];
+        s14 += detail::sigmoid(s13, detail::biases[13]) * detail::weights[61];
+        s13 += detail::biases[13];
+        s15 += detail::sigmoid(s13, detail::biases[13]) * detail::weights[62];
+        context[0] = s2;
+        context[1] = s3;
+        context[2] = s4;
+        context[3] = s8;
+        context[4] = s9;
+        context[5] = s10;
+        s14 += detail::biases[14];
+        outputs[0] = detail::sigmoid(s14, detail::biases[14]);
+        s15 += detail::biases[15];
+        outputs[1] = detail::sigmoid(s15, detail::biases[15]);
+    }
+}
+
+#endif // EVOAI_GENERATED_ELMAN_HPP
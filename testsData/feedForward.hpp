@@ -0,0 +1,142 @@
+// Generated by EvoAI, 3 inputs, 2 outputs, 14 neurons and 43 connections.
+#ifndef EVOAI_GENERATED_FEEDFORWARD_HPP
+#define EVOAI_GENERATED_FEEDFORWARD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace feedForward{
+    constexpr std::size_t numInputs = 3;
+    constexpr std::size_t numOutputs = 2;
+    constexpr std::size_t contextSize = 0;
+    namespace detail{
+        constexpr double weights[43] = {
+            0.7035837989237812, 0.23994516929665921, 0.45587826794868347, -0.53620366564604793, -0.37121345783604948, -0.43580713580511887, 0.4079177022722591, 0.15659279339083421,
+            0.098980186162096251, 0.064440372325082373, -0.59414154633177396, -0.43751518264338263, -0.50870365416281693, -0.20009502923588196, 0.07276975657369944, 0.1961834743504971,
+            -0.36347120148055967, -0.63857914317952069, 0.6957314092872513, 0.28890579909024217, 0.014013899684136688, 0.20901379755474814, 0.11672082971314002, -0.44034653643140476,
+            -0.093418006499093931, 0.39013882907446651, 0.28738797695325413, -0.28590889483619908, 0.76365095403429084, -0.70375389448447057, -0.45238452982159727, -0.16702077728787301,
+            -0.79015569641342642, 0.71151905255512737, 0.79000292910817782, -2.0554463614984978e-05, 1.821425818911966e-06, -6.1778225980870068e-06, 1.6259962941041664e-05, -3.9609219382107573e-06,
+            2.1980995657443736e-06, 4.5985649801242851e-06, -6.5865630891307878e-06
+        };
+        constexpr double biases[14] = {
+            -0.8183044790813796, 0.28608246822281158, -0.0096733174774547015, -0.41886919460983724, 0.38028751650080217, 0.48103406666469861, -0.26744307753165042, -0.76862458637312081,
+            0.92884447691381911, -0.60046039961724262, -0.00014715964703970741, -0.2696188116861169, 1.0451748974773634, 0.75062775912942348
+        };
+        inline double sigmoid([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return (1.0 / (1.0 + std::exp(-v)));
+        }
+    }
+    /**
+     * @brief same as NeuralNetwork::forward followed by NeuralNetwork::reset.
+     * @param inputs const double* numInputs values
+     * @param outputs double* numOutputs values
+     * @param context double* contextSize values zeroed before the first call, can be nullptr if contextSize is 0.
+     */
+    inline void forward(const double* inputs, double* outputs, [[maybe_unused]] double* context) noexcept{
+        double s0 = inputs[0];
+        double s1 = inputs[1];
+        double s2 = inputs[2];
+        double s3 = 0.0;
+        double s4 = 0.0;
+        double s5 = 0.0;
+        double s6 = 0.0;
+        double s7 = 0.0;
+        double s8 = 0.0;
+        double s9 = 0.0;
+        double s10 = 0.0;
+        double s11 = 0.0;
+        double s12 = 0.0;
+        double s13 = 0.0;
+        // neuron 0 input
+        s3 += s0 * detail::weights[0];
+        s4 += s0 * detail::weights[1];
+        s5 += s0 * detail::weights[2];
+        s6 += s0 * detail::weights[3];
+        s7 += s0 * detail::weights[4];
+        // neuron 1 input
+        s3 += s1 * detail::weights[5];
+        s4 += s1 * detail::weights[6];
+        s5 += s1 * detail::weights[7];
+        s6 += s1 * detail::weights[8];
+        s7 += s1 * detail::weights[9];
+        // neuron 2 input
+        s3 += s2 * detail::weights[10];
+        s4 += s2 * detail::weights[11];
+        s5 += s2 * detail::weights[12];
+        s6 += s2 * detail::weights[13];
+        s7 += s2 * detail::weights[14];
+        // neuron 3 hidden
+        s3 += detail::biases[3];
+        s8 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[15];
+        s3 += detail::biases[3];
+        s9 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[16];
+        s3 += detail::biases[3];
+        s10 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[17];
+        s3 += detail::biases[3];
+        s11 += detail::sigmoid(s3, detail::biases[3]) * detail::weights[18];
+        // neuron 4 hidden
+        s4 += detail::biases[4];
+        s8 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[19];
+        s4 += detail::biases[4];
+        s9 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[20];
+        s4 += detail::biases[4];
+        s10 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[21];
+        s4 += detail::biases[4];
+        s11 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[22];
+        // neuron 5 hidden
+        s5 += detail::biases[5];
+        s8 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[23];
+        s5 += detail::biases[5];
+        s9 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[24];
+        s5 += detail::biases[5];
+        s10 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[25];
+        s5 += detail::biases[5];
+        s11 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[26];
+        // neuron 6 hidden
+        s6 += detail::biases[6];
+        s8 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[27];
+        s6 += detail::biases[6];
+        s9 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[28];
+        s6 += detail::biases[6];
+        s10 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[29];
+        s6 += detail::biases[6];
+        s11 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[30];
+        // neuron 7 hidden
+        s7 += detail::biases[7];
+        s8 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[31];
+        s7 += detail::biases[7];
+        s9 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[32];
+        s7 += detail::biases[7];
+        s10 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[33];
+        s7 += detail::biases[7];
+        s11 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[34];
+        // neuron 8 hidden
+        s8 += detail::biases[8];
+        s12 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[35];
+        s8 += detail::biases[8];
+        s13 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[36];
+        // neuron 9 hidden
+        s9 += detail::biases[9];
+        s12 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[37];
+        s9 += detail::biases[9];
+        s13 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[38];
+        // neuron 10 hidden
+        s10 += detail::biases[10];
+        s12 += detail::sigmoid(s10, detail::biases[10]) * detail::weights[39];
+        s10 += detail::biases[10];
+        s13 += detail::sigmoid(s10, detail::biases[10]) * detail::weights[40];
+        // neuron 11 hidden
+        s11 += detail::biases[11];
+        s12 += detail::sigmoid(s11, detail::biases[11]) * detail::weights[41];
+        s11 += detail::biases[11];
+        s13 += detail::sigmoid(s11, detail::biases[11]) * detail::weights[42];
+        s12 += detail::biases[12];
+        outputs[0] = detail::sigmoid(s12, detail::biases[12]);
+        s13 += detail::biases[13];
+        outputs[1] = detail::sigmoid(s13, detail::biases[13]);
+    }
+}
+
+#endif // EVOAI_GENERATED_FEEDFORWARD_HPP
@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <array>
+#include "feedForward.hpp"
+#include "cppn.hpp"
+#include "softmax.hpp"
+#include "elman.hpp"
+#include "phenotype.hpp"
+int main(){
+    {
+        std::array<double, feedForward::contextSize> context{};
+        double inputs[feedForward::numInputs];
+        double outputs[feedForward::numOutputs];
+        for(auto i=0;i<12;++i){
+            for(auto& v:inputs){ if(std::scanf("%la", &v) != 1){ return 1; } }
+            feedForward::forward(inputs, outputs, context.data());
+            for(auto v:outputs){ std::printf("%a\n", v); }
+        }
+    }
+    {
+        std::array<double, cppn::contextSize> context{};
+        double inputs[cppn::numInputs];
+        double outputs[cppn::numOutputs];
+        for(auto i=0;i<12;++i){
+            for(auto& v:inputs){ if(std::scanf("%la", &v) != 1){ return 1; } }
+            cppn::forward(inputs, outputs, context.data());
+            for(auto v:outputs){ std::printf("%a\n", v); }
+        }
+    }
+    {
+        std::array<double, softmax::contextSize> context{};
+        double inputs[softmax::numInputs];
+        double outputs[softmax::numOutputs];
+        for(auto i=0;i<12;++i){
+            for(auto& v:inputs){ if(std::scanf("%la", &v) != 1){ return 1; } }
+            softmax::forward(inputs, outputs, context.data());
+            for(auto v:outputs){ std::printf("%a\n", v); }
+        }
+    }
+    {
+        std::array<double, elman::contextSize> context{};
+        double inputs[elman::numInputs];
+        double outputs[elman::numOutputs];
+        for(auto i=0;i<12;++i){
+            for(auto& v:inputs){ if(std::scanf("%la", &v) != 1){ return 1; } }
+            elman::forward(inputs, outputs, context.data());
+            for(auto v:outputs){ std::printf("%a\n", v); }
+        }
+    }
+    {
+        std::array<double, phenotype::contextSize> context{};
+        double inputs[phenotype::numInputs];
+        double outputs[phenotype::numOutputs];
+        for(auto i=0;i<12;++i){
+            for(auto& v:inputs){ if(std::scanf("%la", &v) != 1){ return 1; } }
+            phenotype::forward(inputs, outputs, context.data());
+            for(auto v:outputs){ std::printf("%a\n", v); }
+        }
+    }
+}
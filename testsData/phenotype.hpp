@@ -0,0 +1,98 @@
+// Generated by EvoAI, 3 inputs, 2 outputs, 11 neurons and 16 connections.
+#ifndef EVOAI_GENERATED_PHENOTYPE_HPP
+#define EVOAI_GENERATED_PHENOTYPE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace phenotype{
+    constexpr std::size_t numInputs = 3;
+    constexpr std::size_t numOutputs = 2;
+    constexpr std::size_t contextSize = 1;
+    namespace detail{
+        constexpr double weights[16] = {
+            -0.35100826930952223, 0.097447336556239786, -0.41780530807779048, 0.31814528793100388, -0.40751394619392639, 1, 0.036920087587162892, -0.40493990699109533,
+            1, 0.26953035962236682, 1, -0.38631775020704168, 1, -0.12907905458236632, -0.25710282741457458, 0.41201778519542381
+        };
+        constexpr double biases[11] = {
+            -0.30469101552748651, -1.9913028304889842, 1, 1, 1, 1, 1, 1,
+            1, 1, 1
+        };
+        inline double abs([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::abs(v);
+        }
+        inline double clamp([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::clamp(v, -1.0, 1.0);
+        }
+        inline double exponential([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::exp(v);
+        }
+        inline double gaussian([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            const double sqpi = std::sqrt(2.0 / 3.14159265358979323846);
+            double cdf = 0.5 * (1.0 + std::tanh(sqpi * (v + 0.044715 * std::pow(v, 3))));
+            return v * cdf;
+        }
+        inline double sigmoid([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return (1.0 / (1.0 + std::exp(-v)));
+        }
+        inline double sinusoid([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return std::sin(v);
+        }
+    }
+    /**
+     * @brief same as NeuralNetwork::forward followed by NeuralNetwork::reset.
+     * @param inputs const double* numInputs values
+     * @param outputs double* numOutputs values
+     * @param context double* contextSize values zeroed before the first call, can be nullptr if contextSize is 0.
+     */
+    inline void forward(const double* inputs, double* outputs, [[maybe_unused]] double* context) noexcept{
+        double s0 = inputs[0];
+        double s1 = inputs[1];
+        double s2 = inputs[2];
+        double s3 = 0.0;
+        double s4 = context[0];
+        double s5 = 0.0;
+        double s6 = 0.0;
+        double s8 = 0.0;
+        double s9 = 0.0;
+        double s10 = 0.0;
+        // neuron 0 context
+        s3 += detail::sigmoid(s0, detail::biases[0]) * detail::weights[0];
+        s9 += detail::sigmoid(s0, detail::biases[0]) * detail::weights[1];
+        s10 += detail::sigmoid(s0, detail::biases[0]) * detail::weights[2];
+        // neuron 1 input
+        s9 += s1 * detail::weights[3];
+        s9 += s1 * detail::weights[4];
+        // neuron 2 input
+        s4 += s2 * detail::weights[5];
+        s10 += s2 * detail::weights[6];
+        // neuron 3 hidden
+        s3 += detail::biases[3];
+        s10 += detail::exponential(s3, detail::biases[3]) * detail::weights[7];
+        // neuron 4 context
+        s6 += detail::abs(s4, detail::biases[4]) * detail::weights[8];
+        // neuron 5 hidden
+        s5 += detail::biases[5];
+        s4 = s5;
+        s5 += detail::biases[5];
+        s8 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[10];
+        // neuron 6 hidden
+        s6 += detail::biases[6];
+        s9 += detail::gaussian(s6, detail::biases[6]) * detail::weights[11];
+        // neuron 8 hidden
+        s8 += detail::biases[8];
+        // neuron 9 output
+        s0 = s9 + detail::biases[9];
+        // neuron 10 output
+        s4 = s10 + detail::biases[10];
+        context[0] = s4;
+        s9 += detail::biases[9];
+        outputs[0] = detail::sinusoid(s9, detail::biases[9]);
+        s10 += detail::biases[10];
+        outputs[1] = detail::clamp(s10, detail::biases[10]);
+    }
+}
+
+#endif // EVOAI_GENERATED_PHENOTYPE_HPP
@@ -0,0 +1,145 @@
+// Generated by EvoAI, 4 inputs, 3 outputs, 13 neurons and 42 connections.
+#ifndef EVOAI_GENERATED_SOFTMAX_HPP
+#define EVOAI_GENERATED_SOFTMAX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace softmax{
+    constexpr std::size_t numInputs = 4;
+    constexpr std::size_t numOutputs = 3;
+    constexpr std::size_t contextSize = 0;
+    namespace detail{
+        constexpr double weights[42] = {
+            0.73908398784207052, -0.46561054855535999, 0.45888532045331343, -0.37640668715029679, 0.73196307422542817, 0.60645743610458225, -0.47588539936681323, -0.11004280132796707,
+            0.32412959479001358, 0.44425377698195079, 0.38578171955916951, -0.57191632412642257, -0.73600669386785478, -0.12674171628044317, -0.050938118037943458, 0.021412023302577632,
+            0.67918986811392346, -0.43324964940990651, -0.3091180474442165, -0.72572392916327066, 0.24740945638158851, -0.049389056161489919, 0.71876210756055636, 0.66412779441358616,
+            0.13601623514554473, -0.84146575426832415, 0.44217152363919543, 1.3934591625603157, -0.600391969140179, 1.049526665662561, 0.49454367327379423, -0.82454005616706483,
+            0.18781286930806118, -0.81944972707372388, -0.72163115890322937, -0.72627423341980724, -1.371614169147451, -1.132364028158372, 1.0543507089874018, 0.90825172743666438,
+            0.55448415997081701, -0.74990036444588104
+        };
+        constexpr double biases[13] = {
+            0.048216573927661321, -0.096938020948982184, -0.64146259248778414, 0.065213510388968055, 0.66070149677558643, -0.22115526053174961, -0.337390094916655, 0.010137629590979857,
+            0.64889476769640742, 0.12570587360454022, 0.46736555730414819, -0.031902260988913467, -0.41618760087084428
+        };
+        inline double identity([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return v;
+        }
+        inline double sigmoid([[maybe_unused]] double v, [[maybe_unused]] double b) noexcept{
+            return (1.0 / (1.0 + std::exp(-v)));
+        }
+    }
+    /**
+     * @brief same as NeuralNetwork::forward followed by NeuralNetwork::reset.
+     * @param inputs const double* numInputs values
+     * @param outputs double* numOutputs values
+     * @param context double* contextSize values zeroed before the first call, can be nullptr if contextSize is 0.
+     */
+    inline void forward(const double* inputs, double* outputs, [[maybe_unused]] double* context) noexcept{
+        double s0 = inputs[0];
+        double s1 = inputs[1];
+        double s2 = inputs[2];
+        double s3 = inputs[3];
+        double s4 = 0.0;
+        double s5 = 0.0;
+        double s6 = 0.0;
+        double s7 = 0.0;
+        double s8 = 0.0;
+        double s9 = 0.0;
+        double s10 = 0.0;
+        double s11 = 0.0;
+        double s12 = 0.0;
+        // neuron 0 input
+        s4 += s0 * detail::weights[0];
+        s5 += s0 * detail::weights[1];
+        s6 += s0 * detail::weights[2];
+        s7 += s0 * detail::weights[3];
+        s8 += s0 * detail::weights[4];
+        s9 += s0 * detail::weights[5];
+        // neuron 1 input
+        s4 += s1 * detail::weights[6];
+        s5 += s1 * detail::weights[7];
+        s6 += s1 * detail::weights[8];
+        s7 += s1 * detail::weights[9];
+        s8 += s1 * detail::weights[10];
+        s9 += s1 * detail::weights[11];
+        // neuron 2 input
+        s4 += s2 * detail::weights[12];
+        s5 += s2 * detail::weights[13];
+        s6 += s2 * detail::weights[14];
+        s7 += s2 * detail::weights[15];
+        s8 += s2 * detail::weights[16];
+        s9 += s2 * detail::weights[17];
+        // neuron 3 input
+        s4 += s3 * detail::weights[18];
+        s5 += s3 * detail::weights[19];
+        s6 += s3 * detail::weights[20];
+        s7 += s3 * detail::weights[21];
+        s8 += s3 * detail::weights[22];
+        s9 += s3 * detail::weights[23];
+        // neuron 4 hidden
+        s4 += detail::biases[4];
+        s10 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[24];
+        s4 += detail::biases[4];
+        s11 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[25];
+        s4 += detail::biases[4];
+        s12 += detail::sigmoid(s4, detail::biases[4]) * detail::weights[26];
+        // neuron 5 hidden
+        s5 += detail::biases[5];
+        s10 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[27];
+        s5 += detail::biases[5];
+        s11 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[28];
+        s5 += detail::biases[5];
+        s12 += detail::sigmoid(s5, detail::biases[5]) * detail::weights[29];
+        // neuron 6 hidden
+        s6 += detail::biases[6];
+        s10 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[30];
+        s6 += detail::biases[6];
+        s11 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[31];
+        s6 += detail::biases[6];
+        s12 += detail::sigmoid(s6, detail::biases[6]) * detail::weights[32];
+        // neuron 7 hidden
+        s7 += detail::biases[7];
+        s10 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[33];
+        s7 += detail::biases[7];
+        s11 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[34];
+        s7 += detail::biases[7];
+        s12 += detail::sigmoid(s7, detail::biases[7]) * detail::weights[35];
+        // neuron 8 hidden
+        s8 += detail::biases[8];
+        s10 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[36];
+        s8 += detail::biases[8];
+        s11 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[37];
+        s8 += detail::biases[8];
+        s12 += detail::sigmoid(s8, detail::biases[8]) * detail::weights[38];
+        // neuron 9 hidden
+        s9 += detail::biases[9];
+        s10 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[39];
+        s9 += detail::biases[9];
+        s11 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[40];
+        s9 += detail::biases[9];
+        s12 += detail::sigmoid(s9, detail::biases[9]) * detail::weights[41];
+        s10 += detail::biases[10];
+        outputs[0] = detail::identity(s10, detail::biases[10]);
+        s11 += detail::biases[11];
+        outputs[1] = detail::identity(s11, detail::biases[11]);
+        s12 += detail::biases[12];
+        outputs[2] = detail::identity(s12, detail::biases[12]);
+        // same as Activations::softmax
+        auto max = *std::max_element(outputs, outputs + numOutputs);
+        for(std::size_t i=0u;i<numOutputs;++i){
+            outputs[i] = std::exp(outputs[i] - max);
+        }
+        auto totalSum = 0.0;
+        for(std::size_t i=0u;i<numOutputs;++i){
+            totalSum = totalSum + outputs[i];
+        }
+        for(std::size_t i=0u;i<numOutputs;++i){
+            outputs[i] = outputs[i] / totalSum;
+        }
+    }
+}
+
+#endif // EVOAI_GENERATED_SOFTMAX_HPP
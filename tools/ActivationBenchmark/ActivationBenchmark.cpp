@@ -0,0 +1,164 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <EvoAI/Activations.hpp>
+#include <EvoAI/NeuralNetwork.hpp>
+#include <EvoAI/Utils.hpp>
+
+void usage(){
+    std::cout << "ActivationBenchmark" << " [options]\n";
+    std::cout << "-n, --num-values <n>\t\t\tnumber of values for each activation.(default 1000000)\n";
+    std::cout << "-r, --range <r>\t\t\t\tthe values are in [-r, r].(default 10)\n";
+    std::cout << "-res, --resolution <width height>\tresolution of the CPPN image.(default 256 256)\n";
+    std::cout << "-h, --help\t\t\t\thelp menu (This)\n";
+}
+
+template<typename Fn>
+double nsPerValue(std::size_t numValues, Fn&& fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / numValues;
+}
+
+int main(int argc, const char* argv[]){
+    std::size_t numValues = 1000000;
+    double range = 10.0;
+    int resWidth = 256;
+    int resHeight = 256;
+    for(auto i=1;i<argc;++i){
+        std::string val = argv[i];
+        if((val == "-n" || val == "--num-values") && i+1 < argc){
+            numValues = std::stoul(std::string(argv[i+1]));
+        }
+        if((val == "-r" || val == "--range") && i+1 < argc){
+            range = std::stod(std::string(argv[i+1]));
+        }
+        if((val == "-res" || val == "--resolution") && i+2 < argc){
+            resWidth = std::stoi(std::string(argv[i+1]));
+            resHeight = std::stoi(std::string(argv[i+2]));
+        }
+        if(val == "--help" || val == "-h"){
+            usage();
+            return EXIT_SUCCESS;
+        }
+    }
+    std::vector<double> values(numValues);
+    for(auto& v:values){
+        v = EvoAI::randomGen().random(-range, range);
+    }
+    std::vector<double> exact(numValues);
+    std::vector<double> outputs(numValues);
+    std::vector<double> maxErrors = {1e-2, 1e-3, 1e-4, 1e-6};
+    std::vector<std::pair<std::string, EvoAI::Neuron::ActivationType>> activations = {
+        {"sigmoid", EvoAI::Neuron::ActivationType::SIGMOID},
+        {"tanh", EvoAI::Neuron::ActivationType::TANH},
+        {"gaussian", EvoAI::Neuron::ActivationType::GAUSSIAN},
+        {"sinusoid", EvoAI::Neuron::ActivationType::SINUSOID},
+        {"cosine", EvoAI::Neuron::ActivationType::COSINE}
+    };
+    std::cout << numValues << " values in [" << -range << ", " << range << "]\n";
+    std::cout << std::left << std::setw(10) << "activation" << std::setw(10) << "maxError"
+              << std::setw(14) << "scalar ns" << std::setw(14) << "array ns"
+              << std::setw(14) << "error" << "table bytes\n";
+    for(auto& [name, at]:activations){
+        auto exactScalar = nsPerValue(numValues, [&](){
+            for(auto i=0u;i<numValues;++i){
+                exact[i] = EvoAI::Activations::activate(at, values[i], 1.0);
+            }
+        });
+        auto exactArray = nsPerValue(numValues, [&](){
+            EvoAI::Activations::Array::activate(at, values.data(), outputs.data(), numValues, 1.0);
+        });
+        std::cout << std::setw(10) << name << std::setw(10) << "exact" << std::setw(14) << exactScalar
+                  << std::setw(14) << exactArray << std::setw(14) << 0.0 << 0 << "\n";
+        for(auto maxError:maxErrors){
+            EvoAI::Activations::LookupTable table(maxError);
+            auto tableScalar = nsPerValue(numValues, [&](){
+                for(auto i=0u;i<numValues;++i){
+                    outputs[i] = table.activate(at, values[i], 1.0);
+                }
+            });
+            auto tableArray = nsPerValue(numValues, [&](){
+                table.activate(at, values.data(), outputs.data(), numValues, 1.0);
+            });
+            auto error = 0.0;
+            for(auto i=0u;i<numValues;++i){
+                error = std::max(error, std::abs(outputs[i] - exact[i]));
+            }
+            std::cout << std::setw(10) << name << std::setw(10) << maxError << std::setw(14) << tableScalar
+                      << std::setw(14) << tableArray << std::setw(14) << error << table.memoryUsage() << "\n";
+        }
+    }
+    // a CPPN like the ones used by ImageGenerator, x, y and distance to the center as inputs,
+    // only with the approximated activations so the error comes from the tables.
+    auto cppn = EvoAI::createCPPN(3, 3, {16, 16, 16}, 3, 1.0);
+    auto next = 0u;
+    for(auto n:cppn->getNeurons()){
+        if(n->getType() != EvoAI::Neuron::Type::INPUT){
+            n->setActivationType(activations[next++ % activations.size()].second);
+        }
+    }
+    cppn->compile();
+    std::vector<std::vector<double>> inputs;
+    inputs.reserve(static_cast<std::size_t>(resWidth) * resHeight);
+    for(auto y=0;y<resHeight;++y){
+        for(auto x=0;x<resWidth;++x){
+            auto nx = 2.0 * x / resWidth - 1.0;
+            auto ny = 2.0 * y / resHeight - 1.0;
+            inputs.push_back({nx, ny, std::sqrt(nx * nx + ny * ny)});
+        }
+    }
+    auto numPixels = inputs.size();
+    std::vector<double> batchInputs;
+    batchInputs.reserve(numPixels * 3u);
+    for(auto& in:inputs){
+        batchInputs.insert(batchInputs.end(), in.begin(), in.end());
+    }
+    std::vector<double> batchOutputs;
+    auto& plan = cppn->getExecutionPlan();
+    std::vector<std::vector<double>> image(numPixels);
+    auto exactImage = nsPerValue(numPixels, [&](){
+        for(auto i=0u;i<numPixels;++i){
+            image[i] = cppn->forward(inputs[i]);
+            cppn->reset();
+        }
+    });
+    auto exactBatch = nsPerValue(numPixels, [&](){
+        plan.forwardBatch(batchInputs, numPixels, batchOutputs);
+    });
+    std::cout << "\nCPPN " << resWidth << "x" << resHeight << " image, ns per pixel\n";
+    std::cout << std::setw(10) << "maxError" << std::setw(14) << "ns" << std::setw(14) << "batch ns"
+              << std::setw(14) << "error" << "batch error\n";
+    std::cout << std::setw(10) << "exact" << std::setw(14) << exactImage << std::setw(14) << exactBatch
+              << std::setw(14) << 0.0 << 0.0 << "\n";
+    for(auto maxError:maxErrors){
+        cppn->setActivationTable(std::make_shared<EvoAI::Activations::LookupTable>(maxError));
+        auto error = 0.0;
+        auto tableImage = nsPerValue(numPixels, [&](){
+            for(auto i=0u;i<numPixels;++i){
+                auto out = cppn->forward(inputs[i]);
+                cppn->reset();
+                for(auto j=0u;j<out.size();++j){
+                    error = std::max(error, std::abs(out[j] - image[i][j]));
+                }
+            }
+        });
+        auto tableBatch = nsPerValue(numPixels, [&](){
+            plan.forwardBatch(batchInputs, numPixels, batchOutputs);
+        });
+        auto batchError = 0.0;
+        for(auto i=0u;i<numPixels;++i){
+            for(auto j=0u;j<image[i].size();++j){
+                batchError = std::max(batchError, std::abs(batchOutputs[i * image[i].size() + j] - image[i][j]));
+            }
+        }
+        std::cout << std::setw(10) << maxError << std::setw(14) << tableImage << std::setw(14) << tableBatch
+                  << std::setw(14) << error << batchError << "\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <EvoAI/Utils.hpp>
 #include <EvoAI/Genome.hpp>
+#include <EvoAI/Activations.hpp>
 #include "imageUtils.hpp"
 
 #include <EvoAI/HyperNeat.hpp>
@@ -28,6 +29,7 @@ void usage(){
     std::cout << "-res, --resolution <width height>\twill create a image of that resolution(ignored if --image is specified).\n";
     std::cout << "--image <filename>\t\t\tload a image and generate another.\n";
     std::cout << "-r, --repeat <n>\t\t\tIt will generate the image again.(use it for recurrent nn)\n";
+    std::cout << "-a, --approximate <maxError>\t\twill use lookup tables for the activations with that max error.\n";
     std::cout << "-h, --help\t\t\t\thelp menu (This)\n";
 }
 
@@ -61,6 +63,8 @@ int main(int argc, char **argv){
     bool optImage = false;
     std::string imageInput = "image.png";
     int repeat = 1;
+    bool optApproximate = false;
+    double maxError = 1e-4;
     if(argc < 3){
         usage();
         return EXIT_FAILURE;
@@ -140,6 +144,10 @@ int main(int argc, char **argv){
         if(val == "-r" || val == "--repeat"){
             repeat = std::stoi(std::string(argv[i+1]));
         }
+        if(val == "-a" || val == "--approximate"){
+            optApproximate = true;
+            maxError = std::stod(std::string(argv[i+1]));
+        }
         if(val == "--help" || val == "-h"){
             usage();
             return EXIT_SUCCESS;
@@ -243,6 +251,10 @@ int main(int argc, char **argv){
         }
         nn = std::make_unique<EvoAI::NeuralNetwork>(EvoAI::Genome::makePhenotype(*g));
     }
+    if(optApproximate){
+        std::cout << "Approximating activations with max error " << maxError << std::endl;
+        nn->setActivationTable(std::make_shared<EvoAI::Activations::LookupTable>(maxError));
+    }
     if(optSave){
         std::cout << "Saving Neural Network to " << saveFile << " ..." << std::endl;
         nn->writeToFile(saveFile);
@@ -1,5 +1,55 @@
 #include "imageUtils.hpp"
 
+namespace{
+    /**
+     * @brief fills imgOutput with the color nn gives to each pixel.
+     * @details when nn doesn't have context neurons the pixels don't depend on each other, nn is compiled
+     * and each row runs at once through forwardBatch, otherwise the pixels run one at a time through run.
+     * @param nn EvoAI::NeuralNetwork&
+     * @param imgOutput sf::Image& created with the size of the image.
+     * @param inputsOf void(int x, int y, double* inputs) writes the inputs of a pixel.
+     * @param colorOf sf::Color(const double* outputs) color of a pixel.
+     */
+    template<typename InputsFn, typename ColorFn>
+    void drawPixels(EvoAI::NeuralNetwork& nn, sf::Image& imgOutput, InputsFn&& inputsOf, ColorFn&& colorOf){
+        int width = imgOutput.getSize().x;
+        int height = imgOutput.getSize().y;
+        auto numInputs = nn[0].size();
+        auto numOutputs = nn[nn.size()-1].size();
+        if(!nn.isCompiled()){
+            nn.compile();
+        }
+        auto& plan = nn.getExecutionPlan();
+        if(!plan.hasContext()){
+            std::vector<double> inputs(width * numInputs);
+            std::vector<double> outputs;
+            for(auto y=0;y<height;++y){
+                for(auto x=0;x<width;++x){
+                    inputsOf(x, y, &inputs[x * numInputs]);
+                }
+                if(!plan.forwardBatch(inputs, width, outputs)){
+                    return;
+                }
+                for(auto x=0;x<width;++x){
+                    imgOutput.setPixel(x, y, colorOf(&outputs[x * numOutputs]));
+                }
+            }
+            return;
+        }
+        // the context neurons carry the state from pixel to pixel, they run in the same order as before.
+        std::vector<double> inputs(numInputs);
+        for(auto x=0;x<width;++x){
+            for(auto y=0;y<height;++y){
+                inputsOf(x, y, inputs.data());
+                nn.setInputs(inputs);
+                auto color = nn.run();
+                nn.reset();
+                imgOutput.setPixel(x, y, colorOf(color.data()));
+            }
+        }
+    }
+}
+
 namespace EvoAI{
     void generateImageFromCoordinates(const std::string& imageInput, NeuralNetwork* nn, const std::string& imageOutput){
         sf::Image imgInput;
@@ -19,19 +69,14 @@ namespace EvoAI{
         int height = imageInput.getSize().y;
         sf::Image imgOutput;
         imgOutput.create(width, height);
-        for(auto x=0;x<width;++x){
-            for(auto y=0;y<height;++y){
-                auto d = EvoAI::distanceCenter<int>(x,y,width,height);
-                std::vector<double> inputs;
-                inputs.emplace_back(x);
-                inputs.emplace_back(y);
-                inputs.emplace_back(d);
-                nn->setInputs(std::move(inputs));
-                auto color = nn->run();
-                nn->reset();
-                imgOutput.setPixel(x,y,sf::Color(color[0]*128+128,color[1]*128+128,color[2]*128+128));
-            }
-        }
+        drawPixels(*nn, imgOutput, [width, height](int x, int y, double* inputs){
+            auto d = EvoAI::distanceCenter<int>(x,y,width,height);
+            inputs[0] = x;
+            inputs[1] = y;
+            inputs[2] = d;
+        }, [](const double* out){
+            return sf::Color(out[0]*128+128,out[1]*128+128,out[2]*128+128);
+        });
         imgOutput.saveToFile(imageOutput);
     }
     void generateImageFromColor(const std::string& imageInput, NeuralNetwork* nn, const std::string& imageOutput){
@@ -52,19 +97,14 @@ namespace EvoAI{
         int height = imageInput.getSize().y;
         sf::Image imgOutput;
         imgOutput.create(width, height);
-        for(auto x=0;x<width;++x){
-            for(auto y=0;y<height;++y){
-                std::vector<double> inputs;
-                auto imgColor = imageInput.getPixel(x,y);
-                inputs.emplace_back(imgColor.r);
-                inputs.emplace_back(imgColor.g);
-                inputs.emplace_back(imgColor.b);
-                nn->setInputs(std::move(inputs));
-                auto color = nn->run();
-                nn->reset();
-                imgOutput.setPixel(x,y,sf::Color(color[0]*128+128,color[1]*128+128,color[2]*128+128));
-            }
-        }
+        drawPixels(*nn, imgOutput, [&imageInput](int x, int y, double* inputs){
+            auto imgColor = imageInput.getPixel(x,y);
+            inputs[0] = imgColor.r;
+            inputs[1] = imgColor.g;
+            inputs[2] = imgColor.b;
+        }, [](const double* out){
+            return sf::Color(out[0]*128+128,out[1]*128+128,out[2]*128+128);
+        });
         imgOutput.saveToFile(imageOutput);
     }
     void generateBWImageFromColor(const std::string& imageInput, NeuralNetwork* nn, const std::string& imageOutput){
@@ -85,19 +125,14 @@ namespace EvoAI{
         int height = imageInput.getSize().y;
         sf::Image imgOutput;
         imgOutput.create(width, height);
-        for(auto x=0;x<width;++x){
-            for(auto y=0;y<height;++y){
-                std::vector<double> inputs;
-                auto imgColor = imageInput.getPixel(x,y);
-                inputs.emplace_back(imgColor.r);
-                inputs.emplace_back(imgColor.g);
-                inputs.emplace_back(imgColor.b);
-                nn->setInputs(std::move(inputs));
-                auto color = nn->run();
-                nn->reset();
-                imgOutput.setPixel(x,y,sf::Color(color[0]*128+128,color[0]*128+128,color[0]*128+128));
-            }
-        }
+        drawPixels(*nn, imgOutput, [&imageInput](int x, int y, double* inputs){
+            auto imgColor = imageInput.getPixel(x,y);
+            inputs[0] = imgColor.r;
+            inputs[1] = imgColor.g;
+            inputs[2] = imgColor.b;
+        }, [](const double* out){
+            return sf::Color(out[0]*128+128,out[0]*128+128,out[0]*128+128);
+        });
         imgOutput.saveToFile(imageOutput);
     }
     void generateBWImageFromCoords(const std::string& imageInput, NeuralNetwork* nn, const std::string& imageOutput){
@@ -118,19 +153,14 @@ namespace EvoAI{
         int height = imageInput.getSize().y;
         sf::Image imgOutput;
         imgOutput.create(width, height);
-        for(auto x=0;x<width;++x){
-            for(auto y=0;y<height;++y){
-                auto d = EvoAI::distanceCenter<int>(x,y,width,height);
-                std::vector<double> inputs;
-                inputs.emplace_back(x);
-                inputs.emplace_back(y);
-                inputs.emplace_back(d);
-                nn->setInputs(std::move(inputs));
-                auto color = nn->run();
-                nn->reset();
-                imgOutput.setPixel(x,y,sf::Color(color[0]*128+128,color[0]*128+128,color[0]*128+128));
-            }
-        }
+        drawPixels(*nn, imgOutput, [width, height](int x, int y, double* inputs){
+            auto d = EvoAI::distanceCenter<int>(x,y,width,height);
+            inputs[0] = x;
+            inputs[1] = y;
+            inputs[2] = d;
+        }, [](const double* out){
+            return sf::Color(out[0]*128+128,out[0]*128+128,out[0]*128+128);
+        });
         imgOutput.saveToFile(imageOutput);
     }
     void generateBWImageFromColorAndCoordinates(const std::string& imageInput, NeuralNetwork* nn, const std::string& imageOutput){
@@ -151,23 +181,18 @@ namespace EvoAI{
         int height = imageInput.getSize().y;
         sf::Image imgOutput;
         imgOutput.create(width, height);
-        for(auto x=0;x<width;++x){
-            for(auto y=0;y<height;++y){
-                auto d = EvoAI::distanceCenter<int>(x,y,width,height);
-                std::vector<double> inputs;
-                auto imgColor = imageInput.getPixel(x,y);
-                inputs.emplace_back(imgColor.r);
-                inputs.emplace_back(imgColor.g);
-                inputs.emplace_back(imgColor.b);
-                inputs.emplace_back(x);
-                inputs.emplace_back(y);
-                inputs.emplace_back(d);
-                nn->setInputs(std::move(inputs));
-                auto color = nn->run();
-                nn->reset();
-                imgOutput.setPixel(x,y,sf::Color(color[0]*128+128,color[0]*128+128,color[0]*128+128));
-            }
-        }
+        drawPixels(*nn, imgOutput, [&imageInput, width, height](int x, int y, double* inputs){
+            auto d = EvoAI::distanceCenter<int>(x,y,width,height);
+            auto imgColor = imageInput.getPixel(x,y);
+            inputs[0] = imgColor.r;
+            inputs[1] = imgColor.g;
+            inputs[2] = imgColor.b;
+            inputs[3] = x;
+            inputs[4] = y;
+            inputs[5] = d;
+        }, [](const double* out){
+            return sf::Color(out[0]*128+128,out[0]*128+128,out[0]*128+128);
+        });
         imgOutput.saveToFile(imageOutput);
     }
     void generateImageFromColorAndCoordinates(const std::string& imageInput, NeuralNetwork* nn, const std::string& imageOutput){
@@ -188,23 +213,18 @@ namespace EvoAI{
         int height = imageInput.getSize().y;
         sf::Image imgOutput;
         imgOutput.create(width, height);
-        for(auto x=0;x<width;++x){
-            for(auto y=0;y<height;++y){
-                auto d = EvoAI::distanceCenter<int>(x,y,width,height);
-                std::vector<double> inputs;
-                auto imgColor = imageInput.getPixel(x,y);
-                inputs.emplace_back(imgColor.r);
-                inputs.emplace_back(imgColor.g);
-                inputs.emplace_back(imgColor.b);
-                inputs.emplace_back(x);
-                inputs.emplace_back(y);
-                inputs.emplace_back(d);
-                nn->setInputs(std::move(inputs));
-                auto color = nn->run();
-                nn->reset();
-                imgOutput.setPixel(x,y,sf::Color(color[0]*128+128,color[1]*128+128,color[2]*128+128));
-            }
-        }
+        drawPixels(*nn, imgOutput, [&imageInput, width, height](int x, int y, double* inputs){
+            auto d = EvoAI::distanceCenter<int>(x,y,width,height);
+            auto imgColor = imageInput.getPixel(x,y);
+            inputs[0] = imgColor.r;
+            inputs[1] = imgColor.g;
+            inputs[2] = imgColor.b;
+            inputs[3] = x;
+            inputs[4] = y;
+            inputs[5] = d;
+        }, [](const double* out){
+            return sf::Color(out[0]*128+128,out[1]*128+128,out[2]*128+128);
+        });
         imgOutput.saveToFile(imageOutput);
     }
 }
@@ -0,0 +1,240 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <list>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <EvoAI.hpp>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+void usage(){
+    std::cout << "LocalityBenchmark" << " [options]\n";
+    std::cout << "-n, --nodes <n>\t\t\tnodes added to the genome.(default 2000)\n";
+    std::cout << "-c, --cache <KiB>\t\tsize of the simulated cache.(default 32)\n";
+    std::cout << "-i, --iterations <n>\t\tforward passes measured.(default 2000)\n";
+    std::cout << "-h, --help\t\t\thelp menu (This)\n";
+}
+
+/**
+ * @brief set associative cache with 64 bytes lines and LRU replacement, counts the misses.
+ */
+class CacheModel{
+    public:
+        CacheModel(std::size_t sizeKiB, std::size_t ways)
+        : m_ways(ways)
+        , m_sets(std::max<std::size_t>(1u, sizeKiB * 1024u / (64u * ways)))
+        , m_lines(m_sets)
+        , m_misses(0u){}
+        void access(std::uintptr_t address) noexcept{
+            auto line = address / 64u;
+            auto& set = m_lines[line % m_sets];
+            for(auto it=std::begin(set);it!=std::end(set);++it){
+                if(*it == line){
+                    set.splice(std::begin(set), set, it);
+                    return;
+                }
+            }
+            ++m_misses;
+            set.push_front(line);
+            if(set.size() > m_ways){
+                set.pop_back();
+            }
+        }
+        std::size_t misses() const noexcept{ return m_misses; }
+        void resetMisses() noexcept{ m_misses = 0u; }
+    private:
+        std::size_t m_ways;
+        std::size_t m_sets;
+        std::vector<std::list<std::uintptr_t>> m_lines;
+        std::size_t m_misses;
+};
+
+/**
+ * @brief replays the memory accesses of ExecutionPlan::run and the backward sweep of the plan on the cache,
+ * each array is placed in its own region like the arrays of the plan.
+ */
+std::pair<std::size_t, std::size_t> simulateMisses(const EvoAI::ExecutionPlan& plan, std::size_t cacheKiB){
+    CacheModel cache(cacheKiB, 8u);
+    auto& rowPtr = plan.getRowPtr();
+    auto& dest = plan.getDestinations();
+    auto size = plan.numNeurons();
+    std::uintptr_t region = std::uintptr_t(1) << 32;
+    auto sums = region;
+    auto outputs = 2 * region;
+    auto biases = 3 * region;
+    auto weights = 4 * region;
+    auto destinations = 5 * region;
+    auto gradients = 6 * region;
+    auto weightGradients = 7 * region;
+    auto forward = [&](){
+        for(auto n=0u;n<size;++n){
+            cache.access(sums + n * sizeof(double));
+            cache.access(biases + n * sizeof(double));
+            cache.access(outputs + n * sizeof(double));
+            for(auto c=rowPtr[n];c<rowPtr[n + 1];++c){
+                cache.access(weights + c * sizeof(double));
+                cache.access(destinations + c * sizeof(std::uint32_t));
+                cache.access(sums + dest[c] * sizeof(double));
+            }
+        }
+    };
+    auto backward = [&](){
+        for(auto n=size;n>0u;--n){
+            for(auto c=rowPtr[n - 1];c<rowPtr[n];++c){
+                cache.access(destinations + c * sizeof(std::uint32_t));
+                cache.access(gradients + dest[c] * sizeof(double));
+                cache.access(weights + c * sizeof(double));
+                cache.access(outputs + (n - 1) * sizeof(double));
+                cache.access(weightGradients + c * sizeof(double));
+            }
+            cache.access(gradients + (n - 1) * sizeof(double));
+            cache.access(sums + (n - 1) * sizeof(double));
+        }
+    };
+    // warm up, then count a forward and a backward sweep.
+    forward();
+    backward();
+    cache.resetMisses();
+    forward();
+    auto forwardMisses = cache.misses();
+    cache.resetMisses();
+    backward();
+    return {forwardMisses, cache.misses()};
+}
+
+/**
+ * @brief counts the L1 data cache read misses of the process with perf_event_open, if the kernel gives access to them.
+ */
+class HardwareCounter{
+    public:
+        HardwareCounter()
+        : m_fd(-1){
+            #if defined(__linux__)
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.size = sizeof(attr);
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            #endif
+        }
+        ~HardwareCounter(){
+            #if defined(__linux__)
+                if(m_fd >= 0){
+                    close(m_fd);
+                }
+            #endif
+        }
+        bool isAvailable() const noexcept{ return m_fd >= 0; }
+        void start() noexcept{
+            #if defined(__linux__)
+                if(m_fd >= 0){
+                    ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            #endif
+        }
+        long long stop() noexcept{
+            long long count = 0;
+            #if defined(__linux__)
+                if(m_fd >= 0){
+                    ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+                    if(read(m_fd, &count, sizeof(count)) != sizeof(count)){
+                        count = 0;
+                    }
+                }
+            #endif
+            return count;
+        }
+    private:
+        int m_fd;
+};
+
+int main(int argc, const char* argv[]){
+    std::size_t numNodes = 2000;
+    std::size_t cacheKiB = 32;
+    std::size_t iterations = 2000;
+    for(auto i=1;i<argc;++i){
+        std::string val = argv[i];
+        if((val == "-n" || val == "--nodes") && i+1 < argc){
+            numNodes = std::stoul(std::string(argv[i+1]));
+        }
+        if((val == "-c" || val == "--cache") && i+1 < argc){
+            cacheKiB = std::stoul(std::string(argv[i+1]));
+        }
+        if((val == "-i" || val == "--iterations") && i+1 < argc){
+            iterations = std::stoul(std::string(argv[i+1]));
+        }
+        if(val == "--help" || val == "-h"){
+            usage();
+            return EXIT_SUCCESS;
+        }
+    }
+    // a genome that grew like in a long NEAT run, the hidden neurons of the phenotype are in the order they were added.
+    EvoAI::Genome g(8, 4, false, false);
+    for(auto i=0u;i<numNodes;++i){
+        g.mutateAddNode();
+        g.mutateAddConnection();
+        g.mutateAddConnection();
+    }
+    auto before = EvoAI::Genome::makePhenotype(g);
+    for(auto n:before.getNeurons()){
+        if(n->getActivationType() == EvoAI::Neuron::ActivationType::NOISY_RELU){
+            n->setActivationType(EvoAI::Neuron::ActivationType::RELU);
+        }
+    }
+    auto after = before;
+    auto report = EvoAI::reorderForLocality(after);
+    std::cout << before.getNeurons().size() << " neurons, " << before.getConnections().size() << " connections, "
+              << report.movedNeurons << " moved, simulated " << cacheKiB << " KiB 8-way cache\n";
+    std::vector<double> inputs(8);
+    for(auto& v:inputs){
+        v = EvoAI::randomGen().random(-1.0, 1.0);
+    }
+    std::cout << std::left << std::setw(10) << "order" << std::setw(12) << "mean span" << std::setw(18) << "forward misses"
+              << std::setw(18) << "backward misses" << std::setw(14) << "forward ns" << "L1D misses\n";
+    std::vector<double> reference;
+    HardwareCounter counter;
+    for(auto* nn:{&before, &after}){
+        nn->compile();
+        auto [forwardMisses, backwardMisses] = simulateMisses(nn->getExecutionPlan(), cacheKiB);
+        auto outputs = nn->forward(inputs);
+        nn->reset();
+        if(reference.empty()){
+            reference = outputs;
+        }else if(!std::equal(std::begin(outputs), std::end(outputs), std::begin(reference), [](double a, double b){ return a == b || (std::isnan(a) && std::isnan(b)); })){
+            std::cout << "the outputs changed after reordering!\n";
+        }
+        auto checksum = 0.0;
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        for(auto i=0u;i<iterations;++i){
+            checksum += nn->forward(inputs)[0];
+            nn->reset();
+        }
+        auto end = std::chrono::steady_clock::now();
+        auto hardwareMisses = counter.stop();
+        auto ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::cout << std::setw(10) << (nn == &before ? "genes":"locality")
+                  << std::setw(12) << (nn == &before ? report.meanSpanBefore:report.meanSpanAfter)
+                  << std::setw(18) << forwardMisses << std::setw(18) << backwardMisses << std::setw(14) << ns;
+        if(counter.isAvailable()){
+            std::cout << static_cast<double>(hardwareMisses) / iterations;
+        }else{
+            std::cout << "n/a";
+        }
+        std::cout << (checksum == 0.0 ? " ":"") << "\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <string>
+#include <EvoAI/ModelFile.hpp>
+
+void usage(){
+    std::cout << "ModelConverter" << " [options]\n";
+    std::cout << "-b, --to-binary <filename>\t\tconvert a neural network json file to a binary file.\n";
+    std::cout << "-j, --to-json <filename>\t\tconvert a binary file to a neural network json file.\n";
+    std::cout << "-o, --output <filename>\t\t\tfile that will output.(default nn.evoai or nn.json)\n";
+    std::cout << "-h, --help\t\t\t\thelp menu (This)\n";
+}
+
+int main(int argc, const char* argv[]){
+    bool optToBinary = false;
+    bool optToJson = false;
+    std::string fileInput;
+    std::string fileOutput;
+    if(argc < 3){
+        usage();
+        return EXIT_FAILURE;
+    }
+    for(auto i=1;i<argc;++i){
+        std::string val = argv[i];
+        if((val == "-b" || val == "--to-binary") && i+1 < argc){
+            optToBinary = true;
+            fileInput = std::string(argv[i+1]);
+        }
+        if((val == "-j" || val == "--to-json") && i+1 < argc){
+            optToJson = true;
+            fileInput = std::string(argv[i+1]);
+        }
+        if((val == "-o" || val == "--output") && i+1 < argc){
+            fileOutput = std::string(argv[i+1]);
+        }
+        if(val == "--help" || val == "-h"){
+            usage();
+            return EXIT_SUCCESS;
+        }
+    }
+    if(optToBinary){
+        fileOutput = fileOutput.empty() ? "nn.evoai" : fileOutput;
+        std::cout << "Converting " << fileInput << " to " << fileOutput << " ..." << std::endl;
+        if(!EvoAI::ModelFile::jsonToBinary(fileInput, fileOutput)){
+            std::cerr << "Could not write " << fileOutput << std::endl;
+            return EXIT_FAILURE;
+        }
+    }else if(optToJson){
+        fileOutput = fileOutput.empty() ? "nn.json" : fileOutput;
+        std::cout << "Converting " << fileInput << " to " << fileOutput << " ..." << std::endl;
+        if(!EvoAI::ModelFile::binaryToJson(fileInput, fileOutput)){
+            std::cerr << fileInput << " is not a valid binary file." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }else{
+        usage();
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
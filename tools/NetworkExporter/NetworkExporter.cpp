@@ -0,0 +1,66 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <EvoAI/NeuralNetwork.hpp>
+#include <EvoAI/Genome.hpp>
+
+void usage(){
+    std::cout << "NetworkExporter" << " [options]\n";
+    std::cout << "-n, --neuralnetwork <filename>\t\tload a neural network json file.\n";
+    std::cout << "-g, --genome <filename>\t\t\tload a genome json file and export its phenotype.\n";
+    std::cout << "-o, --output <filename>\t\t\tC++ header that will output.(default network.hpp)\n";
+    std::cout << "-N, --name <name>\t\t\tnamespace of the generated code.(default evoai)\n";
+    std::cout << "-h, --help\t\t\t\thelp menu (This)\n";
+}
+
+int main(int argc, const char* argv[]){
+    bool optNeuralFile = false;
+    std::string neuralFile = "nn.json";
+    bool optGenome = false;
+    std::string genomeFile = "g.json";
+    std::string fileOutput = "network.hpp";
+    std::string name = "evoai";
+    if(argc < 3){
+        usage();
+        return EXIT_FAILURE;
+    }
+    for(auto i=1;i<argc;++i){
+        std::string val = argv[i];
+        if((val == "-n" || val == "--neuralnetwork") && i+1 < argc){
+            optNeuralFile = true;
+            neuralFile = std::string(argv[i+1]);
+        }
+        if((val == "-g" || val == "--genome") && i+1 < argc){
+            optGenome = true;
+            genomeFile = std::string(argv[i+1]);
+        }
+        if((val == "-o" || val == "--output") && i+1 < argc){
+            fileOutput = std::string(argv[i+1]);
+        }
+        if((val == "-N" || val == "--name") && i+1 < argc){
+            name = std::string(argv[i+1]);
+        }
+        if(val == "--help" || val == "-h"){
+            usage();
+            return EXIT_SUCCESS;
+        }
+    }
+    std::unique_ptr<EvoAI::NeuralNetwork> nn = nullptr;
+    if(optNeuralFile){
+        std::cout << "Loading File " << neuralFile << std::endl;
+        nn = std::make_unique<EvoAI::NeuralNetwork>(neuralFile);
+    }else if(optGenome){
+        std::cout << "Loading genome " << genomeFile << std::endl;
+        EvoAI::Genome g(genomeFile);
+        nn = std::make_unique<EvoAI::NeuralNetwork>(EvoAI::Genome::makePhenotype(g));
+    }else{
+        usage();
+        return EXIT_FAILURE;
+    }
+    std::cout << "Exporting " << name << " to " << fileOutput << " ..." << std::endl;
+    if(!nn->exportCpp(fileOutput, name)){
+        std::cerr << "Could not export the network, is " << name << " a valid C++ identifier?" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}